@@ -47,6 +47,13 @@
 #   define QL_ENABLE_TRACING
 #endif
 
+/* Define this if hot paths should be instrumented with timers and
+   counters (whether data are actually collected will depend on
+   run-time settings.) */
+#ifndef QL_ENABLE_INSTRUMENTATION
+#   define QL_ENABLE_INSTRUMENTATION
+#endif
+
 /* Define this if extra safety checks should be performed. This can degrade
    performance. */
 #ifndef QL_EXTRA_SAFETY_CHECKS
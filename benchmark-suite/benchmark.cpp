@@ -0,0 +1,44 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "benchmark.hpp"
+#include <ql/errors.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    BenchmarkRegistry& BenchmarkRegistry::instance() {
+        static BenchmarkRegistry registry;
+        return registry;
+    }
+
+    void BenchmarkRegistry::add(BenchmarkCase benchmark) {
+        for (const auto& b : benchmarks_)
+            QL_REQUIRE(b.name != benchmark.name,
+                       "benchmark " << benchmark.name << " registered twice");
+        benchmarks_.push_back(std::move(benchmark));
+    }
+
+    RegisterBenchmark::RegisterBenchmark(std::string name,
+                                         Size defaultSize,
+                                         std::string unit,
+                                         std::function<BenchmarkBody(Size)> setUp) {
+        BenchmarkRegistry::instance().add(
+            {std::move(name), defaultSize, std::move(unit), std::move(setUp)});
+    }
+
+}
@@ -0,0 +1,73 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#ifndef quantlib_benchmark_suite_benchmark_hpp
+#define quantlib_benchmark_suite_benchmark_hpp
+
+#include <ql/types.hpp>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    /* A benchmark is registered with a name of the form
+       "<component>/<case>", a default size and a set-up function.
+
+       The set-up function receives the size of the problem (the
+       number of instruments, paths, time steps... as described by
+       the unit passed at registration) and builds everything that
+       should not be timed; it returns the body of the benchmark,
+       which is the timed part and is called repeatedly.
+
+       The body returns a value depending on the results of the
+       calculation.  This prevents the compiler from removing the
+       calculation, and the value returned by the first call is
+       reported as a checksum so that changes in the results are
+       detected together with changes in performance.
+    */
+
+    typedef std::function<Real()> BenchmarkBody;
+
+    struct BenchmarkCase {
+        std::string name;
+        Size defaultSize;
+        std::string unit;
+        std::function<BenchmarkBody(Size)> setUp;
+    };
+
+    class BenchmarkRegistry {
+      public:
+        static BenchmarkRegistry& instance();
+        void add(BenchmarkCase benchmark);
+        const std::vector<BenchmarkCase>& benchmarks() const { return benchmarks_; }
+      private:
+        BenchmarkRegistry() = default;
+        std::vector<BenchmarkCase> benchmarks_;
+    };
+
+    // registers a benchmark when a static instance is initialized
+    struct RegisterBenchmark {
+        RegisterBenchmark(std::string name,
+                          Size defaultSize,
+                          std::string unit,
+                          std::function<BenchmarkBody(Size)> setUp);
+    };
+
+}
+
+#endif
@@ -0,0 +1,86 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "benchmark.hpp"
+#include <ql/settings.hpp>
+#include <ql/time/calendars/jointcalendar.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/calendars/unitedkingdom.hpp>
+#include <ql/time/calendars/unitedstates.hpp>
+#include <ql/time/schedule.hpp>
+
+using namespace QuantLib;
+
+namespace {
+
+    RegisterBenchmark calendarAdvance(
+        "calendar/advance", 1000, "advances",
+        [](Size n) -> BenchmarkBody {
+            Calendar calendar = JointCalendar(TARGET(),
+                                              UnitedKingdom(UnitedKingdom::Exchange),
+                                              UnitedStates(UnitedStates::NYSE));
+            Date start = Settings::instance().evaluationDate();
+            return [=]() {
+                Real sum = 0.0;
+                for (Size i=0; i<n; ++i) {
+                    Date d = start + Integer(i % 3650);
+                    sum += calendar.advance(d, Integer(i % 30) + 1, Days).serialNumber();
+                    sum += calendar.advance(d, Integer(i % 12) + 1, Months,
+                                            ModifiedFollowing, true).serialNumber();
+                }
+                return sum;
+            };
+        });
+
+    RegisterBenchmark calendarBusinessDays(
+        "calendar/business_days_between", 100, "intervals",
+        [](Size n) -> BenchmarkBody {
+            Calendar calendar = TARGET();
+            Date start = Settings::instance().evaluationDate();
+            return [=]() {
+                Real sum = 0.0;
+                for (Size i=0; i<n; ++i) {
+                    Date d = start + Integer(i % 365);
+                    sum += calendar.businessDaysBetween(d, d + Integer(365 + i % 3650));
+                }
+                return sum;
+            };
+        });
+
+    RegisterBenchmark scheduleGeneration(
+        "schedule/generation", 200, "schedules",
+        [](Size n) -> BenchmarkBody {
+            Calendar calendar = TARGET();
+            Date start = Settings::instance().evaluationDate();
+            return [=]() {
+                Real sum = 0.0;
+                for (Size i=0; i<n; ++i) {
+                    Date effective = start + Integer(i % 365);
+                    Schedule schedule = MakeSchedule()
+                        .from(effective)
+                        .to(effective + Period(Integer(i % 30) + 1, Years))
+                        .withFrequency(Quarterly)
+                        .withCalendar(calendar)
+                        .withConvention(ModifiedFollowing)
+                        .backwards();
+                    sum += schedule.size() + schedule.endDate().serialNumber();
+                }
+                return sum;
+            };
+        });
+
+}
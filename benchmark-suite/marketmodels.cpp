@@ -0,0 +1,139 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "benchmark.hpp"
+#include <ql/models/marketmodels/browniangenerators/mtbrowniangenerator.hpp>
+#include <ql/models/marketmodels/correlations/expcorrelations.hpp>
+#include <ql/models/marketmodels/curvestate.hpp>
+#include <ql/models/marketmodels/evolutiondescription.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdrateeuler.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdrateipc.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdratepc.hpp>
+#include <ql/models/marketmodels/models/flatvol.hpp>
+#include <string>
+
+using namespace QuantLib;
+
+namespace {
+
+    // 10 years of semiannual forward rates driven by three factors
+    ext::shared_ptr<MarketModel> marketModel() {
+        Size rates = 20, factors = 3;
+        std::vector<Time> rateTimes(rates + 1);
+        for (Size i=0; i<rateTimes.size(); ++i)
+            rateTimes[i] = 0.5 * Real(i + 1);
+        EvolutionDescription evolution(rateTimes);
+
+        std::vector<Rate> forwards(rates), displacements(rates, 0.0);
+        std::vector<Volatility> volatilities(rates);
+        for (Size i=0; i<rates; ++i) {
+            forwards[i] = 0.03 + 0.0010 * Real(i);
+            volatilities[i] = 0.20 - 0.0025 * Real(i);
+        }
+        auto correlations = ext::make_shared<ExponentialForwardCorrelation>(
+            rateTimes, 0.5, 0.2);
+        return ext::make_shared<FlatVol>(volatilities, correlations, evolution,
+                                         factors, forwards, displacements);
+    }
+
+    // evolves n paths and sums the weighted values of the last rate
+    BenchmarkBody evolvePaths(Size n,
+                              const ext::shared_ptr<MarketModel>& model,
+                              const ext::shared_ptr<MarketModelEvolver>& evolver) {
+        Size steps = model->evolution().numberOfSteps();
+        Size rates = model->numberOfRates();
+        return [=]() {
+            Real sum = 0.0;
+            for (Size i=0; i<n; ++i) {
+                Real weight = evolver->startNewPath();
+                for (Size s=0; s<steps; ++s)
+                    weight *= evolver->advanceStep();
+                sum += weight * evolver->currentState().forwardRate(rates - 1);
+            }
+            return sum;
+        };
+    }
+
+    RegisterBenchmark lmmEulerEvolve(
+        "lmm/euler_evolve", 2000, "paths",
+        [](Size n) -> BenchmarkBody {
+            auto model = marketModel();
+            auto evolver = ext::make_shared<LogNormalFwdRateEuler>(
+                model, MTBrownianGeneratorFactory(42), terminalMeasure(model->evolution()));
+            return evolvePaths(n, model, evolver);
+        });
+
+    RegisterBenchmark lmmPredictorCorrectorEvolve(
+        "lmm/pc_evolve", 2000, "paths",
+        [](Size n) -> BenchmarkBody {
+            auto model = marketModel();
+            auto evolver = ext::make_shared<LogNormalFwdRatePc>(
+                model, MTBrownianGeneratorFactory(42), terminalMeasure(model->evolution()));
+            return evolvePaths(n, model, evolver);
+        });
+
+    // quarterly displaced forward rates with flat volatilities
+    ext::shared_ptr<MarketModel> quarterlyModel(Size rates, Size factors) {
+        std::vector<Time> rateTimes(rates + 1);
+        for (Size i=0; i<rateTimes.size(); ++i)
+            rateTimes[i] = 0.25 * Real(i + 1);
+        EvolutionDescription evolution(rateTimes);
+
+        std::vector<Rate> forwards(rates, 0.05);
+        std::vector<Volatility> volatilities(rates, 0.11);
+        std::vector<Spread> displacements(rates, 0.02);
+        auto correlations = ext::make_shared<ExponentialForwardCorrelation>(
+            rateTimes, 0.11, 0.2, 1.0);
+        return ext::make_shared<FlatVol>(volatilities, correlations, evolution,
+                                         factors, forwards, displacements);
+    }
+
+    /* The predictor-corrector evolvers on 20, 40 and 80 rates, driven
+       by three factors (which uses the reduced-factor drifts) and by
+       as many factors as rates; the names end with rates x factors. */
+    struct PredictorCorrectorBenchmarks {
+        PredictorCorrectorBenchmarks() {
+            for (Size rates : { 20, 40, 80 }) {
+                for (Size factors : { Size(3), rates }) {
+                    std::string size =
+                        std::to_string(rates) + "x" + std::to_string(factors);
+
+                    RegisterBenchmark(
+                        "lmm/pc_evolve_" + size, 1000, "paths",
+                        [=](Size n) -> BenchmarkBody {
+                            auto model = quarterlyModel(rates, factors);
+                            auto evolver = ext::make_shared<LogNormalFwdRatePc>(
+                                model, MTBrownianGeneratorFactory(42),
+                                moneyMarketMeasure(model->evolution()));
+                            return evolvePaths(n, model, evolver);
+                        });
+
+                    RegisterBenchmark(
+                        "lmm/ipc_evolve_" + size, 1000, "paths",
+                        [=](Size n) -> BenchmarkBody {
+                            auto model = quarterlyModel(rates, factors);
+                            auto evolver = ext::make_shared<LogNormalFwdRateIpc>(
+                                model, MTBrownianGeneratorFactory(42),
+                                terminalMeasure(model->evolution()));
+                            return evolvePaths(n, model, evolver);
+                        });
+                }
+            }
+        }
+    } predictorCorrectorBenchmarks;
+
+}
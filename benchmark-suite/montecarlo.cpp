@@ -0,0 +1,83 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "benchmark.hpp"
+#include <ql/math/randomnumbers/rngtraits.hpp>
+#include <ql/methods/montecarlo/pathgenerator.hpp>
+#include <ql/models/marketmodels/browniangenerators/sobolbrowniangenerator.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/settings.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/time/calendars/nullcalendar.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+
+using namespace QuantLib;
+
+namespace {
+
+    // 64 steps over one year with Brownian bridging
+    BenchmarkBody bridgedPaths(Size n) {
+        Date today = Settings::instance().evaluationDate();
+        DayCounter dc = Actual365Fixed();
+        auto process = ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+            Handle<YieldTermStructure>(ext::make_shared<FlatForward>(today, 0.02, dc)),
+            Handle<YieldTermStructure>(ext::make_shared<FlatForward>(today, 0.04, dc)),
+            Handle<BlackVolTermStructure>(
+                ext::make_shared<BlackConstantVol>(today, NullCalendar(), 0.25, dc)));
+        Size steps = 64;
+        auto generator = ext::make_shared<PathGenerator<PseudoRandom::rsg_type> >(
+            process, 1.0, steps, PseudoRandom::make_sequence_generator(steps, 42),
+            true);
+        return [=]() {
+            Real sum = 0.0;
+            for (Size i=0; i<n; ++i) {
+                const Path& path = generator->next().value;
+                sum += path.back();
+            }
+            return sum;
+        };
+    }
+
+    RegisterBenchmark pathGeneration(
+        "mc/bridged_paths", 20000, "paths", bridgedPaths);
+
+    // three factors over 40 steps, as in a market-model simulation
+    BenchmarkBody sobolBrownianPaths(Size n) {
+        Size factors = 3, steps = 40;
+        auto generator = ext::make_shared<SobolBrownianGenerator>(
+            factors, steps, SobolBrownianGenerator::Diagonal, 42,
+            SobolRsg::JoeKuoD7);
+        return [=]() {
+            std::vector<Real> variates(factors);
+            Real sum = 0.0;
+            for (Size i=0; i<n; ++i) {
+                Real weight = generator->nextPath();
+                for (Size s=0; s<steps; ++s)
+                    weight *= generator->nextStep(variates);
+                sum += weight * variates[0];
+            }
+            return sum;
+        };
+    }
+
+    RegisterBenchmark sobolBrownianGeneration(
+        "mc/sobol_brownian", 20000, "paths", sobolBrownianPaths);
+
+}
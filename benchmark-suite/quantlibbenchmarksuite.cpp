@@ -0,0 +1,354 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*
+ QuantLib Component Benchmark Suite
+
+ Times a set of hot paths of the library (curve bootstrapping, schedule
+ generation, option pricing engines...) one by one, as opposed to
+ quantlib-benchmark which measures the throughput of a set of unit
+ tests. For instance:
+
+ List the available benchmarks with their default sizes:
+ ./quantlib-benchmark-suite --list
+
+ Run the Heston benchmarks with twice the default sizes and save the
+ results in JSON format:
+ ./quantlib-benchmark-suite --filter=heston --scale=2 --json=results.json
+
+ The results of two runs (e.g., before and after a change) can be
+ compared with tools/compare_benchmarks.py, which reports the
+ benchmarks whose timings got worse beyond a given threshold.
+*/
+
+#include "benchmark.hpp"
+#include <ql/settings.hpp>
+#include <ql/time/date.hpp>
+#include <ql/version.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace QuantLib;
+
+namespace {
+
+    struct Options {
+        std::string filter = ".*";
+        Real scale = 1.0;
+        Size size = 0;
+        Size repetitions = 5;
+        Real minTime = 0.1;
+        std::string jsonFile;
+        bool list = false;
+    };
+
+    struct Result {
+        std::string name, unit;
+        Size size, iterations;
+        std::vector<Real> times;
+        Real checksum;
+        Real minimum, median, mean, stdDev;
+    };
+
+    volatile Real sink = 0.0;
+
+    Real elapsed(const BenchmarkBody& body, Size iterations) {
+        auto start = std::chrono::steady_clock::now();
+        Real sum = 0.0;
+        for (Size i=0; i<iterations; ++i)
+            sum += body();
+        auto end = std::chrono::steady_clock::now();
+        sink = sink + sum;
+        return std::chrono::duration<Real>(end - start).count();
+    }
+
+    Result run(const BenchmarkCase& benchmark, const Options& options) {
+        Result result;
+        result.name = benchmark.name;
+        result.unit = benchmark.unit;
+        result.size = options.size != 0 ? options.size :
+            std::max<Size>(1, Size(std::lround(benchmark.defaultSize * options.scale)));
+
+        BenchmarkBody body = benchmark.setUp(result.size);
+
+        // the first call also warms up caches and lazy objects
+        result.checksum = body();
+
+        // each repetition runs the body enough times to last minTime
+        Size iterations = 1;
+        for (;;) {
+            Real t = elapsed(body, iterations);
+            if (t >= options.minTime)
+                break;
+            Real factor = t > 0.0 ? 1.2 * options.minTime / t : 10.0;
+            iterations = std::max(iterations + 1,
+                                  Size(std::ceil(Real(iterations) * std::min(factor, 10.0))));
+        }
+        result.iterations = iterations;
+
+        for (Size i=0; i<options.repetitions; ++i)
+            result.times.push_back(elapsed(body, iterations) / Real(iterations));
+
+        std::vector<Real> sorted = result.times;
+        std::sort(sorted.begin(), sorted.end());
+        Size n = sorted.size();
+        result.minimum = sorted.front();
+        result.median = n % 2 == 1 ? sorted[n/2] : 0.5 * (sorted[n/2-1] + sorted[n/2]);
+        result.mean = 0.0;
+        for (Real t : sorted)
+            result.mean += t / Real(n);
+        Real variance = 0.0;
+        for (Real t : sorted)
+            variance += (t - result.mean) * (t - result.mean);
+        result.stdDev = n > 1 ? std::sqrt(variance / Real(n - 1)) : 0.0;
+        return result;
+    }
+
+    std::string formatTime(Real seconds) {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(2);
+        if (seconds >= 1.0)
+            out << seconds << " s ";
+        else if (seconds >= 1.0e-3)
+            out << seconds * 1.0e3 << " ms";
+        else if (seconds >= 1.0e-6)
+            out << seconds * 1.0e6 << " us";
+        else
+            out << seconds * 1.0e9 << " ns";
+        return out.str();
+    }
+
+    std::string jsonString(const std::string& s) {
+        std::ostringstream out;
+        out << '"';
+        for (char c : s) {
+            switch (c) {
+              case '"':  out << "\\\""; break;
+              case '\\': out << "\\\\"; break;
+              case '\n': out << "\\n"; break;
+              case '\t': out << "\\t"; break;
+              default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                    out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                        << int(c) << std::dec << std::setfill(' ');
+                else
+                    out << c;
+            }
+        }
+        out << '"';
+        return out.str();
+    }
+
+    std::string compiler() {
+        std::ostringstream out;
+        #if defined(__clang__)
+        out << "clang " << __clang_version__;
+        #elif defined(__GNUC__)
+        out << "gcc " << __VERSION__;
+        #elif defined(_MSC_VER)
+        out << "msvc " << _MSC_VER;
+        #else
+        out << "unknown";
+        #endif
+        return out.str();
+    }
+
+    void writeJson(std::ostream& out, const std::vector<Result>& results, const Options& options) {
+        std::time_t now = std::time(nullptr);
+        char date[32];
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+        out << std::setprecision(12);
+        out << "{\n"
+            << "  \"context\": {\n"
+            << "    \"quantlib_version\": " << jsonString(QL_VERSION) << ",\n"
+            << "    \"compiler\": " << jsonString(compiler()) << ",\n"
+            #ifdef NDEBUG
+            << "    \"build_type\": \"release\",\n"
+            #else
+            << "    \"build_type\": \"debug\",\n"
+            #endif
+            << "    \"date\": " << jsonString(date) << ",\n"
+            << "    \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n"
+            << "    \"scale\": " << options.scale << ",\n"
+            << "    \"repetitions\": " << options.repetitions << ",\n"
+            << "    \"min_time\": " << options.minTime << "\n"
+            << "  },\n"
+            << "  \"benchmarks\": [";
+        for (Size i=0; i<results.size(); ++i) {
+            const Result& r = results[i];
+            out << (i == 0 ? "\n" : ",\n")
+                << "    {\n"
+                << "      \"name\": " << jsonString(r.name) << ",\n"
+                << "      \"size\": " << r.size << ",\n"
+                << "      \"unit\": " << jsonString(r.unit) << ",\n"
+                << "      \"iterations\": " << r.iterations << ",\n"
+                << "      \"times\": [";
+            for (Size j=0; j<r.times.size(); ++j)
+                out << (j == 0 ? "" : ", ") << r.times[j];
+            out << "],\n"
+                << "      \"min\": " << r.minimum << ",\n"
+                << "      \"median\": " << r.median << ",\n"
+                << "      \"mean\": " << r.mean << ",\n"
+                << "      \"stddev\": " << r.stdDev << ",\n"
+                << "      \"items_per_second\": " << Real(r.size) / r.median << ",\n"
+                << "      \"checksum\": " << r.checksum << "\n"
+                << "    }";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    void printUsage() {
+        std::cout
+            << "Usage: quantlib-benchmark-suite [options]\n\n"
+            << "--list              \t list the benchmarks and their default sizes\n"
+            << "--filter=<regex>    \t run the benchmarks whose name matches the expression\n"
+            << "--scale=<factor>    \t multiply the default sizes by the given factor\n"
+            << "--size=<n>          \t use the given size for all the benchmarks\n"
+            << "--repetitions=<n>   \t number of timed repetitions (default 5)\n"
+            << "--min-time=<seconds>\t minimum duration of a repetition (default 0.1)\n"
+            << "--json=<file>       \t write the results in JSON format\n"
+            << "--help              \t print this message\n";
+    }
+
+    bool parse(int argc, char* argv[], Options& options) {
+        for (int i=1; i<argc; ++i) {
+            std::string arg = argv[i];
+            std::string key = arg.substr(0, arg.find('='));
+            std::string value = arg.find('=') != std::string::npos ?
+                arg.substr(arg.find('=') + 1) : std::string();
+            try {
+                if (key == "--list")
+                    options.list = true;
+                else if (key == "--filter")
+                    options.filter = value;
+                else if (key == "--scale")
+                    options.scale = std::stod(value);
+                else if (key == "--size")
+                    options.size = std::stoul(value);
+                else if (key == "--repetitions")
+                    options.repetitions = std::max<Size>(1, std::stoul(value));
+                else if (key == "--min-time")
+                    options.minTime = std::stod(value);
+                else if (key == "--json")
+                    options.jsonFile = value;
+                else if (key == "--help" || key == "-h") {
+                    printUsage();
+                    return false;
+                } else {
+                    std::cerr << "unknown option " << arg << "\n\n";
+                    printUsage();
+                    return false;
+                }
+            } catch (std::exception&) {
+                std::cerr << "invalid value for option " << arg << "\n\n";
+                printUsage();
+                return false;
+            }
+        }
+        if (options.scale <= 0.0 || options.minTime < 0.0) {
+            std::cerr << "scale and minimum time must be positive\n";
+            return false;
+        }
+        return true;
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+
+    Options options;
+    if (!parse(argc, argv, options))
+        return 1;
+
+    std::vector<BenchmarkCase> benchmarks = BenchmarkRegistry::instance().benchmarks();
+    std::sort(benchmarks.begin(), benchmarks.end(),
+              [](const BenchmarkCase& a, const BenchmarkCase& b) { return a.name < b.name; });
+
+    std::regex filter;
+    try {
+        filter = std::regex(options.filter, std::regex::icase);
+    } catch (std::regex_error&) {
+        std::cerr << "invalid filter " << options.filter << "\n";
+        return 1;
+    }
+
+    std::vector<BenchmarkCase> selected;
+    for (const auto& b : benchmarks) {
+        if (std::regex_search(b.name, filter))
+            selected.push_back(b);
+    }
+
+    if (options.list) {
+        for (const auto& b : selected)
+            std::cout << std::left << std::setw(48) << b.name
+                      << b.defaultSize << " " << b.unit << "\n";
+        return 0;
+    }
+
+    // fixed evaluation date for reproducible results
+    Settings::instance().evaluationDate() = Date(15, January, 2024);
+
+    std::cout << "QuantLib " << QL_VERSION << ", " << compiler() << "\n\n"
+              << std::left << std::setw(48) << "benchmark"
+              << std::right << std::setw(10) << "size"
+              << std::setw(12) << "median"
+              << std::setw(10) << "spread"
+              << std::setw(16) << "items/s" << "\n";
+
+    std::vector<Result> results;
+    bool failed = false;
+    for (const auto& b : selected) {
+        try {
+            Result r = run(b, options);
+            std::cout << std::left << std::setw(48) << r.name
+                      << std::right << std::setw(10) << r.size
+                      << std::setw(12) << formatTime(r.median)
+                      << std::setw(9) << std::fixed << std::setprecision(1)
+                      << 100.0 * r.stdDev / r.median << "%"
+                      << std::setw(16) << std::scientific << std::setprecision(3)
+                      << Real(r.size) / r.median
+                      << std::defaultfloat << std::endl;
+            results.push_back(r);
+        } catch (std::exception& e) {
+            std::cout << std::left << std::setw(48) << b.name
+                      << "failed: " << e.what() << std::endl;
+            failed = true;
+        }
+    }
+
+    if (!options.jsonFile.empty()) {
+        std::ofstream out(options.jsonFile);
+        if (!out) {
+            std::cerr << "cannot write to " << options.jsonFile << "\n";
+            return 1;
+        }
+        writeJson(out, results, options);
+    }
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,102 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "benchmark.hpp"
+#include <ql/experimental/risk/scenarioengine.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
+#include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/settings.hpp>
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/termstructures/yield/ratehelpers.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
+
+using namespace QuantLib;
+
+namespace {
+
+    /* A book of spot-starting swaps against Euribor 6M with
+       maturities up to 20 years; the quotes are the par rates of the
+       curve bootstrapped for both forecasting and discounting, so
+       that each scenario causes a new bootstrap before the book is
+       revalued. */
+
+    const std::vector<Integer> swapTenors = { 1, 2, 3, 4, 5, 7, 10, 12, 15, 20 };
+
+    ScenarioPortfolio swapBook(const Date& today, Size nSwaps) {
+        Settings::instance().evaluationDate() = today;
+        RelinkableHandle<YieldTermStructure> forwarding;
+        auto index = ext::make_shared<Euribor6M>(forwarding);
+
+        ScenarioPortfolio book;
+        std::vector<ext::shared_ptr<RateHelper> > helpers;
+        for (Integer tenor : swapTenors) {
+            auto quote = ext::make_shared<SimpleQuote>(0.025 + 0.0005*tenor);
+            book.quotes.emplace_back(quote);
+            helpers.push_back(ext::make_shared<SwapRateHelper>(
+                Handle<Quote>(quote), Period(tenor, Years), TARGET(), Annual,
+                Unadjusted, Thirty360(Thirty360::BondBasis), index));
+        }
+        auto curve = ext::make_shared<PiecewiseYieldCurve<Discount, LogLinear> >(
+            today, helpers, Actual365Fixed());
+        forwarding.linkTo(curve);
+        auto engine = ext::make_shared<DiscountingSwapEngine>(
+            Handle<YieldTermStructure>(curve));
+
+        for (Size i=0; i<nSwaps; ++i) {
+            book.instruments.push_back(
+                ext::shared_ptr<VanillaSwap>(
+                    MakeVanillaSwap(Period(Integer(1 + i % 20), Years), index,
+                                    0.02 + 0.001*(i % 20))
+                    .withFixedLegDayCount(Thirty360(Thirty360::BondBasis))
+                    .withType(i % 2 == 0 ? Swap::Payer : Swap::Receiver)
+                    .withPricingEngine(engine)));
+        }
+        return book;
+    }
+
+    // the size is the number of scenarios; the book has 10,000 swaps
+    RegisterBenchmark scenarioRevaluation(
+        "risk/scenarios", 1000, "scenarios",
+        [](Size n) -> BenchmarkBody {
+            Date today = Settings::instance().evaluationDate();
+            const Size nQuotes = swapTenors.size();
+            std::vector<std::vector<Real> > scenarios;
+            for (Size i=0; i<n; ++i) {
+                // parallel shifts and twists of up to 100 bp
+                Real parallel = 0.01*(Real(i) / n - 0.5);
+                Real twist = 0.002*(Integer(i % 7) - 3);
+                std::vector<Real> shifts(nQuotes);
+                for (Size j=0; j<nQuotes; ++j)
+                    shifts[j] = parallel + twist*j/(nQuotes-1);
+                scenarios.push_back(shifts);
+            }
+            auto engine = ext::make_shared<ScenarioEngine>(
+                [today]() { return swapBook(today, 10000); }, scenarios);
+            return [=]() {
+                Matrix npvs = engine->calculate();
+                Real sum = 0.0;
+                for (Real x : npvs)
+                    sum += x;
+                return sum;
+            };
+        });
+
+}
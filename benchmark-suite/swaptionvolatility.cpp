@@ -0,0 +1,104 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "benchmark.hpp"
+#include <ql/indexes/swap/euriborswap.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/settings.hpp>
+#include <ql/termstructures/volatility/swaption/sabrswaptionvolatilitycube.hpp>
+#include <ql/termstructures/volatility/swaption/swaptionvolmatrix.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+
+using namespace QuantLib;
+
+namespace {
+
+    std::vector<std::vector<Handle<Quote> > > quotes(const Matrix& values) {
+        std::vector<std::vector<Handle<Quote> > > result(values.rows());
+        for (Size i=0; i<values.rows(); ++i) {
+            for (Size j=0; j<values.columns(); ++j)
+                result[i].emplace_back(ext::make_shared<SimpleQuote>(values[i][j]));
+        }
+        return result;
+    }
+
+    /* Each call moves one of the smile quotes back and forth and
+       queries the cube, which recalibrates the SABR parameters of
+       all its smile sections. */
+
+    RegisterBenchmark sabrCubeCalibration(
+        "swaptionvolatility/sabr_cube_calibration", 2, "calibrations",
+        [](Size n) -> BenchmarkBody {
+            Date today = Settings::instance().evaluationDate();
+            Handle<YieldTermStructure> curve(
+                ext::make_shared<FlatForward>(today, 0.03, Actual365Fixed()));
+
+            std::vector<Period> atmOptionTenors = { 1*Months, 6*Months, 1*Years,
+                                                    5*Years, 10*Years, 30*Years };
+            std::vector<Period> atmSwapTenors = { 1*Years, 5*Years, 10*Years, 30*Years };
+            Matrix atmVols(atmOptionTenors.size(), atmSwapTenors.size());
+            for (Size i=0; i<atmVols.rows(); ++i) {
+                for (Size j=0; j<atmVols.columns(); ++j)
+                    atmVols[i][j] = 0.16 - 0.005 * Real(i) - 0.008 * Real(j);
+            }
+            Handle<SwaptionVolatilityStructure> atmVolMatrix(
+                ext::make_shared<SwaptionVolatilityMatrix>(
+                    TARGET(), ModifiedFollowing, atmOptionTenors, atmSwapTenors,
+                    quotes(atmVols), Actual365Fixed()));
+
+            std::vector<Period> optionTenors = { 1*Years, 10*Years, 30*Years };
+            std::vector<Period> swapTenors = { 2*Years, 10*Years, 30*Years };
+            std::vector<Spread> strikeSpreads = { -0.020, -0.005, 0.0, 0.005, 0.020 };
+            Matrix volSpreads(optionTenors.size() * swapTenors.size(), strikeSpreads.size());
+            for (Size i=0; i<volSpreads.rows(); ++i) {
+                Real skew = 0.6 + 0.05 * Real(i);
+                volSpreads[i][0] = 0.0600 * skew;
+                volSpreads[i][1] = 0.0080 * skew;
+                volSpreads[i][2] = 0.0;
+                volSpreads[i][3] = -0.0040 * skew;
+                volSpreads[i][4] = 0.0010 * skew;
+            }
+            auto volSpreadQuotes = quotes(volSpreads);
+            auto bumped = ext::dynamic_pointer_cast<SimpleQuote>(*volSpreadQuotes[0][0]);
+
+            std::vector<std::vector<Handle<Quote> > > guess(volSpreads.rows());
+            for (auto& g : guess) {
+                for (Real p : { 0.2, 0.5, 0.4, 0.0 })
+                    g.emplace_back(ext::make_shared<SimpleQuote>(p));
+            }
+
+            auto swapIndex = ext::make_shared<EuriborSwapIsdaFixA>(2*Years, curve);
+            auto shortSwapIndex = ext::make_shared<EuriborSwapIsdaFixA>(1*Years, curve);
+            auto cube = ext::make_shared<SabrSwaptionVolatilityCube>(
+                atmVolMatrix, optionTenors, swapTenors, strikeSpreads, volSpreadQuotes,
+                swapIndex, shortSwapIndex, false, guess, std::vector<bool>(4, false), true);
+
+            Real sign = 1.0;
+            return [=]() mutable {
+                Real sum = 0.0;
+                for (Size i=0; i<n; ++i) {
+                    bumped->setValue(bumped->value() + sign * 1.0e-4);
+                    sign = -sign;
+                    sum += cube->volatility(5*Years, 10*Years, 0.03, true);
+                }
+                return sum;
+            };
+        });
+
+}
@@ -0,0 +1,131 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "benchmark.hpp"
+#include <ql/indexes/ibor/estr.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/math/interpolations/loginterpolation.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/settings.hpp>
+#include <ql/termstructures/credit/defaultprobabilityhelpers.hpp>
+#include <ql/termstructures/credit/piecewisedefaultcurve.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/yield/oisratehelper.hpp>
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/termstructures/yield/ratehelpers.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/calendars/weekendsonly.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
+
+using namespace QuantLib;
+
+namespace {
+
+    /* The timed part moves one of the quotes back and forth by one
+       basis point, which triggers a full bootstrap of the curve
+       when it is queried afterwards. */
+
+    template <class Curve, class Query>
+    BenchmarkBody bumpAndQuery(const ext::shared_ptr<SimpleQuote>& quote,
+                               const ext::shared_ptr<Curve>& curve,
+                               Query query) {
+        Real sign = 1.0;
+        return [=]() mutable {
+            quote->setValue(quote->value() + sign * 1.0e-4);
+            sign = -sign;
+            return query(*curve);
+        };
+    }
+
+    RegisterBenchmark swapCurveBootstrap(
+        "yieldcurve/swap_bootstrap", 30, "instruments",
+        [](Size n) -> BenchmarkBody {
+            Date today = Settings::instance().evaluationDate();
+            auto index = ext::make_shared<Euribor6M>();
+            std::vector<ext::shared_ptr<SimpleQuote> > quotes;
+            std::vector<ext::shared_ptr<RateHelper> > helpers;
+            for (Size i=0; i<n; ++i) {
+                quotes.push_back(ext::make_shared<SimpleQuote>(0.025 + 0.0005*i));
+                helpers.push_back(ext::make_shared<SwapRateHelper>(
+                    Handle<Quote>(quotes.back()), Period(Integer(i+1), Years),
+                    TARGET(), Annual, Unadjusted, Thirty360(Thirty360::BondBasis),
+                    index));
+            }
+            auto curve = ext::make_shared<PiecewiseYieldCurve<Discount, LogLinear> >(
+                today, helpers, Actual365Fixed());
+            return bumpAndQuery(quotes.front(), curve,
+                                [](const YieldTermStructure& c) {
+                                    return c.discount(c.maxDate());
+                                });
+        });
+
+    RegisterBenchmark oisCurveBootstrap(
+        "yieldcurve/ois_bootstrap", 30, "instruments",
+        [](Size n) -> BenchmarkBody {
+            Date today = Settings::instance().evaluationDate();
+            auto index = ext::make_shared<Estr>();
+            std::vector<ext::shared_ptr<SimpleQuote> > quotes;
+            std::vector<ext::shared_ptr<RateHelper> > helpers;
+            for (Size i=0; i<n; ++i) {
+                Period tenor = i < 12 ? Period(Integer(i+1), Months)
+                                      : Period(Integer(i-10), Years);
+                quotes.push_back(ext::make_shared<SimpleQuote>(0.03 - 0.0002*i));
+                helpers.push_back(ext::make_shared<OISRateHelper>(
+                    2, tenor, Handle<Quote>(quotes.back()), index));
+            }
+            auto curve = ext::make_shared<PiecewiseYieldCurve<ForwardRate, BackwardFlat> >(
+                today, helpers, Actual365Fixed());
+            return bumpAndQuery(quotes.front(), curve,
+                                [](const YieldTermStructure& c) {
+                                    return c.discount(c.maxDate());
+                                });
+        });
+
+    BenchmarkBody cdsBootstrap(Size n, CreditDefaultSwap::PricingModel model) {
+        Date today = Settings::instance().evaluationDate();
+        Handle<YieldTermStructure> discountCurve(
+            ext::make_shared<FlatForward>(today, 0.03, Actual365Fixed()));
+        Real recoveryRate = 0.4;
+        std::vector<ext::shared_ptr<SimpleQuote> > quotes;
+        std::vector<ext::shared_ptr<DefaultProbabilityHelper> > helpers;
+        for (Size i=0; i<n; ++i) {
+            quotes.push_back(ext::make_shared<SimpleQuote>(0.01 + 0.0005*i));
+            helpers.push_back(ext::make_shared<SpreadCdsHelper>(
+                Handle<Quote>(quotes.back()), Period(Integer(i+1), Years), 1,
+                WeekendsOnly(), Quarterly, Following, DateGeneration::CDS2015,
+                Actual360(), recoveryRate, discountCurve, true, true, Date(),
+                Actual360(true), true, model));
+        }
+        auto curve = ext::make_shared<PiecewiseDefaultCurve<SurvivalProbability, LogLinear> >(
+            today, helpers, Actual365Fixed());
+        return bumpAndQuery(quotes.front(), curve,
+                            [](const DefaultProbabilityTermStructure& c) {
+                                return c.survivalProbability(c.maxDate());
+                            });
+    }
+
+    RegisterBenchmark cdsCurveBootstrap(
+        "defaultcurve/cds_bootstrap", 10, "instruments",
+        [](Size n) { return cdsBootstrap(n, CreditDefaultSwap::Midpoint); });
+
+    RegisterBenchmark isdaCdsCurveBootstrap(
+        "defaultcurve/isda_cds_bootstrap", 10, "instruments",
+        [](Size n) { return cdsBootstrap(n, CreditDefaultSwap::ISDA); });
+
+}
@@ -0,0 +1,169 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "benchmark.hpp"
+#include <ql/exercise.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/models/equity/hestonmodel.hpp>
+#include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/vanilla/analytichestonengine.hpp>
+#include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
+#include <ql/pricingengines/vanilla/mcamericanengine.hpp>
+#include <ql/pricingengines/vanilla/mceuropeanengine.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/processes/hestonprocess.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/settings.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/time/calendars/nullcalendar.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+
+using namespace QuantLib;
+
+namespace {
+
+    ext::shared_ptr<GeneralizedBlackScholesProcess> blackScholesProcess() {
+        Date today = Settings::instance().evaluationDate();
+        DayCounter dc = Actual365Fixed();
+        return ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+            Handle<YieldTermStructure>(ext::make_shared<FlatForward>(today, 0.02, dc)),
+            Handle<YieldTermStructure>(ext::make_shared<FlatForward>(today, 0.04, dc)),
+            Handle<BlackVolTermStructure>(
+                ext::make_shared<BlackConstantVol>(today, NullCalendar(), 0.25, dc)));
+    }
+
+    ext::shared_ptr<HestonModel> hestonModel() {
+        Date today = Settings::instance().evaluationDate();
+        DayCounter dc = Actual365Fixed();
+        return ext::make_shared<HestonModel>(ext::make_shared<HestonProcess>(
+            Handle<YieldTermStructure>(ext::make_shared<FlatForward>(today, 0.04, dc)),
+            Handle<YieldTermStructure>(ext::make_shared<FlatForward>(today, 0.02, dc)),
+            Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+            0.04, 1.5, 0.04, 0.5, -0.7));
+    }
+
+    std::vector<ext::shared_ptr<VanillaOption> >
+    makeOptions(Size n, const ext::shared_ptr<Exercise>& exercise,
+                const ext::shared_ptr<PricingEngine>& engine) {
+        std::vector<ext::shared_ptr<VanillaOption> > options;
+        for (Size i=0; i<n; ++i) {
+            Real strike = 60.0 + 80.0 * Real(i) / Real(std::max<Size>(n-1, 1));
+            options.push_back(ext::make_shared<VanillaOption>(
+                ext::make_shared<PlainVanillaPayoff>(i % 2 == 0 ? Option::Call : Option::Put,
+                                                     strike),
+                exercise));
+            options.back()->setPricingEngine(engine);
+        }
+        return options;
+    }
+
+    // forces the recalculation of the options and sums their values
+    BenchmarkBody recalculate(std::vector<ext::shared_ptr<VanillaOption> > options) {
+        return [=]() {
+            Real sum = 0.0;
+            for (const auto& option : options) {
+                option->recalculate();
+                sum += option->NPV();
+            }
+            return sum;
+        };
+    }
+
+    Date maturity(Integer years) {
+        Date today = Settings::instance().evaluationDate();
+        return today + Period(years, Years);
+    }
+
+    RegisterBenchmark blackPrice(
+        "blackformula/price", 10000, "options",
+        [](Size n) -> BenchmarkBody {
+            return [=]() {
+                Real sum = 0.0;
+                for (Size i=0; i<n; ++i) {
+                    Real strike = 50.0 + Real(i % 100);
+                    sum += blackFormula(Option::Call, strike, 100.0,
+                                        0.05 + 0.001 * Real(i % 50), 0.97);
+                }
+                return sum;
+            };
+        });
+
+    RegisterBenchmark blackImpliedVolatility(
+        "blackformula/implied_stddev", 1000, "options",
+        [](Size n) -> BenchmarkBody {
+            std::vector<Real> strikes(n), prices(n);
+            for (Size i=0; i<n; ++i) {
+                strikes[i] = 80.0 + 0.4 * Real(i % 100);
+                prices[i] = blackFormula(Option::Call, strikes[i], 100.0,
+                                         0.1 + 0.006 * Real(i % 50), 0.97);
+            }
+            return [=]() {
+                Real sum = 0.0;
+                for (Size i=0; i<n; ++i)
+                    sum += blackFormulaImpliedStdDev(Option::Call, strikes[i], 100.0,
+                                                     prices[i], 0.97);
+                return sum;
+            };
+        });
+
+    RegisterBenchmark hestonAnalytic(
+        "heston/analytic", 100, "options",
+        [](Size n) -> BenchmarkBody {
+            auto engine = ext::make_shared<AnalyticHestonEngine>(hestonModel());
+            auto exercise = ext::make_shared<EuropeanExercise>(maturity(1));
+            return recalculate(makeOptions(n, exercise, engine));
+        });
+
+    RegisterBenchmark hestonFiniteDifferences(
+        "heston/fd_vanilla", 50, "time steps",
+        [](Size n) -> BenchmarkBody {
+            auto engine = ext::make_shared<FdHestonVanillaEngine>(hestonModel(), n, 100, 50);
+            auto exercise = ext::make_shared<AmericanExercise>(
+                Settings::instance().evaluationDate(), maturity(1));
+            return recalculate(makeOptions(1, exercise, engine));
+        });
+
+    RegisterBenchmark mcEuropean(
+        "montecarlo/european", 100000, "paths",
+        [](Size n) -> BenchmarkBody {
+            ext::shared_ptr<PricingEngine> engine =
+                MakeMCEuropeanEngine<PseudoRandom>(blackScholesProcess())
+                .withSteps(1)
+                .withSamples(n)
+                .withSeed(42);
+            auto exercise = ext::make_shared<EuropeanExercise>(maturity(1));
+            return recalculate(makeOptions(1, exercise, engine));
+        });
+
+    RegisterBenchmark mcAmericanLsm(
+        "montecarlo/american_lsm", 5000, "paths",
+        [](Size n) -> BenchmarkBody {
+            ext::shared_ptr<PricingEngine> engine =
+                MakeMCAmericanEngine<PseudoRandom>(blackScholesProcess())
+                .withSteps(50)
+                .withAntitheticVariate()
+                .withCalibrationSamples(std::max<Size>(n/4, 1))
+                .withSamples(n)
+                .withSeed(42);
+            auto exercise = ext::make_shared<AmericanExercise>(
+                Settings::instance().evaluationDate(), maturity(1));
+            return recalculate(makeOptions(1, exercise, engine));
+        });
+
+}
@@ -21,6 +21,7 @@
 */
 
 #include <ql/cashflows/cashflows.hpp>
+#include <ql/cashflows/compiledleg.hpp>
 #include <ql/cashflows/coupon.hpp>
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/math/solvers1d/brent.hpp>
@@ -396,27 +397,59 @@ namespace QuantLib {
     // YieldTermStructure utility functions
     namespace {
 
-        class BPSCalculator : public AcyclicVisitor,
+        class AccrualWeight : public AcyclicVisitor,
                               public Visitor<CashFlow>,
                               public Visitor<Coupon> {
           public:
-            explicit BPSCalculator(const YieldTermStructure& discountCurve)
-            : discountCurve_(discountCurve) {}
             void visit(Coupon& c) override {
-                Real bps = c.nominal() *
-                           c.accrualPeriod() *
-                           discountCurve_.discount(c.date());
-                bps_ += bps;
+                weight_ = c.nominal() * c.accrualPeriod();
             }
-            void visit(CashFlow& cf) override {
-                nonSensNPV_ += cf.amount() * 
-                               discountCurve_.discount(cf.date());
+            void visit(CashFlow&) override {
+                weight_ = Null<Real>();
             }
-            Real bps() const { return bps_; }
-            Real nonSensNPV() const { return nonSensNPV_; }
+            Real weight() const { return weight_; }
           private:
-            const YieldTermStructure& discountCurve_;
-            Real bps_ = 0.0, nonSensNPV_ = 0.0;
+            Real weight_ = Null<Real>();
+        };
+
+        // alive cash flows of a leg, laid out for batched discounting;
+        // amounts are only retrieved if needed, since those of
+        // coupons might not be available when calculating the BPS
+        class AliveFlows {
+          public:
+            AliveFlows(const Leg& leg,
+                       const YieldTermStructure& discountCurve,
+                       bool includeSettlementDateFlows,
+                       const Date& settlementDate,
+                       bool withAmounts,
+                       bool withWeights) {
+                times_.reserve(leg.size());
+                amounts_.reserve(leg.size());
+                if (withWeights)
+                    weights_.reserve(leg.size());
+                AccrualWeight weight;
+                for (const auto& i : leg) {
+                    CashFlow& cf = *i;
+                    if (!cf.hasOccurred(settlementDate,
+                                        includeSettlementDateFlows) &&
+                        !cf.tradingExCoupon(settlementDate)) {
+                        times_.push_back(discountCurve.timeFromReference(cf.date()));
+                        amounts_.push_back(withAmounts ? cf.amount() : Real(0.0));
+                        if (withWeights) {
+                            cf.accept(weight);
+                            weights_.push_back(weight.weight());
+                        }
+                    }
+                }
+                sums_ = detail::discountedSums(discountCurve, times_, amounts_,
+                                               weights_, discounts_);
+            }
+            const detail::DiscountedSums& sums() const { return sums_; }
+          private:
+            std::vector<Time> times_;
+            std::vector<Real> amounts_, weights_;
+            std::vector<DiscountFactor> discounts_;
+            detail::DiscountedSums sums_;
         };
 
         const Spread basisPoint_ = 1.0e-4;
@@ -437,14 +470,9 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
-        Real totalNPV = 0.0;
-        for (const auto& i : leg) {
-            if (!i->hasOccurred(settlementDate, includeSettlementDateFlows) &&
-                !i->tradingExCoupon(settlementDate))
-                totalNPV += i->amount() * discountCurve.discount(i->date());
-        }
-
-        return totalNPV/discountCurve.discount(npvDate);
+        AliveFlows flows(leg, discountCurve, includeSettlementDateFlows,
+                         settlementDate, true, false);
+        return flows.sums().npv/discountCurve.discount(npvDate);
     }
 
     Real CashFlows::bps(const Leg& leg,
@@ -461,13 +489,9 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
-        BPSCalculator calc(discountCurve);
-        for (const auto& i : leg) {
-            if (!i->hasOccurred(settlementDate, includeSettlementDateFlows) &&
-                !i->tradingExCoupon(settlementDate))
-                i->accept(calc);
-        }
-        return basisPoint_*calc.bps()/discountCurve.discount(npvDate);
+        AliveFlows flows(leg, discountCurve, includeSettlementDateFlows,
+                         settlementDate, false, true);
+        return basisPoint_*flows.sums().bps/discountCurve.discount(npvDate);
     }
 
     std::pair<Real, Real> CashFlows::npvbps(const Leg& leg,
@@ -475,11 +499,8 @@ namespace QuantLib {
                                             bool includeSettlementDateFlows,
                                             Date settlementDate,
                                             Date npvDate) {
-        Real npv = 0.0;
-        Real bps = 0.0;
-
         if (leg.empty()) {
-            return { npv, bps };
+            return { 0.0, 0.0 };
         }
 
         if (settlementDate == Date())
@@ -488,21 +509,11 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
-        for (const auto& i : leg) {
-            CashFlow& cf = *i;
-            if (!cf.hasOccurred(settlementDate,
-                                includeSettlementDateFlows) &&
-                !cf.tradingExCoupon(settlementDate)) {
-                ext::shared_ptr<Coupon> cp = ext::dynamic_pointer_cast<Coupon>(i);
-                Real df = discountCurve.discount(cf.date());
-                npv += cf.amount() * df;
-                if (cp != nullptr)
-                    bps += cp->nominal() * cp->accrualPeriod() * df;
-            }
-        }
+        AliveFlows flows(leg, discountCurve, includeSettlementDateFlows,
+                         settlementDate, true, true);
         DiscountFactor d = discountCurve.discount(npvDate);
-        npv /= d;
-        bps = basisPoint_ * bps / d;
+        Real npv = flows.sums().npv / d;
+        Real bps = basisPoint_ * flows.sums().bps / d;
 
         return { npv, bps };
     }
@@ -522,30 +533,21 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
-        Real npv = 0.0;
-        BPSCalculator calc(discountCurve);
-        for (const auto& i : leg) {
-            CashFlow& cf = *i;
-            if (!cf.hasOccurred(settlementDate,
-                                includeSettlementDateFlows) &&
-                !cf.tradingExCoupon(settlementDate)) {
-                npv += cf.amount() *
-                       discountCurve.discount(cf.date());
-                cf.accept(calc);
-            }
-        }
+        AliveFlows flows(leg, discountCurve, includeSettlementDateFlows,
+                         settlementDate, true, true);
+        const detail::DiscountedSums& sums = flows.sums();
 
         if (targetNpv==Null<Real>())
-            targetNpv = npv - calc.nonSensNPV();
+            targetNpv = sums.npv - sums.nonSensNPV;
         else {
             targetNpv *= discountCurve.discount(npvDate);
-            targetNpv -= calc.nonSensNPV();
+            targetNpv -= sums.nonSensNPV;
         }
 
         if (targetNpv==0.0)
             return 0.0;
 
-        Real bps = calc.bps();
+        Real bps = sums.bps;
         QL_REQUIRE(bps!=0.0, "null bps: impossible atm rate");
 
         return targetNpv/bps;
@@ -0,0 +1,396 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/cashflows/compiledleg.hpp>
+#include <ql/cashflows/coupon.hpp>
+#include <ql/settings.hpp>
+#include <ql/time/period.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        DiscountedSums discountedSums(const YieldTermStructure& discountCurve,
+                                      const std::vector<Time>& times,
+                                      const std::vector<Real>& amounts,
+                                      const std::vector<Real>& weights,
+                                      std::vector<DiscountFactor>& discounts) {
+            Size n = times.size();
+            discounts.resize(n);
+            if (std::is_sorted(times.begin(), times.end())) {
+                discountCurve.discounts(times.data(), discounts.data(), n);
+            } else {
+                for (Size k=0; k<n; ++k)
+                    discounts[k] = discountCurve.discount(times[k]);
+            }
+
+            DiscountedSums s;
+            if (weights.empty()) {
+                for (Size k=0; k<n; ++k)
+                    s.npv += amounts[k] * discounts[k];
+            } else {
+                for (Size k=0; k<n; ++k) {
+                    Real df = discounts[k];
+                    s.npv += amounts[k] * df;
+                    if (weights[k] != Null<Real>())
+                        s.bps += weights[k] * df;
+                    else
+                        s.nonSensNPV += amounts[k] * df;
+                }
+            }
+            return s;
+        }
+
+    }
+
+    CompiledLeg::CompiledLeg(Leg leg)
+    : leg_(std::move(leg)), dates_(leg_.size()), exCouponDates_(leg_.size()),
+      coupons_(leg_.size()), startDate_(Date::maxDate()), maturityDate_(Date::minDate()),
+      amounts_(leg_.size(), Null<Real>()), times_(leg_.size()) {
+        for (Size i=0; i<leg_.size(); ++i) {
+            QL_REQUIRE(leg_[i], "null cash flow #" << i+1);
+            dates_[i] = leg_[i]->date();
+            exCouponDates_[i] = leg_[i]->exCouponDate();
+            coupons_[i] = ext::dynamic_pointer_cast<Coupon>(leg_[i]);
+            if (coupons_[i] != nullptr) {
+                startDate_ = std::min(startDate_, coupons_[i]->accrualStartDate());
+                maturityDate_ = std::max(maturityDate_, coupons_[i]->accrualEndDate());
+            } else {
+                startDate_ = std::min(startDate_, dates_[i]);
+                maturityDate_ = std::max(maturityDate_, dates_[i]);
+            }
+            registerWith(leg_[i]);
+        }
+        flows_.reserve(leg_.size());
+        aliveTimes_.reserve(leg_.size());
+        aliveAmounts_.reserve(leg_.size());
+        aliveWeights_.reserve(leg_.size());
+        discounts_.reserve(leg_.size());
+    }
+
+    Date CompiledLeg::startDate() const {
+        QL_REQUIRE(!leg_.empty(), "empty leg");
+        return startDate_;
+    }
+
+    Date CompiledLeg::maturityDate() const {
+        QL_REQUIRE(!leg_.empty(), "empty leg");
+        return maturityDate_;
+    }
+
+    void CompiledLeg::performCalculations() const {
+        // amounts are retrieved lazily, since those of past cash
+        // flows might not be available (e.g., missing fixings)
+        std::fill(amounts_.begin(), amounts_.end(), Null<Real>());
+    }
+
+    bool CompiledLeg::hasOccurred(Size i,
+                                  bool includeSettlementDateFlows,
+                                  const Date& settlementDate) const {
+        const Date& d = dates_[i];
+        if (d > settlementDate)
+            return false;
+        else if (d < settlementDate)
+            return true;
+        else // the cash flow takes the settings into account
+            return leg_[i]->hasOccurred(settlementDate,
+                                        includeSettlementDateFlows);
+    }
+
+    bool CompiledLeg::tradingExCoupon(Size i, const Date& settlementDate) const {
+        const Date& ecd = exCouponDates_[i];
+        return ecd != Date() && ecd <= settlementDate;
+    }
+
+    Real CompiledLeg::amount(Size i) const {
+        if (amounts_[i] == Null<Real>())
+            amounts_[i] = leg_[i]->amount();
+        return amounts_[i];
+    }
+
+    void CompiledLeg::updateWeights() const {
+        // coupons don't change their nominal or accrual period, but
+        // the calculation is delayed until needed since not every
+        // engine pricing the leg uses them
+        if (!weights_.empty())
+            return;
+        weights_.resize(leg_.size(), Null<Real>());
+        for (Size i=0; i<leg_.size(); ++i) {
+            if (coupons_[i] != nullptr)
+                weights_[i] = coupons_[i]->nominal() * coupons_[i]->accrualPeriod();
+        }
+    }
+
+    void CompiledLeg::updateTimes(const YieldTermStructure& curve) const {
+        Date referenceDate = curve.referenceDate();
+        DayCounter dayCounter = curve.dayCounter();
+        if (referenceDate == timesReferenceDate_ && !timesDayCounter_.empty()
+            && dayCounter == timesDayCounter_)
+            return;
+        for (Size i=0; i<dates_.size(); ++i)
+            times_[i] = dayCounter.yearFraction(referenceDate, dates_[i]);
+        timesReferenceDate_ = referenceDate;
+        timesDayCounter_ = dayCounter;
+    }
+
+    detail::DiscountedSums
+    CompiledLeg::sums(const YieldTermStructure& discountCurve,
+                      bool includeSettlementDateFlows,
+                      Date settlementDate) const {
+        calculate();
+        updateWeights();
+        updateTimes(discountCurve);
+
+        aliveTimes_.clear();
+        aliveAmounts_.clear();
+        aliveWeights_.clear();
+        for (Size i=0; i<dates_.size(); ++i) {
+            if (!hasOccurred(i, includeSettlementDateFlows, settlementDate)
+                && !tradingExCoupon(i, settlementDate)) {
+                aliveTimes_.push_back(times_[i]);
+                aliveAmounts_.push_back(amount(i));
+                aliveWeights_.push_back(weights_[i]);
+            }
+        }
+
+        return detail::discountedSums(discountCurve, aliveTimes_, aliveAmounts_,
+                                      aliveWeights_, discounts_);
+    }
+
+    Real CompiledLeg::npv(const YieldTermStructure& discountCurve,
+                          bool includeSettlementDateFlows,
+                          Date settlementDate,
+                          Date npvDate) const {
+        return npvbps(discountCurve, includeSettlementDateFlows,
+                      settlementDate, npvDate).first;
+    }
+
+    Real CompiledLeg::bps(const YieldTermStructure& discountCurve,
+                          bool includeSettlementDateFlows,
+                          Date settlementDate,
+                          Date npvDate) const {
+        return npvbps(discountCurve, includeSettlementDateFlows,
+                      settlementDate, npvDate).second;
+    }
+
+    std::pair<Real, Real>
+    CompiledLeg::npvbps(const YieldTermStructure& discountCurve,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate,
+                        Date npvDate) const {
+        if (leg_.empty())
+            return { 0.0, 0.0 };
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        detail::DiscountedSums s =
+            sums(discountCurve, includeSettlementDateFlows, settlementDate);
+        DiscountFactor d = discountCurve.discount(npvDate);
+        const Spread basisPoint = 1.0e-4;
+        return { s.npv / d, basisPoint * s.bps / d };
+    }
+
+    Rate CompiledLeg::atmRate(const YieldTermStructure& discountCurve,
+                              bool includeSettlementDateFlows,
+                              Date settlementDate,
+                              Date npvDate,
+                              Real targetNpv) const {
+        if (leg_.empty())
+            return 0.0;
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        detail::DiscountedSums s =
+            sums(discountCurve, includeSettlementDateFlows, settlementDate);
+
+        if (targetNpv==Null<Real>())
+            targetNpv = s.npv - s.nonSensNPV;
+        else {
+            targetNpv *= discountCurve.discount(npvDate);
+            targetNpv -= s.nonSensNPV;
+        }
+
+        if (targetNpv==0.0)
+            return 0.0;
+
+        QL_REQUIRE(s.bps!=0.0, "null bps: impossible atm rate");
+
+        return targetNpv/s.bps;
+    }
+
+    Time CompiledLeg::stepwiseTime(Size i,
+                                   const DayCounter& dc,
+                                   const Date& npvDate,
+                                   const Date& lastDate) const {
+        // same as the calculation in CashFlows::duration
+        const Date& cashFlowDate = dates_[i];
+        const ext::shared_ptr<Coupon>& coupon = coupons_[i];
+        Date refStartDate, refEndDate;
+        if (coupon != nullptr) {
+            refStartDate = coupon->referencePeriodStart();
+            refEndDate = coupon->referencePeriodEnd();
+        } else {
+            if (lastDate == npvDate) {
+                // we don't have a previous coupon date,
+                // so we fake it
+                refStartDate = cashFlowDate - 1*Years;
+            } else  {
+                refStartDate = lastDate;
+            }
+            refEndDate = cashFlowDate;
+        }
+
+        if ((coupon != nullptr) && lastDate != coupon->accrualStartDate()) {
+            Time couponPeriod = dc.yearFraction(coupon->accrualStartDate(),
+                                                cashFlowDate, refStartDate, refEndDate);
+            Time accruedPeriod = dc.yearFraction(coupon->accrualStartDate(),
+                                                 lastDate, refStartDate, refEndDate);
+            return couponPeriod - accruedPeriod;
+        } else {
+            return dc.yearFraction(lastDate, cashFlowDate,
+                                   refStartDate, refEndDate);
+        }
+    }
+
+    void CompiledLeg::updateStepwiseTimes(const DayCounter& dayCounter,
+                                          const Date& npvDate) const {
+        // flows_ holds the cash flows which have not occurred yet
+        if (npvDate == stepwiseNpvDate_ && !stepwiseDayCounter_.empty()
+            && dayCounter == stepwiseDayCounter_ && flows_ == stepwiseFlows_)
+            return;
+        stepwiseTimes_.resize(flows_.size());
+        Time t = 0.0;
+        Date lastDate = npvDate;
+        for (Size k=0; k<flows_.size(); ++k) {
+            Size i = flows_[k];
+            t += stepwiseTime(i, dayCounter, npvDate, lastDate);
+            stepwiseTimes_[k] = t;
+            lastDate = dates_[i];
+        }
+        stepwiseFlows_ = flows_;
+        stepwiseNpvDate_ = npvDate;
+        stepwiseDayCounter_ = dayCounter;
+    }
+
+    Real CompiledLeg::modifiedDuration(const InterestRate& y,
+                                       const Date& settlementDate) const {
+        Real P = 0.0;
+        Real dPdy = 0.0;
+        Rate r = y.rate();
+        Natural N = y.frequency();
+        for (Size k=0; k<flows_.size(); ++k) {
+            Size i = flows_[k];
+            Real c = tradingExCoupon(i, settlementDate) ? Real(0.0) : amount(i);
+            Time t = stepwiseTimes_[k];
+            DiscountFactor B = y.discountFactor(t);
+            P += c * B;
+            switch (y.compounding()) {
+              case Simple:
+                dPdy -= c * B*B * t;
+                break;
+              case Compounded:
+                dPdy -= c * t * B/(1+r/N);
+                break;
+              case Continuous:
+                dPdy -= c * B * t;
+                break;
+              case SimpleThenCompounded:
+                if (t<=1.0/N)
+                    dPdy -= c * B*B * t;
+                else
+                    dPdy -= c * t * B/(1+r/N);
+                break;
+              case CompoundedThenSimple:
+                if (t>1.0/N)
+                    dPdy -= c * B*B * t;
+                else
+                    dPdy -= c * t * B/(1+r/N);
+                break;
+              default:
+                QL_FAIL("unknown compounding convention (" <<
+                        Integer(y.compounding()) << ")");
+            }
+        }
+
+        if (P == 0.0) // no cashflows
+            return 0.0;
+        return -dPdy/P; // reverse derivative sign
+    }
+
+    Time CompiledLeg::duration(const InterestRate& y,
+                               Duration::Type type,
+                               bool includeSettlementDateFlows,
+                               Date settlementDate,
+                               Date npvDate) const {
+        if (leg_.empty())
+            return 0.0;
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        calculate();
+
+        flows_.clear();
+        for (Size i=0; i<dates_.size(); ++i) {
+            if (!hasOccurred(i, includeSettlementDateFlows, settlementDate))
+                flows_.push_back(i);
+        }
+        updateStepwiseTimes(y.dayCounter(), npvDate);
+
+        switch (type) {
+          case Duration::Simple: {
+              Real P = 0.0;
+              Real dPdy = 0.0;
+              for (Size k=0; k<flows_.size(); ++k) {
+                  Size i = flows_[k];
+                  Real c = tradingExCoupon(i, settlementDate) ? Real(0.0) : amount(i);
+                  Time t = stepwiseTimes_[k];
+                  DiscountFactor B = y.discountFactor(t);
+                  P += c * B;
+                  dPdy += t * c * B;
+              }
+              if (P == 0.0) // no cashflows
+                  return 0.0;
+              return dPdy/P;
+          }
+          case Duration::Modified:
+            return modifiedDuration(y, settlementDate);
+          case Duration::Macaulay:
+            QL_REQUIRE(y.compounding() == Compounded,
+                       "compounded rate required");
+            return (1.0+y.rate()/Integer(y.frequency())) *
+                modifiedDuration(y, settlementDate);
+          default:
+            QL_FAIL("unknown duration type");
+        }
+    }
+
+}
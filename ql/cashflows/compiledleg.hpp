@@ -0,0 +1,159 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file compiledleg.hpp
+    \brief Leg data cached in contiguous arrays for fast discounting
+*/
+
+#ifndef quantlib_compiled_leg_hpp
+#define quantlib_compiled_leg_hpp
+
+#include <ql/cashflows/duration.hpp>
+#include <ql/cashflow.hpp>
+#include <ql/interestrate.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/time/daycounter.hpp>
+#include <ql/utilities/null.hpp>
+
+namespace QuantLib {
+
+    class Coupon;
+    class YieldTermStructure;
+
+    namespace detail {
+
+        struct DiscountedSums {
+            Real npv = 0.0, bps = 0.0, nonSensNPV = 0.0;
+        };
+
+        /* Sums of amounts and accrual weights (null for cash flows
+           which are not coupons) discounted at the given times; if
+           no weights are passed, only the NPV is calculated.  When
+           the times are sorted, the discount factors are obtained
+           with a single batched query to the curve.  The last
+           argument is used as work space. */
+        DiscountedSums discountedSums(const YieldTermStructure& discountCurve,
+                                      const std::vector<Time>& times,
+                                      const std::vector<Real>& amounts,
+                                      const std::vector<Real>& weights,
+                                      std::vector<DiscountFactor>& discounts);
+
+    }
+
+    //! Leg data cached in contiguous arrays for fast discounting
+    /*! The payment and ex-coupon dates of the cash flows are
+        extracted once when the object is built; accrual weights
+        (nominal times accrual period) of the coupons are calculated
+        when first needed, and so are amounts, which are then cached
+        until any of the cash flows notifies a change.  Payment times are also cached and only recalculated
+        when a curve with a different reference date or day counter
+        is passed.  If the cash flows are sorted by date, discount
+        factors are obtained from the curve with a single batched
+        query.
+
+        The NPV and BPS methods return the same results as the
+        corresponding methods of the CashFlows class, without any
+        virtual call or dynamic cast on the cash flows on repeated
+        evaluations.  The same holds for durations, for which the
+        discounting times between cash flows are cached for the
+        last day counter and NPV date used.
+
+        \warning the leg is not expected to change after the object
+                 is built; cash flows should not be added or removed
+                 from it.
+    */
+    class CompiledLeg : public LazyObject {
+      public:
+        explicit CompiledLeg(Leg leg);
+        //! \name Inspectors
+        //@{
+        const Leg& leg() const { return leg_; }
+        Size size() const { return leg_.size(); }
+        const std::vector<Date>& dates() const { return dates_; }
+        Date startDate() const;
+        Date maturityDate() const;
+        //@}
+        //! \name Calculations
+        //@{
+        Real npv(const YieldTermStructure& discountCurve,
+                 bool includeSettlementDateFlows,
+                 Date settlementDate = Date(),
+                 Date npvDate = Date()) const;
+        Real bps(const YieldTermStructure& discountCurve,
+                 bool includeSettlementDateFlows,
+                 Date settlementDate = Date(),
+                 Date npvDate = Date()) const;
+        std::pair<Real, Real> npvbps(const YieldTermStructure& discountCurve,
+                                     bool includeSettlementDateFlows,
+                                     Date settlementDate = Date(),
+                                     Date npvDate = Date()) const;
+        Rate atmRate(const YieldTermStructure& discountCurve,
+                     bool includeSettlementDateFlows,
+                     Date settlementDate = Date(),
+                     Date npvDate = Date(),
+                     Real targetNpv = Null<Real>()) const;
+        Time duration(const InterestRate& yield,
+                      Duration::Type type,
+                      bool includeSettlementDateFlows,
+                      Date settlementDate = Date(),
+                      Date npvDate = Date()) const;
+        //@}
+      private:
+        void performCalculations() const override;
+        detail::DiscountedSums sums(const YieldTermStructure& discountCurve,
+                                    bool includeSettlementDateFlows,
+                                    Date settlementDate) const;
+        bool hasOccurred(Size i,
+                         bool includeSettlementDateFlows,
+                         const Date& settlementDate) const;
+        bool tradingExCoupon(Size i, const Date& settlementDate) const;
+        Real amount(Size i) const;
+        void updateWeights() const;
+        void updateTimes(const YieldTermStructure& discountCurve) const;
+        void updateStepwiseTimes(const DayCounter& dayCounter,
+                                 const Date& npvDate) const;
+        Time stepwiseTime(Size i,
+                          const DayCounter& dayCounter,
+                          const Date& npvDate,
+                          const Date& lastDate) const;
+        Real modifiedDuration(const InterestRate& yield,
+                              const Date& settlementDate) const;
+
+        Leg leg_;
+        std::vector<Date> dates_, exCouponDates_;
+        // null for cash flows which are not coupons
+        std::vector<ext::shared_ptr<Coupon> > coupons_;
+        Date startDate_, maturityDate_;
+        mutable std::vector<Real> weights_, amounts_;
+        mutable std::vector<Time> times_;
+        mutable Date timesReferenceDate_;
+        mutable DayCounter timesDayCounter_;
+        // cumulated discounting times for durations
+        mutable std::vector<Size> stepwiseFlows_;
+        mutable std::vector<Time> stepwiseTimes_;
+        mutable Date stepwiseNpvDate_;
+        mutable DayCounter stepwiseDayCounter_;
+        // work arrays
+        mutable std::vector<Size> flows_;
+        mutable std::vector<Time> aliveTimes_;
+        mutable std::vector<Real> aliveAmounts_, aliveWeights_;
+        mutable std::vector<DiscountFactor> discounts_;
+    };
+
+}
+
+#endif
@@ -74,7 +74,27 @@ namespace QuantLib {
 
                 Real compoundFactor = 1.0;
 
-                // already fixed part
+                // already fixed part; past fixings accruing over their full
+                // period are compounded in one go from the running products
+                // cached by the index (the last fixing of the coupon might
+                // accrue up to an unadjusted end date, so it is left out)
+                if (coupon_->canApplyTelescopicFormula() && n > 2) {
+                    Size m = std::lower_bound(fixingDates.begin(), fixingDates.begin() + n,
+                                              today) - fixingDates.begin();
+                    m = std::min<Size>(m, std::upper_bound(interestDates.begin() + 1,
+                                                           interestDates.begin() + n, date) -
+                                              (interestDates.begin() + 1));
+                    if (m > 1 && index->fixingCalendar().advance(fixingDates[0],
+                                                                 index->fixingDays(),
+                                                                 Days) == interestDates[0]) {
+                        Real factor = index->compoundFactor(fixingDates[0], fixingDates[m - 1], m);
+                        if (factor != Null<Real>()) {
+                            compoundFactor = factor;
+                            i = m;
+                        }
+                    }
+                }
+
                 while (i < n && fixingDates[i] < today) {
                     // rate must have been fixed
                     const Rate fixing = pastFixings[fixingDates[i]];
@@ -325,6 +325,36 @@ namespace QuantLib {
         return cumulatedLoss() + lossModel_->expectedTrancheLoss(d);
     }
 
+    std::vector<Real> Basket::expectedTrancheLosses(
+                            const Date& d,
+                            const std::vector<Real>& attachmentRatios,
+                            const std::vector<Real>& detachmentRatios) const {
+        QL_REQUIRE(attachmentRatios.size() == detachmentRatios.size(),
+                   "unmatched attachment and detachment sizes");
+        calculate();
+        // remaining amounts, as for the basket's own tranche
+        std::vector<Real> attachAmounts, detachAmounts;
+        for (Size i = 0; i < attachmentRatios.size(); i++) {
+            QL_REQUIRE(attachmentRatios[i] >= 0 &&
+                       attachmentRatios[i] <= detachmentRatios[i] &&
+                       detachmentRatios[i] <= 1,
+                       "invalid attachment/detachment ratio");
+            Real attachAmount = 0.0, detachAmount = 0.0;
+            for (Real notional : notionals_) {
+                attachAmount += notional * attachmentRatios[i];
+                detachAmount += notional * detachmentRatios[i];
+            }
+            attachAmounts.push_back(std::min(detachAmount, attachAmount +
+                std::max(0.0, evalDateSettledLoss_ - attachAmount)));
+            detachAmounts.push_back(detachAmount);
+        }
+        std::vector<Real> losses =
+            lossModel_->expectedTrancheLosses(d, attachAmounts, detachAmounts);
+        for (Real& loss : losses)
+            loss += cumulatedLoss();
+        return losses;
+    }
+
     std::vector<Real> Basket::splitVaRLevel(const Date& date, Real loss) const {
         calculate();
         return lossModel_->splitVaRLevel(date, loss);
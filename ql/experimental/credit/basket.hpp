@@ -228,6 +228,15 @@ namespace QuantLib {
         */
         //@{
         Real expectedTrancheLoss(const Date& d) const;
+        /*! Expected losses of the tranches with the given attachment and
+            detachment ratios on the basket pool; the loss model computes
+            them together, sharing the pool loss distribution. For the
+            basket's own ratios the result equals expectedTrancheLoss(d).
+        */
+        std::vector<Real> expectedTrancheLosses(
+            const Date& d,
+            const std::vector<Real>& attachmentRatios,
+            const std::vector<Real>& detachmentRatios) const;
         /*! The lossFraction is the fraction of losses expressed in 
             inception (no losses) tranche units (e.g. 'attach level'=0%, 
             'detach level'=100%)
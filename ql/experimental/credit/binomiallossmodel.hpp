@@ -89,7 +89,7 @@ namespace QuantLib {
             return copula_->integratedExpectedValueV(
                 [&](const std::vector<Real>& v1) {
                     return lossProbability(date, notionals, invProbs, v1);
-                });
+                }, true);
         }
         //! attainable loss points this model provides
         std::vector<Real> lossPoints(const Date&) const;
@@ -99,6 +99,10 @@ namespace QuantLib {
         Real percentile(const Date& d, Real percentile) const override;
         Real expectedShortfall(const Date& d, Real percentile) const override;
         Real expectedTrancheLoss(const Date& d) const override;
+        std::vector<Real> expectedTrancheLosses(
+            const Date& d,
+            const std::vector<Real>& attachAmounts,
+            const std::vector<Real>& detachAmounts) const override;
 
         // Model internal workings ----------------
         //! Average loss per credit.
@@ -108,6 +112,14 @@ namespace QuantLib {
             const std::vector<Real>& bsktNots,
             const std::vector<Probability>& uncondDefProbs, 
             const std::vector<Real>&) const;
+        //! Conditional losses of several tranches on one loss distribution
+        std::vector<Real> condTrancheLosses(const Date&,
+            const std::vector<Real>& lossVals,
+            const std::vector<Real>& bsktNots,
+            const std::vector<Probability>& uncondDefProbs,
+            const std::vector<Real>& attachAmounts,
+            const std::vector<Real>& detachAmounts,
+            const std::vector<Real>&) const;
         // expected as in time-value, not average, see literature
         std::vector<Real> expConditionalLgd(const Date& d,
                                             const std::vector<Real>& mktFactors) const
@@ -276,7 +288,7 @@ namespace QuantLib {
         Real aveLossFrct = copula_->integratedExpectedValue(
             [&](const std::vector<Real>& v1) {
                 return averageLoss(d, notionals, v1);
-            });
+            }, true);
 
         std::vector<Real> data;
         Size dataSize = basket_->remainingSize() + 1;
@@ -321,10 +333,55 @@ namespace QuantLib {
         return copula_->integratedExpectedValue(
             [&](const std::vector<Real>& v1) {
                 return condTrancheLoss(d, lossVals, notionals, invProbs, v1);
-            });
+            }, true);
     }
 
 
+    template< class LLM>
+    std::vector<Real> BinomialLossModel<LLM>::condTrancheLosses(
+        const Date& d, 
+        const std::vector<Real>& lossVals, 
+        const std::vector<Real>& bsktNots,
+        const std::vector<Real>& uncondDefProbsInv,
+        const std::vector<Real>& attachAmounts,
+        const std::vector<Real>& detachAmounts,
+        const std::vector<Real>& mkf) const {
+
+        std::vector<Real> condLProb = 
+            lossProbability(d, bsktNots, uncondDefProbsInv, mkf);
+        std::vector<Real> sumas(attachAmounts.size(), 0.);
+        for(Size k=0; k<attachAmounts.size(); k++) {
+            for(Size i=0; i<lossVals.size(); i++) { 
+                sumas[k] += condLProb[i] * 
+                    std::min(std::max(lossVals[i]
+                     - attachAmounts[k], 0.), detachAmounts[k] - attachAmounts[k]);
+            }
+        }
+        return sumas;
+    }
+
+    template< class LLM>
+    std::vector<Real> BinomialLossModel<LLM>::expectedTrancheLosses(
+        const Date& d,
+        const std::vector<Real>& attachAmounts,
+        const std::vector<Real>& detachAmounts) const {
+        QL_REQUIRE(attachAmounts.size() == detachAmounts.size(),
+                   "attachment and detachment sizes differ");
+        std::vector<Real> lossVals  = lossPoints(d);
+        std::vector<Real> notionals = basket_->remainingNotionals(d);
+        std::vector<Probability> invProbs = 
+            basket_->remainingProbabilities(d);
+        for(Size iName=0; iName<invProbs.size(); iName++)
+            invProbs[iName] = 
+                copula_->inverseCumulativeY(invProbs[iName], iName);
+
+        return copula_->integratedExpectedValueV(
+            [&](const std::vector<Real>& v1) {
+                return condTrancheLosses(d, lossVals, notionals, invProbs,
+                                         attachAmounts, detachAmounts, v1);
+            }, true);
+    }
+
     template< class LLM>
     std::map<Real, Probability> BinomialLossModel<LLM>::lossDistribution(const Date& d) const 
     {
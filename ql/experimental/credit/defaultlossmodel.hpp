@@ -67,6 +67,17 @@ namespace QuantLib {
         virtual Real expectedTrancheLoss(const Date& d) const {
             QL_FAIL("expectedTrancheLoss Not implemented for this model.");
         }
+        /*! Expected losses of several tranches on the same pool, given by
+            their remaining attachment and detachment amounts. Models whose
+            loss distribution does not depend on the tranche can compute
+            all of them in a single pass.
+        */
+        virtual std::vector<Real> expectedTrancheLosses(
+            const Date& d,
+            const std::vector<Real>& attachAmounts,
+            const std::vector<Real>& detachAmounts) const {
+            QL_FAIL("expectedTrancheLosses Not implemented for this model.");
+        }
         /*! Probability of the tranche losing the same or more than the 
             fractional amount given.
 
@@ -73,6 +73,19 @@ namespace QuantLib {
       Real expectedConditionalLossInvP(const std::vector<Real>& pDefDate,
                                        // const Date& date,
                                        const std::vector<Real>& mktFactor) const;
+      std::vector<Real> expectedConditionalLossesInvP(
+          const std::vector<Real>& invpDefDate,
+          const std::vector<Real>& mktFactor,
+          const std::vector<Real>& attachAmounts,
+          const std::vector<Real>& detachAmounts) const;
+      /*! Conditional loss density on the grid of loss units, given the
+          conditional default probabilities of the live names. Unattainable
+          losses are given a zero probability.
+      */
+      std::vector<Probability> conditionalLossDensity(
+          const std::vector<Probability>& condDefProb) const;
+      std::map<Real, Probability> attainableLosses(
+          const std::vector<Probability>& density) const;
     protected:
       void resetModel() override;
 
@@ -93,6 +106,10 @@ namespace QuantLib {
             makes it easier this way.
         */
       Real expectedTrancheLoss(const Date& date) const override;
+      std::vector<Real> expectedTrancheLosses(
+          const Date& date,
+          const std::vector<Real>& attachAmounts,
+          const std::vector<Real>& detachAmounts) const override;
       std::vector<Real> lossProbability(const Date& date) const;
       // REMEBER THIS HAS TO BE MOVED TO A DISTRIBUTION OBJECT.............
       std::map<Real, Probability> lossDistribution(const Date& d) const override;
@@ -109,6 +126,9 @@ namespace QuantLib {
         const Size nBuckets_;
         mutable std::vector<Real> wk_;
         mutable Real lossUnit_;
+        // highest loss, in loss units, and losses the pool can attain
+        mutable Size maxLossUnits_;
+        mutable std::vector<bool> attainable_;
         //! name to name factor. In the single factor copula:
         //    correl = beta * beta
         // When constructing through a single correlation number the factor is
@@ -171,7 +191,27 @@ namespace QuantLib {
         return copula_->integratedExpectedValue(
             [&](const std::vector<Real>& v1) {
                 return expectedConditionalLossInvP(invProb, v1);
-            });
+            }, true);
+    }
+
+    template<class CP>
+    inline std::vector<Real> RecursiveLossModel<CP>::expectedTrancheLosses(
+        const Date& date,
+        const std::vector<Real>& attachAmounts,
+        const std::vector<Real>& detachAmounts) const
+    {
+        QL_REQUIRE(attachAmounts.size() == detachAmounts.size(),
+                   "attachment and detachment sizes differ");
+        std::vector<Probability> uncDefProb =
+            basket_->remainingProbabilities(date);
+        std::vector<Real> invProb;
+        for(Size i=0; i<uncDefProb.size(); ++i)
+           invProb.push_back(copula_->inverseCumulativeY(uncDefProb[i], i));
+        return copula_->integratedExpectedValueV(
+            [&](const std::vector<Real>& v1) {
+                return expectedConditionalLossesInvP(invProb, v1,
+                    attachAmounts, detachAmounts);
+            }, true);
     }
 
     template<class CP>
@@ -182,7 +222,7 @@ namespace QuantLib {
         return copula_->integratedExpectedValueV(
             [&](const std::vector<Real>& v1) {
                 return conditionalLossProb(uncDefProb, v1);
-            });
+            }, true);
     }
 
     // -------------------------------------------------------------------
@@ -207,8 +247,19 @@ namespace QuantLib {
         lgds.erase(std::remove(lgds.begin(), lgds.end(), 0.), lgds.end());
         lossUnit_ = *(std::min_element(lgds.begin(), lgds.end()))
             / nBuckets_;
+        wk_.clear();
         for(Size i=0; i<remainingBsktSize_; ++i)
             wk_.push_back(std::floor(lgdsTmp[i]/lossUnit_ + .5));
+
+        maxLossUnits_ = 0;
+        attainable_.assign(1, true);
+        for(Size i=0; i<remainingBsktSize_; ++i) {
+            auto w = static_cast<Size>(wk_[i]);
+            attainable_.resize(maxLossUnits_ + w + 1, false);
+            for(Size l=maxLossUnits_+1; l-- > 0; )
+                if(attainable_[l]) attainable_[l+w] = true;
+            maxLossUnits_ += w;
+        }
     }
 
     // make it return a distribution object?
@@ -298,103 +349,78 @@ namespace QuantLib {
         return 0.;// well, we are in error....  fix: FAIL
     }
 
+    template<class CP>
+    std::vector<Probability> RecursiveLossModel<CP>::conditionalLossDensity(
+            const std::vector<Probability>& condDefProb) const
+    {
+        // eq. 10 p.68
+        // attainable losses distribution, recursive algorithm. The
+        // distribution is kept on the dense grid of loss units so that
+        // adding a name is a pair of contiguous (vectorizable) passes.
+        std::vector<Probability> density(maxLossUnits_+1, 0.),
+                                 next(maxLossUnits_+1);
+        // K=0
+        density[0] = 1.;
+        Size top = 0;
+        for(Size iName=0; iName<remainingBsktSize_; ++iName) {
+            const auto w = static_cast<Size>(wk_[iName]);
+            const Probability pDef = condDefProb[iName];
+            std::fill(next.begin(), next.begin() + top + w + 1, 0.);
+            // update prob if this name does not default
+            for(Size l=0; l<=top; ++l)
+                next[l] += density[l] * (1.-pDef);
+            // and if it does
+            for(Size l=0; l<=top; ++l)
+                next[l+w] += density[l] * pDef;
+            top += w;
+            density.swap(next);
+        }
+        return density;
+    }
+
+    template<class CP>
+    std::map<Real, Probability> RecursiveLossModel<CP>::attainableLosses(
+            const std::vector<Probability>& density) const
+    {
+        std::map<Real, Probability> distrib;
+        for(Size l=0; l<density.size(); ++l)
+            if(attainable_[l])
+                distrib.insert(distrib.end(),
+                    std::make_pair(static_cast<Real>(l), density[l]));
+        return distrib;
+    }
+
     template<class CP>
     std::map<Real, Probability> RecursiveLossModel<CP>::conditionalLossDistrib(
             const std::vector<Probability>& pDefDate, 
             //const Date& date,
             const std::vector<Real>& mktFactor) const 
     {
-        //eq. 10 p.68
-        //attainable losses distribution, recursive algorithm
-        const std::vector<Probability>& uncDefProb = pDefDate;// alias, remove
-
-        std::map<Real, Probability> pIndepDistrib;
-        ////////  K=0
-        pIndepDistrib.insert(std::make_pair(0., 1.));
-        for(Size iName=0; iName<remainingBsktSize_; ++iName) {
-            Probability pDef =
-                copula_->conditionalDefaultProbability(uncDefProb[iName], iName,
+        std::vector<Probability> condDefProb(remainingBsktSize_);
+        for(Size iName=0; iName<remainingBsktSize_; ++iName)
+            condDefProb[iName] =
+                copula_->conditionalDefaultProbability(pDefDate[iName], iName,
                                                 mktFactor);
-            ////// iterate on all possible losses in the distribution:
-            std::map<Real, Probability> pDistTemp;
-            auto distIt = pIndepDistrib.begin();
-            while(distIt != pIndepDistrib.end()) {
-              ///   update prob if this name does not default
-              auto matchIt = pDistTemp.find(distIt->first);
-              if (matchIt != pDistTemp.end()) {
-                  matchIt->second += distIt->second * (1. - pDef);
-                }else{
-                    pDistTemp.insert(std::make_pair(distIt->first,
-                        distIt->second * (1.-pDef)));
-                }
-              ////   and if it does
-                matchIt = pDistTemp.find(distIt->first + wk_[iName]);
-                if(matchIt != pDistTemp.end()) {
-                    matchIt->second += distIt->second * pDef;
-                }else{
-                    pDistTemp.insert(std::make_pair(
-                        distIt->first+wk_[iName], distIt->second * pDef));
-                }
-                ++distIt;
-            }
-           /////  copy back
-            pIndepDistrib = pDistTemp;
-        }
         /* Apply tranche limits now .... mind you this could be done outside*/
         ////  to be done....
-        return pIndepDistrib;
+        return attainableLosses(conditionalLossDensity(condDefProb));
     }
 
-    // twice?! rewrite one in terms of the other, this is a duplicate!
     template<class CP>
     std::map<Real, Probability> RecursiveLossModel<CP>::conditionalLossDistribInvP(
             const std::vector<Real>& invpDefDate, 
             //const Date& date,
             const std::vector<Real>& mktFactor) const 
     {
-        // eq. 10 p.68
-        // attainable losses distribution, recursive algorithm
-
-        std::map<Real, Probability> pIndepDistrib;
-        // K=0
-        pIndepDistrib.insert(std::make_pair(0., 1.));
-        for(Size iName=0; iName<remainingBsktSize_; ++iName) {
-            Probability pDef =
-                copula_->conditionalDefaultProbabilityInvP(invpDefDate[iName], 
+        std::vector<Probability> condDefProb(remainingBsktSize_);
+        for(Size iName=0; iName<remainingBsktSize_; ++iName)
+            condDefProb[iName] =
+                copula_->conditionalDefaultProbabilityInvP(invpDefDate[iName],
                     iName, mktFactor);
-
-            // iterate on all possible losses in the distribution:
-            std::map<Real, Probability> pDistTemp;
-            auto distIt = pIndepDistrib.begin();
-            while(distIt != pIndepDistrib.end()) {
-                // update prob if this name does not default
-                auto matchIt = pDistTemp.find(distIt->first);
-                if(matchIt != pDistTemp.end()) {
-                    matchIt->second += distIt->second * (1.-pDef);
-                }else{
-                    pDistTemp.insert(std::make_pair(distIt->first,
-                        distIt->second * (1.-pDef)));
-                }
-                // and if it does
-                matchIt = pDistTemp.find(distIt->first + wk_[iName]);
-                if(matchIt != pDistTemp.end()) {
-                    matchIt->second += distIt->second * pDef;
-                }else{
-                    pDistTemp.insert(std::make_pair(
-                        distIt->first+wk_[iName], distIt->second * pDef));
-                }
-                ++distIt;
-            }
-            // copy back
-            pIndepDistrib = pDistTemp;
-        }
         /* Apply tranche limits now .... mind you this could be done outside*/
-        return pIndepDistrib;
+        return attainableLosses(conditionalLossDensity(condDefProb));
     }
 
-
-
-
     /*
     Bugs here???. The max min on the tranche looks 
     wrong. It is better to have a tranche function since that way we can avoid 
@@ -434,35 +460,44 @@ namespace QuantLib {
     }
 
     template<class CP>
-    // again, I am duplicating code.
     Real RecursiveLossModel<CP>::expectedConditionalLossInvP(
                                  const std::vector<Real>& invPDefDate, 
                                  //const Date& date,
                                  const std::vector<Real>& mktFactor) const 
     {
-        std::map<Real, Probability> pIndepDistrib =
-            conditionalLossDistribInvP(invPDefDate, mktFactor);
+        return expectedConditionalLossesInvP(invPDefDate, mktFactor,
+            std::vector<Real>(1, attachAmount_),
+            std::vector<Real>(1, detachAmount_))[0];
+    }
+
+    /* The conditional distribution does not depend on the tranche, so all
+       the requested tranches are evaluated on a single recursion. */
+    template<class CP>
+    std::vector<Real> RecursiveLossModel<CP>::expectedConditionalLossesInvP(
+                                 const std::vector<Real>& invPDefDate,
+                                 const std::vector<Real>& mktFactor,
+                                 const std::vector<Real>& attachAmounts,
+                                 const std::vector<Real>& detachAmounts) const
+    {
+        std::vector<Probability> condDefProb(remainingBsktSize_);
+        for(Size iName=0; iName<remainingBsktSize_; ++iName)
+            condDefProb[iName] =
+                copula_->conditionalDefaultProbabilityInvP(invPDefDate[iName],
+                    iName, mktFactor);
+        std::vector<Probability> density = conditionalLossDensity(condDefProb);
 
         // get the expected value subject to the value of the market
         //   factor.
-        Real expLoss = 0.;
-        //---------------------------------------------------------------
-        /* This is the original (easy to read) loop which I have partially
-             unroll below to take profit of the fact that once we go over
-             the tranche top the loss amount is fixed:
-        */
-        auto distIt = pIndepDistrib.begin();
-
-        while(distIt != pIndepDistrib.end()) {
-            Real loss = distIt->first * lossUnit_;
-   //         loss = std::max(std::min(loss, detachAmount_)-attachAmount_, 0.);
-            loss = std::min(std::max(loss - attachAmount_, 0.), 
-                detachAmount_ - attachAmount_);
-            // MIN MAX BUGS ....???
-            expLoss += loss * distIt->second;
-            ++distIt;
+        std::vector<Real> expLosses(attachAmounts.size(), 0.);
+        for(Size l=0; l<density.size(); ++l) {
+            if(!attainable_[l]) continue;
+            Real loss = l * lossUnit_;
+            for(Size k=0; k<attachAmounts.size(); ++k)
+                expLosses[k] += density[l] *
+                    std::min(std::max(loss - attachAmounts[k], 0.),
+                             detachAmounts[k] - attachAmounts[k]);
         }
-        return expLoss ;
+        return expLosses;
     }
 
     template<class CP>
@@ -396,7 +396,7 @@ namespace QuantLib {
         return copula_->integratedExpectedValue(
             [&](const std::vector<Real>& v1) {
                 return CumulantGeneratingCond(invUncondProbs, s, v1);
-            });
+            }, true);
     }
 
     template<class CP>
@@ -412,7 +412,7 @@ namespace QuantLib {
        return copula_->integratedExpectedValue(
            [&](const std::vector<Real>& v1) {
                return CumGen1stDerivativeCond(invUncondProbs, s, v1);
-           });
+           }, true);
     }
 
     template<class CP>
@@ -428,7 +428,7 @@ namespace QuantLib {
         return copula_->integratedExpectedValue(
            [&](const std::vector<Real>& v1) {
                return CumGen2ndDerivativeCond(invUncondProbs, s, v1);
-           });
+           }, true);
     }
 
     template<class CP>
@@ -444,7 +444,7 @@ namespace QuantLib {
         return copula_->integratedExpectedValue(
            [&](const std::vector<Real>& v1) {
                return CumGen3rdDerivativeCond(invUncondProbs, s, v1);
-           });
+           }, true);
     }
 
     template<class CP>
@@ -460,7 +460,7 @@ namespace QuantLib {
         return copula_->integratedExpectedValue(
            [&](const std::vector<Real>& v1) {
                return CumGen4thDerivativeCond(invUncondProbs, s, v1);
-           });
+           }, true);
     }
 
     template<class CP>
@@ -481,7 +481,7 @@ namespace QuantLib {
         return copula_->integratedExpectedValue(
            [&](const std::vector<Real>& v1) {
                return probOverLossCond(invUncondProbs, trancheLossFract, v1);
-           });
+           }, true);
     }
 
     template<class CP>
@@ -497,7 +497,7 @@ namespace QuantLib {
         return copula_->integratedExpectedValue(
            [&](const std::vector<Real>& v1) {
                return probOverLossPortfCond(invUncondProbs, loss, v1);
-           });
+           }, true);
     }
 
     template<class CP>
@@ -513,7 +513,7 @@ namespace QuantLib {
         return copula_->integratedExpectedValue(
            [&](const std::vector<Real>& v1) {
                return conditionalExpectedTrancheLoss(invUncondProbs, v1);
-           });
+           }, true);
     }
 
     template<class CP>
@@ -529,7 +529,7 @@ namespace QuantLib {
         return copula_->integratedExpectedValue(
            [&](const std::vector<Real>& v1) {
                return probDensityCond(invUncondProbs, loss, v1);
-           });
+           }, true);
     }
 
     template<class CP>
@@ -544,7 +544,7 @@ namespace QuantLib {
         return copula_->integratedExpectedValueV(
            [&](const std::vector<Real>& v1) {
                return splitLossCond(invUncondProbs, s, v1);
-           });
+           }, true);
     }
 
 
@@ -1349,7 +1349,7 @@ namespace QuantLib {
         return copula_->integratedExpectedValue(
             [&](const std::vector<Real>& v1) {
                 return expectedShortfallFullPortfolioCond(invUncondProbs, lossPerc, v1);
-            }) / (1.-percProb);
+            }, true) / (1.-percProb);
 
     /* test:?
         return std::inner_product(integrESFPartition.begin(), 
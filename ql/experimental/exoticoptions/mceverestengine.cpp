@@ -26,20 +26,35 @@ namespace QuantLib {
                                                    DiscountFactor discount)
     : notional_(notional), guarantee_(guarantee), discount_(discount) {}
 
-    Real EverestMultiPathPricer::operator()(const MultiPath& multiPath) const {
+    namespace {
+
+        // works on both MultiPath and MultiPathMatrix
+        template <class P>
+        Real minimumYield(const P& multiPath) {
+            Size n = multiPath.pathSize();
+            QL_REQUIRE(n>0, "the path cannot be empty");
+
+            Size numAssets = multiPath.assetNumber();
+            QL_REQUIRE(numAssets>0, "there must be some paths");
+
+            // We search the yield min
+            Real minYield = multiPath[0][n-1] / multiPath[0][0] - 1.0;
+            for (Size j=1; j<numAssets; ++j) {
+                Rate yield = multiPath[j][n-1] / multiPath[j][0] - 1.0;
+                minYield = std::min(minYield, yield);
+            }
+            return minYield;
+        }
 
-        Size n = multiPath.pathSize();
-        QL_REQUIRE(n>0, "the path cannot be empty");
+    }
 
-        Size numAssets = multiPath.assetNumber();
-        QL_REQUIRE(numAssets>0, "there must be some paths");
+    Real EverestMultiPathPricer::operator()(const MultiPath& multiPath) const {
+        Real minYield = minimumYield(multiPath);
+        return (1.0 + minYield + guarantee_) * notional_ * discount_;
+    }
 
-        // We search the yield min
-        Real minYield = multiPath[0].back() / multiPath[0].front() - 1.0;
-        for (Size j=1; j<numAssets; ++j) {
-            Rate yield = multiPath[j].back() / multiPath[j].front() - 1.0;
-            minYield = std::min(minYield, yield);
-        }
+    Real EverestMultiPathPricer::operator()(const MultiPathMatrix& multiPath) const {
+        Real minYield = minimumYield(multiPath);
         return (1.0 + minYield + guarantee_) * notional_ * discount_;
     }
 
@@ -35,13 +35,13 @@ namespace QuantLib {
 
     template <class RNG = PseudoRandom, class S = Statistics>
     class MCEverestEngine : public EverestOption::engine,
-                            public McSimulation<MultiVariate,RNG,S> {
+                            public McSimulation<MultiVariateMatrix,RNG,S> {
       public:
-        typedef typename McSimulation<MultiVariate,RNG,S>::path_generator_type
+        typedef typename McSimulation<MultiVariateMatrix,RNG,S>::path_generator_type
             path_generator_type;
-        typedef typename McSimulation<MultiVariate,RNG,S>::path_pricer_type
+        typedef typename McSimulation<MultiVariateMatrix,RNG,S>::path_pricer_type
             path_pricer_type;
-        typedef typename McSimulation<MultiVariate,RNG,S>::stats_type
+        typedef typename McSimulation<MultiVariateMatrix,RNG,S>::stats_type
             stats_type;
         MCEverestEngine(ext::shared_ptr<StochasticProcessArray>,
                         Size timeSteps,
@@ -54,7 +54,7 @@ namespace QuantLib {
                         BigNatural seed);
         void calculate() const override {
 
-            McSimulation<MultiVariate,RNG,S>::calculate(requiredTolerance_,
+            McSimulation<MultiVariateMatrix,RNG,S>::calculate(requiredTolerance_,
                                                         requiredSamples_,
                                                         maxSamples_);
             results_.value = this->mcModel_->sampleAccumulator().mean();
@@ -123,12 +123,14 @@ namespace QuantLib {
     };
 
 
-    class EverestMultiPathPricer : public PathPricer<MultiPath> {
+    class EverestMultiPathPricer : public PathPricer<MultiPath>,
+                                   public PathPricer<MultiPathMatrix> {
       public:
         explicit EverestMultiPathPricer(Real notional,
                                         Rate guarantee,
                                         DiscountFactor discount);
         Real operator()(const MultiPath& multiPath) const override;
+        Real operator()(const MultiPathMatrix& multiPath) const override;
 
       private:
         Real notional_;
@@ -150,7 +152,7 @@ namespace QuantLib {
         Real requiredTolerance,
         Size maxSamples,
         BigNatural seed)
-    : McSimulation<MultiVariate, RNG, S>(antitheticVariate, false),
+    : McSimulation<MultiVariateMatrix, RNG, S>(antitheticVariate, false),
       processes_(std::move(processes)), timeSteps_(timeSteps), timeStepsPerYear_(timeStepsPerYear),
       requiredSamples_(requiredSamples), maxSamples_(maxSamples),
       requiredTolerance_(requiredTolerance), brownianBridge_(brownianBridge), seed_(seed) {
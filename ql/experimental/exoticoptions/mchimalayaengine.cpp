@@ -27,37 +27,51 @@ namespace QuantLib {
                                                      DiscountFactor discount)
     : payoff_(std::move(payoff)), discount_(discount) {}
 
-    Real HimalayaMultiPathPricer::operator()(const MultiPath& multiPath)
-                                                                      const {
-        Size numAssets = multiPath.assetNumber();
-        Size numNodes = multiPath.pathSize();
-        QL_REQUIRE(numAssets > 0, "no asset given");
+    namespace {
+
+        // works on both MultiPath and MultiPathMatrix
+        template <class P>
+        Real averageBestPrice(const P& multiPath) {
+            Size numAssets = multiPath.assetNumber();
+            Size numNodes = multiPath.pathSize();
+            QL_REQUIRE(numAssets > 0, "no asset given");
 
-        std::vector<bool> remainingAssets(numAssets, true);
-        Real averagePrice = 0.0;
-        Size fixings = numNodes-1;
-        for (Size i = 1; i < numNodes; i++) {
-            Real bestPrice = 0.0;
-            Real bestYield = QL_MIN_REAL;
-            // dummy assignement to avoid compiler warning
-            Size removeAsset = 0;
-            for (Size j = 0; j < numAssets; j++) {
-                if (remainingAssets[j]) {
-                    Real price = multiPath[j][i];
-                    Real yield = price/multiPath[j].front();
-                    if (yield >= bestYield) {
-                        bestPrice = price;
-                        bestYield = yield;
-                        removeAsset = j;
+            std::vector<bool> remainingAssets(numAssets, true);
+            Real averagePrice = 0.0;
+            Size fixings = numNodes-1;
+            for (Size i = 1; i < numNodes; i++) {
+                Real bestPrice = 0.0;
+                Real bestYield = QL_MIN_REAL;
+                // dummy assignement to avoid compiler warning
+                Size removeAsset = 0;
+                for (Size j = 0; j < numAssets; j++) {
+                    if (remainingAssets[j]) {
+                        Real price = multiPath[j][i];
+                        Real yield = price/multiPath[j][0];
+                        if (yield >= bestYield) {
+                            bestPrice = price;
+                            bestYield = yield;
+                            removeAsset = j;
+                        }
                     }
                 }
+                remainingAssets[removeAsset] = false;
+                averagePrice += bestPrice;
             }
-            remainingAssets[removeAsset] = false;
-            averagePrice += bestPrice;
+            return averagePrice / std::min(fixings, numAssets);
         }
-        averagePrice /= std::min(fixings, numAssets);
 
-        Real payoff = (*payoff_)(averagePrice);
+    }
+
+    Real HimalayaMultiPathPricer::operator()(const MultiPath& multiPath)
+                                                                      const {
+        Real payoff = (*payoff_)(averageBestPrice(multiPath));
+        return payoff * discount_;
+    }
+
+    Real HimalayaMultiPathPricer::operator()(const MultiPathMatrix& multiPath)
+                                                                      const {
+        Real payoff = (*payoff_)(averageBestPrice(multiPath));
         return payoff * discount_;
     }
 
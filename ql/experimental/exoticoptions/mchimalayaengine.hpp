@@ -35,13 +35,13 @@ namespace QuantLib {
 
     template <class RNG = PseudoRandom, class S = Statistics>
     class MCHimalayaEngine : public HimalayaOption::engine,
-                             public McSimulation<MultiVariate,RNG,S> {
+                             public McSimulation<MultiVariateMatrix,RNG,S> {
       public:
-        typedef typename McSimulation<MultiVariate,RNG,S>::path_generator_type
+        typedef typename McSimulation<MultiVariateMatrix,RNG,S>::path_generator_type
             path_generator_type;
-        typedef typename McSimulation<MultiVariate,RNG,S>::path_pricer_type
+        typedef typename McSimulation<MultiVariateMatrix,RNG,S>::path_pricer_type
             path_pricer_type;
-        typedef typename McSimulation<MultiVariate,RNG,S>::stats_type
+        typedef typename McSimulation<MultiVariateMatrix,RNG,S>::stats_type
             stats_type;
         MCHimalayaEngine(ext::shared_ptr<StochasticProcessArray>,
                          bool brownianBridge,
@@ -52,7 +52,7 @@ namespace QuantLib {
                          BigNatural seed);
 
         void calculate() const override {
-            McSimulation<MultiVariate,RNG,S>::calculate(requiredTolerance_,
+            McSimulation<MultiVariateMatrix,RNG,S>::calculate(requiredTolerance_,
                                                         requiredSamples_,
                                                         maxSamples_);
             results_.value = this->mcModel_->sampleAccumulator().mean();
@@ -112,10 +112,12 @@ namespace QuantLib {
     };
 
 
-    class HimalayaMultiPathPricer : public PathPricer<MultiPath> {
+    class HimalayaMultiPathPricer : public PathPricer<MultiPath>,
+                                    public PathPricer<MultiPathMatrix> {
       public:
         HimalayaMultiPathPricer(ext::shared_ptr<Payoff> payoff, DiscountFactor discount);
         Real operator()(const MultiPath& multiPath) const override;
+        Real operator()(const MultiPathMatrix& multiPath) const override;
 
       private:
         ext::shared_ptr<Payoff> payoff_;
@@ -133,7 +135,7 @@ namespace QuantLib {
         Real requiredTolerance,
         Size maxSamples,
         BigNatural seed)
-    : McSimulation<MultiVariate, RNG, S>(antitheticVariate, false),
+    : McSimulation<MultiVariateMatrix, RNG, S>(antitheticVariate, false),
       processes_(std::move(processes)), requiredSamples_(requiredSamples), maxSamples_(maxSamples),
       requiredTolerance_(requiredTolerance), brownianBridge_(brownianBridge), seed_(seed) {
         registerWith(processes_);
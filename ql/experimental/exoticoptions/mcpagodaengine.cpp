@@ -25,23 +25,35 @@ namespace QuantLib {
                                                  DiscountFactor discount)
     : discount_(discount), roof_(roof), fraction_(fraction) {}
 
-    Real PagodaMultiPathPricer::operator()(const MultiPath& multiPath) const {
-
-        Size numAssets = multiPath.assetNumber();
-        Size numSteps = multiPath.pathSize();
-
-        Real averagePerformance = 0.0;
-        for (Size i = 1; i < numSteps; i++) {
-            for (Size j = 0; j < numAssets; j++) {
-                averagePerformance +=
-                    multiPath[j].front() *
-                    (multiPath[j][i]/multiPath[j][i-1] - 1.0);
+    namespace {
+
+        // works on both MultiPath and MultiPathMatrix
+        template <class P>
+        Real averagePerformance(const P& multiPath) {
+            Size numAssets = multiPath.assetNumber();
+            Size numSteps = multiPath.pathSize();
+
+            Real performance = 0.0;
+            for (Size i = 1; i < numSteps; i++) {
+                for (Size j = 0; j < numAssets; j++) {
+                    performance +=
+                        multiPath[j][0] *
+                        (multiPath[j][i]/multiPath[j][i-1] - 1.0);
+                }
             }
+            return performance / numAssets;
         }
-        averagePerformance /= numAssets;
 
+    }
+
+    Real PagodaMultiPathPricer::operator()(const MultiPath& multiPath) const {
+        return discount_ * fraction_
+            * std::max<Real>(0.0, std::min(roof_, averagePerformance(multiPath)));
+    }
+
+    Real PagodaMultiPathPricer::operator()(const MultiPathMatrix& multiPath) const {
         return discount_ * fraction_
-            * std::max<Real>(0.0, std::min(roof_, averagePerformance));
+            * std::max<Real>(0.0, std::min(roof_, averagePerformance(multiPath)));
     }
 
 }
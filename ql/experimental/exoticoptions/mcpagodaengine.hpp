@@ -36,13 +36,13 @@ namespace QuantLib {
     //! Pricing engine for pagoda options using Monte Carlo simulation
     template <class RNG = PseudoRandom, class S = Statistics>
     class MCPagodaEngine : public PagodaOption::engine,
-                           public McSimulation<MultiVariate,RNG,S> {
+                           public McSimulation<MultiVariateMatrix,RNG,S> {
       public:
-        typedef typename McSimulation<MultiVariate,RNG,S>::path_generator_type
+        typedef typename McSimulation<MultiVariateMatrix,RNG,S>::path_generator_type
             path_generator_type;
-        typedef typename McSimulation<MultiVariate,RNG,S>::path_pricer_type
+        typedef typename McSimulation<MultiVariateMatrix,RNG,S>::path_pricer_type
             path_pricer_type;
-        typedef typename McSimulation<MultiVariate,RNG,S>::stats_type
+        typedef typename McSimulation<MultiVariateMatrix,RNG,S>::stats_type
             stats_type;
         // constructor
         MCPagodaEngine(ext::shared_ptr<StochasticProcessArray>,
@@ -53,7 +53,7 @@ namespace QuantLib {
                        Size maxSamples,
                        BigNatural seed);
         void calculate() const override {
-            McSimulation<MultiVariate,RNG,S>::calculate(requiredTolerance_,
+            McSimulation<MultiVariateMatrix,RNG,S>::calculate(requiredTolerance_,
                                                         requiredSamples_,
                                                         maxSamples_);
             results_.value = this->mcModel_->sampleAccumulator().mean();
@@ -112,11 +112,13 @@ namespace QuantLib {
     };
 
 
-    class PagodaMultiPathPricer : public PathPricer<MultiPath> {
+    class PagodaMultiPathPricer : public PathPricer<MultiPath>,
+                                  public PathPricer<MultiPathMatrix> {
       public:
         PagodaMultiPathPricer(Real roof, Real fraction,
                               DiscountFactor discount);
         Real operator()(const MultiPath& multiPath) const override;
+        Real operator()(const MultiPathMatrix& multiPath) const override;
 
       private:
         DiscountFactor discount_;
@@ -134,7 +136,7 @@ namespace QuantLib {
                                                   Real requiredTolerance,
                                                   Size maxSamples,
                                                   BigNatural seed)
-    : McSimulation<MultiVariate, RNG, S>(antitheticVariate, false),
+    : McSimulation<MultiVariateMatrix, RNG, S>(antitheticVariate, false),
       processes_(std::move(processes)), requiredSamples_(requiredSamples), maxSamples_(maxSamples),
       requiredTolerance_(requiredTolerance), brownianBridge_(brownianBridge), seed_(seed) {
         registerWith(processes_);
@@ -63,9 +63,12 @@ namespace QuantLib {
                 //Assign X=lb+(ub-lb)*random
                 x[j] = lX_[j] + bounds[j] * sample[j];
             }
-            //Evaluate point
-            values_.emplace_back(P.value(x), i);
         }
+        //Evaluate points
+        Array values;
+        P.evaluate(x_, values);
+        for (Size i = 0; i < M_; i++)
+            values_.emplace_back(values[i], i);
 
         //init intensity & randomWalk
         intensity_->init(this);
@@ -87,6 +90,9 @@ namespace QuantLib {
         //Variables for DE
         Array z(N_, 0.0);
         Size indexR1, indexR2;
+        //Variables for FA
+        std::vector<Array> zFA(Mfa_, Array(N_, 0.0));
+        Array valFA;
         decltype(distribution_)::param_type nParam(0, N_ - 1);
 
         //Set best value & position
@@ -175,27 +181,37 @@ namespace QuantLib {
                 //Loop over particles
                 for (Size i = 0; i < Mfa_; i++) {
                     Size index = values_[i].second;
-                    Array& x   = x_[index];
-                    Array& xI  = xI_[index];
-                    Array& xRW = xRW_[index];
+                    const Array& x   = x_[index];
+                    const Array& xI  = xI_[index];
+                    const Array& xRW = xRW_[index];
+                    Array& zI = zFA[i];
 
                     //Loop over dimensions
                     for (Size j = 0; j < N_; j++) {
                         //Update position
-                        z[j] = x[j] + xI[j] + xRW[j];
+                        zI[j] = x[j] + xI[j] + xRW[j];
                         //Enforce bounds on positions
-                        if (z[j] < lX_[j]) {
-                            z[j] = lX_[j];
+                        if (zI[j] < lX_[j]) {
+                            zI[j] = lX_[j];
                         }
-                        else if (z[j] > uX_[j]) {
-                            z[j] = uX_[j];
+                        else if (zI[j] > uX_[j]) {
+                            zI[j] = uX_[j];
                         }
                     }
-                    Real val = P.value(z);
+                }
+
+                //Evaluate the new positions; they are independent and
+                //can be evaluated concurrently by the problem executor
+                P.evaluate(zFA, valFA);
+
+                for (Size i = 0; i < Mfa_; i++) {
+                    Size index = values_[i].second;
+                    Real val = valFA[i];
                     if(!std::isnan(val))
 					{
 						//Accept new point
-                        x = z;
+                        Array& x = x_[index];
+                        x = zFA[i];
                         values_[index].first = val;
                         //mark best
                         if (val < bestValue) {
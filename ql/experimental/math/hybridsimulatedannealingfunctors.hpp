@@ -381,13 +381,18 @@ namespace QuantLib
             QL_REQUIRE(currTemp.size() == N_, "Incompatible input");
             QL_REQUIRE(steps.size() == N_, "Incompatible input");
 
+            // the offset points are independent and can be evaluated
+            // concurrently by the problem executor
+            std::vector<Array> offsetPoints(N_, currentPoint);
+            for (Size i = 0; i < N_; i++)
+                offsetPoints[i][i] += stepSize_;
+            Array offsetValues;
+            problem_->evaluate(offsetPoints, offsetValues);
+
             Array finiteDiffs(N_, 0.0);
             Real finiteDiffMax = 0.0;
-            Array ofssetPoint(currentPoint);
             for (Size i = 0; i < N_; i++) {
-                ofssetPoint[i] += stepSize_;
-                finiteDiffs[i] = bounded_[i] * std::abs((problem_->value(ofssetPoint) - currentValue) / stepSize_);
-                ofssetPoint[i] -= stepSize_;
+                finiteDiffs[i] = bounded_[i] * std::abs((offsetValues[i] - currentValue) / stepSize_);
                 if (finiteDiffs[i] < minSize_)
                     finiteDiffs[i] = minSize_;
                 if (finiteDiffs[i] > finiteDiffMax)
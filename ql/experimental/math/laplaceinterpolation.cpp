@@ -24,6 +24,7 @@
 #include <ql/experimental/math/laplaceinterpolation.hpp>
 #include <ql/math/matrix.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 #include <ql/math/matrixutilities/sparsematrix.hpp>
 #include <ql/methods/finitedifferences/meshers/fdm1dmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
@@ -111,7 +112,7 @@ for (auto const& m : map_)
         Real guessTmp = 0.0;
 
         struct f_A {
-            const SparseMatrix& g;
+            CsrMatrix g;
             explicit f_A(const SparseMatrix& g) : g(g) {}
             Array operator()(const Array& x) const { return prod(g, x); }
         };
@@ -81,6 +81,18 @@ namespace QuantLib {
             const std::vector<Real>& arg)>& f) const {
             QL_FAIL("No vector integration provided");
         }
+        /* Integrals of functions which are safe to call concurrently;
+        integrators may evaluate them at several points in parallel. By
+        default they are integrated serially. */
+        virtual Real integrateParallel(const std::function<Real (
+            const std::vector<Real>& arg)>& f) const {
+            return integrate(f);
+        }
+        virtual std::vector<Real> integrateVParallel(
+            const std::function<std::vector<Real>  (
+            const std::vector<Real>& arg)>& f) const {
+            return integrateV(f);
+        }
         virtual ~LMIntegration() = default;
     };
 
@@ -124,6 +136,15 @@ namespace QuantLib {
             const override {
             return GaussianQuadMultidimIntegrator::integrate<std::vector<Real>>(f);
         }
+        Real integrateParallel(
+            const std::function<Real(const std::vector<Real>& arg)>& f) const override {
+            return GaussianQuadMultidimIntegrator::parallelIntegrate<Real>(f);
+        }
+        std::vector<Real> integrateVParallel(
+            const std::function<std::vector<Real>(const std::vector<Real>& arg)>& f)
+            const override {
+            return GaussianQuadMultidimIntegrator::parallelIntegrate<std::vector<Real>>(f);
+        }
         ~IntegrationBase() override = default;
     };
 
@@ -576,24 +597,32 @@ namespace QuantLib {
         //@{
         /*! Integrates an arbitrary scalar function over the density domain(i.e.
          computes its expected value).
+         If \c parallel is true, the function must be safe to call
+         concurrently and the integration might evaluate it at several
+         points in parallel.
         */
         Real integratedExpectedValue(
-            const std::function<Real(const std::vector<Real>& v1)>& f) const {
+            const std::function<Real(const std::vector<Real>& v1)>& f,
+            bool parallel = false) const {
             // function composition: composes the integrand with the density 
             //   through a product.
-            return integration()->integrate(
-                [&](const std::vector<Real>& x){ return copula_.density(x) * f(x); });
+            auto g = [&](const std::vector<Real>& x){ return copula_.density(x) * f(x); };
+            return parallel ? integration()->integrateParallel(g)
+                            : integration()->integrate(g);
         }
         /*! Integrates an arbitrary vector function over the density domain(i.e.
          computes its expected value).
+         See above for the \c parallel argument.
         */
         std::vector<Real> integratedExpectedValueV(
             // const std::function<std::vector<Real>(
             const std::function<std::vector<Real>(
-                const std::vector<Real>& v1)>& f ) const {
+                const std::vector<Real>& v1)>& f,
+            bool parallel = false) const {
             detail::multiplyV M;
-            return integration()->integrateV(//see note in LMIntegrators base class
-                [&](const std::vector<Real>& x){ return M(copula_.density(x), f(x)); });
+            auto g = [&](const std::vector<Real>& x){ return M(copula_.density(x), f(x)); };
+            return parallel ? integration()->integrateVParallel(g)
+                            : integration()->integrateV(g);//see note in LMIntegrators base class
         }
     protected:
         // Integrable models must provide their integrator.
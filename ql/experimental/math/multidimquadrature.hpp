@@ -31,6 +31,7 @@
 
 #include <ql/math/integrals/gaussianquadratures.hpp>
 #include <ql/functional.hpp>
+#include <exception>
 
 namespace QuantLib {
 
@@ -59,8 +60,8 @@ namespace QuantLib {
                 //first one, we do not know the size of the vector returned by f
                 Integer i = order()-1;
                 std::vector<Real> term = f(x_[i]);// potential copy! @#$%^!!!
-                std::for_each(term.begin(), term.end(),
-                              [&](Real x) -> Real { return x * w_[i]; });
+                std::transform(term.begin(), term.end(), term.begin(),
+                               [&](Real x) -> Real { return x * w_[i]; });
                 std::vector<Real> sum = term;
            
                 for (i--; i >= 0; --i) {
@@ -72,6 +73,57 @@ namespace QuantLib {
                 }
                 return sum;
             }
+
+            /* One-dimensional versions evaluating the integrand at all
+               the nodes in parallel (when OpenMP is enabled). The
+               integrand must be safe to call concurrently. The terms are
+               added in the same order as in the serial versions, so that
+               the results are the same and don't depend on the number of
+               threads. */
+            Real parallelIntegrate(
+                const std::function<Real(const std::vector<Real>&)>& f) const {
+                std::vector<Real> terms = parallelTerms(f);
+                Real sum = 0.0;
+                for (Integer i=Integer(order())-1; i>=0; --i)
+                    sum += w_[i] * terms[i];
+                return sum;
+            }
+
+            std::vector<Real> parallelIntegrate(
+                const std::function<std::vector<Real>(const std::vector<Real>&)>& f) const {
+                const Integer n = order();
+                std::vector<std::vector<Real> > terms = parallelTerms(f);
+                std::vector<Real> sum(terms[n-1].size());
+                std::transform(terms[n-1].begin(), terms[n-1].end(),
+                               sum.begin(),
+                               [&](Real x) -> Real { return x * w_[n-1]; });
+                for (Integer i=n-2; i>=0; --i)
+                    std::transform(terms[i].begin(), terms[i].end(),
+                                   sum.begin(), sum.begin(),
+                                   [&](Real x, Real y) -> Real { return w_[i]*x + y; });
+                return sum;
+            }
+
+          private:
+            template <class T>
+            std::vector<T> parallelTerms(
+                const std::function<T(const std::vector<Real>&)>& f) const {
+                const Integer n = order();
+                std::vector<T> terms(n);
+                std::exception_ptr error;
+                #pragma omp parallel for
+                for (Integer i=0; i<n; ++i) {
+                    try {
+                        terms[i] = f(std::vector<Real>(1, x_[i]));
+                    } catch (...) {
+                        #pragma omp critical
+                        error = std::current_exception();
+                    }
+                }
+                if (error)
+                    std::rethrow_exception(error);
+                return terms;
+            }
         };
 
     public:
@@ -112,6 +164,20 @@ namespace QuantLib {
         RetType_T integrate(const std::function<RetType_T (
             const std::vector<Real>& v1)>& f) const;
 
+        //! Integrates a function which is safe to call concurrently
+        /*! With a single dimension, the nodes don't go through the
+            shared variable buffer and the integrand is evaluated at all
+            of them in parallel when OpenMP is enabled; the result is
+            the same as the one returned by integrate().
+        */
+        template<class RetType_T>
+        RetType_T parallelIntegrate(const std::function<RetType_T (
+            const std::vector<Real>& v1)>& f) const {
+            if (dimension_ == 1)
+                return integralV_.parallelIntegrate(f);
+            return integrate<RetType_T>(f);
+        }
+
     private:
         /* The maximum number of dimensions of the integration variable domain
             A higher than this number of dimension would presumably be 
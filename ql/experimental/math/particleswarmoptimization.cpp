@@ -82,10 +82,11 @@ namespace QuantLib {
                 //Assign V=(ub-lb)*2*random-(ub-lb) -> between (lb-ub) and (ub-lb)
                 v[j] = bounds[j] * (2.0*sample[2 * j + 1] - 1.0);
             }
-            //Evaluate X and assign as personal best
+            //Assign X as personal best
             pBX_.push_back(X_.back());
-            pBF_[i] = P.value(X_.back());
         }
+        //Evaluate X
+        P.evaluate(X_, pBF_);
 
         //init topology & inertia
         topology_->init(this);
@@ -114,6 +115,7 @@ namespace QuantLib {
         }
 
         //Run optimization
+        Array f;
         do {
             iteration++;
             iterationStat++;
@@ -130,7 +132,7 @@ namespace QuantLib {
             //Loop over particles
             for (Size i = 0; i < M_; i++) {
                 Array& x = X_[i];
-                Array& pB = pBX_[i];
+                const Array& pB = pBX_[i];
                 const Array& gB = gBX_[i];
                 Array& v = V_[i];
 
@@ -150,15 +152,20 @@ namespace QuantLib {
                         v[j] = 0.0;
                     }
                 }
-                //Evaluate x
-                Real f = P.value(x);
-                if (f < pBF_[i]) {
+            }
+
+            //Evaluate the new positions; they are independent and can
+            //be evaluated concurrently by the problem executor
+            P.evaluate(X_, f);
+
+            for (Size i = 0; i < M_; i++) {
+                if (f[i] < pBF_[i]) {
                     //Update personal best
-                    pBF_[i] = f;
-                    pB = x;
+                    pBF_[i] = f[i];
+                    pBX_[i] = X_[i];
                     //Check stationary condition
-                    if (f < bestValue) {
-                        bestValue = f;
+                    if (f[i] < bestValue) {
+                        bestValue = f[i];
                         bestPosition = i;
                         iterationStat = 0;
                     }
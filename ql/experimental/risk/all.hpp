@@ -2,5 +2,7 @@
 /* Add the files to be included into Makefile.am instead. */
 
 #include <ql/experimental/risk/creditriskplus.hpp>
+#include <ql/experimental/risk/scenarioengine.hpp>
 #include <ql/experimental/risk/sensitivityanalysis.hpp>
+#include <ql/experimental/risk/sensitivityengine.hpp>
 
@@ -0,0 +1,182 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/risk/scenarioengine.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/instrument.hpp>
+#include <exception>
+#if defined(_OPENMP) && defined(QL_ENABLE_SESSIONS)
+#include <omp.h>
+#endif
+#include <utility>
+
+namespace QuantLib {
+
+    namespace {
+
+        std::vector<Real> baseValues(const ScenarioPortfolio& portfolio) {
+            std::vector<Real> values(portfolio.quotes.size());
+            for (Size i=0; i<values.size(); ++i) {
+                QL_REQUIRE(portfolio.quotes[i]->isValid(),
+                           "invalid quote #" << i+1 << " in portfolio");
+                values[i] = portfolio.quotes[i]->value();
+            }
+            return values;
+        }
+
+        void restore(const ScenarioPortfolio& portfolio,
+                     const std::vector<Real>& values) {
+            for (Size i=0; i<values.size(); ++i)
+                portfolio.quotes[i]->setValue(values[i]);
+        }
+
+    }
+
+    ScenarioEngine::ScenarioEngine(PortfolioFactory factory,
+                                   std::vector<std::vector<Real> > scenarios)
+    : factory_(std::move(factory)), scenarios_(std::move(scenarios)) {
+        QL_REQUIRE(factory_, "no portfolio factory given");
+    }
+
+    void ScenarioEngine::evaluate(const ScenarioPortfolio& portfolio,
+                                  Size scenario,
+                                  Matrix& results) const {
+        for (Size j=0; j<portfolio.instruments.size(); ++j)
+            results[scenario][j] = portfolio.instruments[j]->NPV();
+    }
+
+    void ScenarioEngine::checkScenarios(Size nQuotes) const {
+        for (Size i=0; i<scenarios_.size(); ++i)
+            QL_REQUIRE(scenarios_[i].size() == nQuotes,
+                       "scenario #" << i+1 << " has " << scenarios_[i].size()
+                       << " shifts, " << nQuotes << " quotes required");
+    }
+
+    Matrix ScenarioEngine::calculate() const {
+
+        Size nScenarios = scenarios_.size();
+
+        #if defined(_OPENMP) && defined(QL_ENABLE_SESSIONS)
+
+        // Each thread builds its own copy of the market before the
+        // worksharing loop; no exception is allowed to leave the loop
+        // (or the single block below) since it would skip their
+        // implicit barriers.  Errors are stored and rethrown after
+        // the parallel region, and quotes are restored in any case.
+        int nThreads = omp_get_max_threads();
+        std::vector<ScenarioPortfolio> portfolios(nThreads);
+        std::vector<std::vector<Real> > bases(nThreads);
+        std::vector<std::exception_ptr> threadErrors(nThreads);
+        std::vector<std::exception_ptr> scenarioErrors(nScenarios);
+        std::exception_ptr setupError;
+        Matrix results;
+
+        #pragma omp parallel num_threads(nThreads)
+        {
+            int t = omp_get_thread_num();
+            try {
+                portfolios[t] = factory_();
+                bases[t] = baseValues(portfolios[t]);
+            } catch (...) {
+                threadErrors[t] = std::current_exception();
+            }
+
+            #pragma omp barrier
+
+            #pragma omp single
+            {
+                try {
+                    int used = omp_get_num_threads();
+                    for (int k=0; k<used; ++k) {
+                        if (threadErrors[k])
+                            std::rethrow_exception(threadErrors[k]);
+                    }
+                    Size nQuotes = portfolios[0].quotes.size();
+                    Size nInstruments = portfolios[0].instruments.size();
+                    for (int k=1; k<used; ++k)
+                        QL_REQUIRE(portfolios[k].quotes.size() == nQuotes &&
+                                   portfolios[k].instruments.size() == nInstruments,
+                                   "inconsistent portfolios built by factory");
+                    checkScenarios(nQuotes);
+                    results = Matrix(nScenarios, nInstruments, 0.0);
+                } catch (...) {
+                    setupError = std::current_exception();
+                }
+            }
+
+            if (!setupError) {
+                const ScenarioPortfolio& local = portfolios[t];
+                const std::vector<Real>& base = bases[t];
+                #pragma omp for schedule(static)
+                for (long i=0; i<static_cast<long>(nScenarios); ++i) {
+                    try {
+                        for (Size k=0; k<base.size(); ++k)
+                            local.quotes[k]->setValue(base[k] + scenarios_[i][k]);
+                        evaluate(local, i, results);
+                    } catch (...) {
+                        scenarioErrors[i] = std::current_exception();
+                    }
+                }
+            }
+
+            try {
+                if (bases[t].size() == portfolios[t].quotes.size())
+                    restore(portfolios[t], bases[t]);
+            } catch (...) {
+                if (!threadErrors[t])
+                    threadErrors[t] = std::current_exception();
+            }
+            // objects built in this thread's session are released there
+            portfolios[t] = ScenarioPortfolio();
+        }
+
+        if (setupError)
+            std::rethrow_exception(setupError);
+        for (const auto& e : scenarioErrors) {
+            if (e)
+                std::rethrow_exception(e);
+        }
+        for (const auto& e : threadErrors) {
+            if (e)
+                std::rethrow_exception(e);
+        }
+
+        #else
+
+        ScenarioPortfolio portfolio = factory_();
+        checkScenarios(portfolio.quotes.size());
+        Matrix results(nScenarios, portfolio.instruments.size(), 0.0);
+
+        std::vector<Real> base = baseValues(portfolio);
+        try {
+            for (Size i=0; i<nScenarios; ++i) {
+                for (Size k=0; k<base.size(); ++k)
+                    portfolio.quotes[k]->setValue(base[k] + scenarios_[i][k]);
+                evaluate(portfolio, i, results);
+            }
+        } catch (...) {
+            restore(portfolio, base);
+            throw;
+        }
+        restore(portfolio, base);
+
+        #endif
+
+        return results;
+    }
+
+}
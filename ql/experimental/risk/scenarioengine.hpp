@@ -0,0 +1,89 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file scenarioengine.hpp
+    \brief revaluation of a portfolio under a set of market scenarios
+*/
+
+#ifndef quantlib_scenario_engine_hpp
+#define quantlib_scenario_engine_hpp
+
+#include <ql/handle.hpp>
+#include <ql/math/matrix.hpp>
+#include <functional>
+#include <vector>
+
+namespace QuantLib {
+
+    class SimpleQuote;
+    class Instrument;
+
+    //! quotes and instruments on which scenarios are evaluated
+    struct ScenarioPortfolio {
+        std::vector<Handle<SimpleQuote> > quotes;
+        std::vector<ext::shared_ptr<Instrument> > instruments;
+    };
+
+    //! revaluation of a portfolio under a set of market scenarios
+    /*! Each scenario is a vector of additive shifts, one for each
+        quote of the portfolio; the engine sets the shifted quotes,
+        revalues all instruments and collects their NPVs in a
+        scenarios x instruments matrix.  Quotes are restored to their
+        base values afterwards.
+
+        Since SimpleQuote only notifies its observers when its value
+        actually changes, quotes with the same value in consecutive
+        scenarios don't cause any recalculation; ordering scenarios
+        so that they share as many values as possible reduces the
+        overall cost.
+
+        The portfolio is built by the passed factory.  When OpenMP is
+        enabled and QL_ENABLE_SESSIONS is defined, the factory is
+        called once per thread and the scenarios are split among
+        threads, each working on its own copy of the market.  In this
+        case, the factory must build objects which are not shared with
+        other threads, and must set the evaluation date and any other
+        per-session setting it relies upon (the Settings singleton is
+        local to each thread when sessions are enabled); if any
+        scenario fails, the other threads complete their share and
+        the error of the first failed scenario is rethrown afterwards.
+        Otherwise, the factory is called once and scenarios are
+        evaluated serially.
+    */
+    class ScenarioEngine {
+      public:
+        typedef std::function<ScenarioPortfolio()> PortfolioFactory;
+
+        ScenarioEngine(PortfolioFactory factory,
+                       std::vector<std::vector<Real> > scenarios);
+        //! number of scenarios
+        Size size() const { return scenarios_.size(); }
+        //! NPVs of the instruments (columns) under each scenario (rows)
+        Matrix calculate() const;
+
+      private:
+        void checkScenarios(Size nQuotes) const;
+        void evaluate(const ScenarioPortfolio& portfolio,
+                      Size scenario,
+                      Matrix& results) const;
+        PortfolioFactory factory_;
+        std::vector<std::vector<Real> > scenarios_;
+    };
+
+}
+
+#endif
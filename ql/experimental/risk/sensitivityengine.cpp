@@ -0,0 +1,204 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/risk/sensitivityengine.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/instrument.hpp>
+#include <exception>
+#if defined(_OPENMP) && defined(QL_ENABLE_SESSIONS)
+#include <omp.h>
+#endif
+#include <utility>
+
+namespace QuantLib {
+
+    BucketSensitivityEngine::BucketSensitivityEngine(
+                        std::vector<Handle<SimpleQuote> > quotes,
+                        std::vector<ext::shared_ptr<Instrument> > instruments,
+                        std::vector<Real> quantities,
+                        Real shift,
+                        SensitivityAnalysis type,
+                        bool oneSideSecondOrder)
+    : quotes_(std::move(quotes)), instruments_(std::move(instruments)),
+      quantities_(std::move(quantities)), shift_(shift), type_(type),
+      oneSideSecondOrder_(oneSideSecondOrder) {
+        checkInputs();
+    }
+
+    BucketSensitivityEngine::BucketSensitivityEngine(
+                        PortfolioFactory factory,
+                        std::vector<Real> quantities,
+                        Real shift,
+                        SensitivityAnalysis type,
+                        bool oneSideSecondOrder)
+    : factory_(std::move(factory)), quantities_(std::move(quantities)),
+      shift_(shift), type_(type), oneSideSecondOrder_(oneSideSecondOrder) {
+        QL_REQUIRE(factory_, "no portfolio factory given");
+        ScenarioPortfolio portfolio = factory_();
+        quotes_ = std::move(portfolio.quotes);
+        instruments_ = std::move(portfolio.instruments);
+        checkInputs();
+    }
+
+    void BucketSensitivityEngine::checkInputs() const {
+        QL_REQUIRE(!quotes_.empty(), "empty SimpleQuote vector");
+        QL_REQUIRE(shift_!=0.0, "zero shift not allowed");
+        QL_REQUIRE(quantities_.empty() || quantities_.size()==1 ||
+                   quantities_.size()==instruments_.size(),
+                   "dimension mismatch between instruments (" <<
+                   instruments_.size() << ") and quantities (" <<
+                   quantities_.size() << ")");
+    }
+
+    Real BucketSensitivityEngine::referenceNPV() const {
+        return aggregateNPV(instruments_, quantities_);
+    }
+
+    void BucketSensitivityEngine::calculate(const Callback& f,
+                                            Real referenceNpv) const {
+        calculate(0, quotes_.size(), f, referenceNpv);
+    }
+
+    void BucketSensitivityEngine::calculate(Size begin, Size end,
+                                            const Callback& f,
+                                            Real referenceNpv) const {
+        QL_REQUIRE(begin<=end && end<=quotes_.size(),
+                   "invalid quote range [" << begin << ", " << end <<
+                   ") for " << quotes_.size() << " quotes");
+        if (begin == end)
+            return;
+
+        if (instruments_.empty()) {
+            for (Size i=begin; i<end; ++i)
+                f(i, 0.0, 0.0);
+            return;
+        }
+
+        if (referenceNpv == Null<Real>())
+            referenceNpv = referenceNPV();
+
+        #if defined(_OPENMP) && defined(QL_ENABLE_SESSIONS)
+        if (factory_) {
+            calculateInParallel(begin, end, f, referenceNpv);
+            return;
+        }
+        #endif
+
+        for (Size i=begin; i<end; ++i) {
+            std::pair<Real, Real> result =
+                bucket(quotes_[i], instruments_, referenceNpv);
+            f(i, result.first, result.second);
+        }
+    }
+
+    void BucketSensitivityEngine::calculateInParallel(Size begin,
+                                                      Size end,
+                                                      const Callback& f,
+                                                      Real referenceNpv) const {
+        #if defined(_OPENMP) && defined(QL_ENABLE_SESSIONS)
+
+        // Each thread builds its own copy of the market and bumps a
+        // contiguous range of quotes on it; there is no worksharing
+        // construct, so errors can be caught inside the parallel
+        // region and rethrown after it.
+        int nThreads = omp_get_max_threads();
+        std::vector<std::exception_ptr> errors(nThreads);
+
+        #pragma omp parallel num_threads(nThreads)
+        {
+            int t = omp_get_thread_num();
+            Size used = omp_get_num_threads();
+            Size from = begin + (end-begin)*t/used,
+                 to = begin + (end-begin)*(t+1)/used;
+            try {
+                // objects built in this thread's session are released there
+                ScenarioPortfolio local = factory_();
+                QL_REQUIRE(local.quotes.size() == quotes_.size() &&
+                           local.instruments.size() == instruments_.size(),
+                           "inconsistent portfolios built by factory");
+                for (Size i=from; i<to; ++i) {
+                    std::pair<Real, Real> result =
+                        bucket(local.quotes[i], local.instruments, referenceNpv);
+                    #pragma omp critical(ql_bucket_sensitivity_callback)
+                    {
+                        try {
+                            f(i, result.first, result.second);
+                        } catch (...) {
+                            errors[t] = std::current_exception();
+                        }
+                    }
+                    if (errors[t])
+                        break;
+                }
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        }
+
+        for (const auto& e : errors) {
+            if (e)
+                std::rethrow_exception(e);
+        }
+
+        #else
+
+        QL_FAIL("parallel calculation requires OpenMP and sessions");
+
+        #endif
+    }
+
+    std::pair<Real, Real>
+    BucketSensitivityEngine::parallelShift(Real referenceNpv) const {
+        if (instruments_.empty())
+            return std::make_pair(0.0, 0.0);
+        if (referenceNpv == Null<Real>())
+            referenceNpv = referenceNPV();
+        return parallelAnalysis(quotes_, instruments_, quantities_,
+                                shift_, type_, referenceNpv);
+    }
+
+    std::pair<Real, Real>
+    BucketSensitivityEngine::bucket(
+                    const Handle<SimpleQuote>& quote,
+                    const std::vector<ext::shared_ptr<Instrument> >& instruments,
+                    Real referenceNpv) const {
+        if (type_ != OneSide || !oneSideSecondOrder_)
+            return bucketAnalysis(quote, instruments, quantities_,
+                                  shift_, type_, referenceNpv);
+
+        std::pair<Real, Real> result(0.0, 0.0);
+        if (!quote->isValid())
+            return result;
+        Real quoteValue = quote->value();
+
+        try {
+            quote->setValue(quoteValue+shift_);
+            Real npv1 = aggregateNPV(instruments, quantities_);
+            quote->setValue(quoteValue+2.0*shift_);
+            Real npv2 = aggregateNPV(instruments, quantities_);
+            result.first = (npv1-referenceNpv)/shift_;
+            result.second = (npv2-2.0*npv1+referenceNpv)/(shift_*shift_);
+            quote->setValue(quoteValue);
+        } catch (...) {
+            quote->setValue(quoteValue);
+            throw;
+        }
+
+        return result;
+    }
+
+}
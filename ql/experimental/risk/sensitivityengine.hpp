@@ -0,0 +1,128 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file sensitivityengine.hpp
+    \brief bucketed sensitivity engine with streamed results
+*/
+
+#ifndef quantlib_sensitivity_engine_hpp
+#define quantlib_sensitivity_engine_hpp
+
+#include <ql/experimental/risk/scenarioengine.hpp>
+#include <ql/experimental/risk/sensitivityanalysis.hpp>
+#include <ql/handle.hpp>
+#include <functional>
+
+namespace QuantLib {
+
+    //! bucketed sensitivity engine for a portfolio of instruments
+    /*! The quotes are tweaked one by one separately; the first and
+        second derivatives of the aggregated portfolio value with
+        respect to each of them are passed to a user-provided
+        callback as soon as they are available, so that no vector
+        of intermediate NPVs needs to be stored.
+
+        The reference NPV is calculated once per run and reused for
+        all the buckets; it can also be passed by the caller when it
+        is already known, e.g., to share the value returned by
+        referenceNPV() between a bucketed and a parallel analysis.
+        Instruments that don't depend on a bumped quote are not
+        notified and therefore not recalculated.
+
+        When the analysis is OneSide, the second derivative is
+        calculated as a forward difference if requested (at the
+        cost of an additional revaluation per quote) and is null
+        otherwise.
+
+        Empty quantities vector is considered as unit vector. The same
+        if the vector is of size one.
+
+        Bumped scenarios for different quotes are independent, but
+        the observer pattern isn't thread-safe.  When the engine is
+        built from a portfolio factory, OpenMP is enabled and
+        QL_ENABLE_SESSIONS is defined, the factory is called once per
+        thread and the quotes are split among threads, each bumping
+        its own copy of the market (quotes, curves and engines); the
+        same requirements as for ScenarioEngine apply to the factory.
+        The callback is then called from different threads, though
+        never concurrently, and not necessarily in quote order; if
+        any bucket fails, the other threads complete their share and
+        the first error is rethrown afterwards.  Otherwise, quotes
+        are bumped serially on the instruments passed to the engine
+        (or built once by the factory).
+    */
+    class BucketSensitivityEngine {
+      public:
+        /*! The callback receives the index of the bumped quote and
+            the corresponding first and second derivative. */
+        typedef std::function<void(Size, Real, Real)> Callback;
+        typedef ScenarioEngine::PortfolioFactory PortfolioFactory;
+
+        BucketSensitivityEngine(std::vector<Handle<SimpleQuote> > quotes,
+                                std::vector<ext::shared_ptr<Instrument> > instruments,
+                                std::vector<Real> quantities = {},
+                                Real shift = 0.0001,
+                                SensitivityAnalysis type = Centered,
+                                bool oneSideSecondOrder = false);
+        /*! The factory is called here to build the portfolio used
+            for serial calculations, and once per thread for parallel
+            ones (see above); all the portfolios it builds must have
+            the same quotes and instruments. */
+        BucketSensitivityEngine(PortfolioFactory factory,
+                                std::vector<Real> quantities = {},
+                                Real shift = 0.0001,
+                                SensitivityAnalysis type = Centered,
+                                bool oneSideSecondOrder = false);
+        //! \name Inspectors
+        //@{
+        Size size() const { return quotes_.size(); }
+        Real shift() const { return shift_; }
+        SensitivityAnalysis type() const { return type_; }
+        //@}
+        //! \name Calculations
+        //@{
+        //! portfolio value in the base scenario
+        Real referenceNPV() const;
+        //! bucketed analysis over all quotes
+        void calculate(const Callback& f,
+                       Real referenceNpv = Null<Real>()) const;
+        //! bucketed analysis over the quotes in [begin, end)
+        void calculate(Size begin, Size end, const Callback& f,
+                       Real referenceNpv = Null<Real>()) const;
+        //! parallel analysis, all quotes tweaked together
+        std::pair<Real, Real> parallelShift(Real referenceNpv = Null<Real>()) const;
+        //@}
+      private:
+        void checkInputs() const;
+        std::pair<Real, Real> bucket(
+                        const Handle<SimpleQuote>& quote,
+                        const std::vector<ext::shared_ptr<Instrument> >& instruments,
+                        Real referenceNpv) const;
+        void calculateInParallel(Size begin, Size end, const Callback& f,
+                                 Real referenceNpv) const;
+        PortfolioFactory factory_;
+        std::vector<Handle<SimpleQuote> > quotes_;
+        std::vector<ext::shared_ptr<Instrument> > instruments_;
+        std::vector<Real> quantities_;
+        Real shift_;
+        SensitivityAnalysis type_;
+        bool oneSideSecondOrder_;
+    };
+
+}
+
+#endif
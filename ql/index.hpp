@@ -107,6 +107,7 @@ namespace QuantLib {
             Real nullValue = Null<Real>();
             Real invalidValue = Null<Real>();
             Real duplicatedValue = Null<Real>();
+            Real storedValue = Null<Real>();
             while (dBegin != dEnd) {
                 bool validFixing = isValidFixingDate(*dBegin);
                 Real currentValue = h[*dBegin];
@@ -119,6 +120,7 @@ namespace QuantLib {
                         ++vBegin;
                     } else {
                         noDuplicatedFixing = false;
+                        storedValue = currentValue;
                         duplicatedDate = *(dBegin++);
                         duplicatedValue = *(vBegin++);
                     }
@@ -128,13 +130,13 @@ namespace QuantLib {
                     invalidValue = *(vBegin++);
                 }
             }
-            IndexManager::instance().setHistory(tag, h);
+            IndexManager::instance().setHistory(tag, std::move(h));
             QL_REQUIRE(noInvalidFixing, "At least one invalid fixing provided: "
                                             << invalidDate.weekday() << " " << invalidDate << ", "
                                             << invalidValue);
             QL_REQUIRE(noDuplicatedFixing, "At least one duplicated fixing provided: "
                                                << duplicatedDate << ", " << duplicatedValue
-                                               << " while " << h[duplicatedDate]
+                                               << " while " << storedValue
                                                << " value is already present");
         }
         //! clears all stored historical fixings
@@ -151,7 +153,7 @@ namespace QuantLib {
 
     inline Real Index::pastFixing(const Date& fixingDate) const {
         QL_REQUIRE(isValidFixingDate(fixingDate), fixingDate << " is not a valid fixing date");
-        return timeSeries()[fixingDate];
+        return IndexManager::instance().historicalFixing(name(), fixingDate);
     }
 
     inline void Index::update() {
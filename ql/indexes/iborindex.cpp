@@ -20,7 +20,9 @@
 */
 
 #include <ql/indexes/iborindex.hpp>
+#include <ql/indexes/indexmanager.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -80,7 +82,92 @@ namespace QuantLib {
                                    const DayCounter& dc,
                                    const Handle<YieldTermStructure>& h)
    : IborIndex(familyName, 1*Days, settlementDays, curr,
-               fixCal, Following, false, dc, h) {}
+               fixCal, Following, false, dc, h),
+     fixingProducts_(ext::make_shared<FixingProducts>()) {}
+
+    /* Running products of the stored fixings, split in runs of
+       consecutive fixing dates.  They are rebuilt lazily when the
+       IndexManager notifies a change in the fixings of the index. */
+    class OvernightIndex::FixingProducts : public Observer {
+      public:
+        void update() override { upToDate_ = false; }
+
+        Real compoundFactor(const OvernightIndex& index,
+                            const Date& first,
+                            const Date& last,
+                            Size n) {
+            ext::shared_ptr<Observable> notifier =
+                IndexManager::instance().notifier(index.name());
+            if (notifier != notifier_) {
+                // first call, or the history was cleared in the meantime
+                if (notifier_ != nullptr)
+                    unregisterWith(notifier_);
+                registerWith(notifier);
+                notifier_ = notifier;
+                upToDate_ = false;
+            }
+            if (!upToDate_) {
+                rebuild(index);
+                upToDate_ = true;
+            }
+
+            auto i = std::lower_bound(dates_.begin(), dates_.end(), first);
+            if (n == 0 || i == dates_.end() || *i != first)
+                return Null<Real>();
+            Size k0 = i - dates_.begin(), k1 = k0 + n - 1;
+            if (k1 >= dates_.size() || dates_[k1] != last || runs_[k1] != runs_[k0])
+                return Null<Real>();
+            return after_[k1] / before_[k0];
+        }
+
+      private:
+        void rebuild(const OvernightIndex& index) {
+            const TimeSeries<Real>& history =
+                IndexManager::instance().getHistory(index.name());
+            const Calendar& calendar = index.fixingCalendar();
+            const Integer fixingDays = static_cast<Integer>(index.fixingDays());
+
+            dates_.clear();
+            before_.clear();
+            after_.clear();
+            runs_.clear();
+
+            Size run = 0;
+            Real product = 1.0;
+            Date next;
+            for (const auto& fixing : history) {
+                if (fixing.second == Null<Real>()) {
+                    next = Date();
+                    continue;
+                }
+                if (fixing.first != next) {
+                    ++run;
+                    product = 1.0;
+                }
+                next = calendar.advance(fixing.first, 1, Days);
+                Time span = index.dayCounter().yearFraction(
+                    calendar.advance(fixing.first, fixingDays, Days),
+                    calendar.advance(next, fixingDays, Days));
+                dates_.push_back(fixing.first);
+                runs_.push_back(run);
+                before_.push_back(product);
+                product *= (1.0 + fixing.second * span);
+                after_.push_back(product);
+            }
+        }
+
+        ext::shared_ptr<Observable> notifier_;
+        bool upToDate_ = false;
+        std::vector<Date> dates_;
+        std::vector<Real> before_, after_;
+        std::vector<Size> runs_;
+    };
+
+    Real OvernightIndex::compoundFactor(const Date& first,
+                                        const Date& last,
+                                        Size n) const {
+        return fixingProducts_->compoundFactor(*this, first, last, n);
+    }
 
     ext::shared_ptr<IborIndex> OvernightIndex::clone(
                                const Handle<YieldTermStructure>& h) const {
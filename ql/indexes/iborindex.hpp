@@ -95,6 +95,26 @@ namespace QuantLib {
                        const Handle<YieldTermStructure>& h = {});
         //! returns a copy of itself linked to a different forwarding curve
         ext::shared_ptr<IborIndex> clone(const Handle<YieldTermStructure>& h) const override;
+        //! \name Compounded fixings
+        //@{
+        /*! Returns the compounded growth factor
+            \f[ \prod_i (1 + r_i \tau_i) \f]
+            of the \f$ n \f$ consecutive past fixings \f$ r_i \f$ from
+            \c first to \c last (both included), where \f$ \tau_i \f$ is
+            the accrual period between the value dates of successive
+            fixing dates.  Null<Real>() is returned if any of the
+            fixings is missing or if the fixing calendar does not have
+            exactly \f$ n \f$ fixing dates from \c first to \c last.
+
+            The running products of the stored fixings are cached and
+            rebuilt only when the fixings of the index change, so that
+            the call costs two lookups.
+        */
+        Real compoundFactor(const Date& first, const Date& last, Size n) const;
+        //@}
+      private:
+        class FixingProducts;
+        ext::shared_ptr<FixingProducts> fixingProducts_;
     };
 
 
@@ -18,23 +18,73 @@
 */
 
 #include <ql/indexes/indexmanager.hpp>
+#include <ql/utilities/binaryio.hpp>
 
 namespace QuantLib {
 
+    namespace {
+
+        const char historiesTag[9] = "QLFIXING";
+        const std::uint32_t historiesVersion = 1;
+
+    }
+
+    const TimeSeries<Real>& IndexManager::History::series() const {
+        if (!seriesValid_.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!seriesValid_.load(std::memory_order_relaxed)) {
+                TimeSeries<Real> s;
+                for (const auto& f : dense)
+                    s[f.first] = f.second;
+                series_ = std::move(s);
+                seriesValid_.store(true, std::memory_order_release);
+            }
+        }
+        return series_;
+    }
+
+    void IndexManager::History::set(TimeSeries<Real> s) {
+        if (s.empty()) {
+            dense = DenseDateMap<Real>();
+        } else {
+            Date first = s.firstDate();
+            std::vector<Real> values(s.lastDate() - first + 1, Null<Real>());
+            for (const auto& f : s)
+                values[f.first - first] = f.second;
+            dense = DenseDateMap<Real>(first, std::move(values));
+        }
+        series_ = std::move(s);
+        seriesValid_ = true;
+        notifier->notifyObservers();
+    }
+
+    void IndexManager::History::set(DenseDateMap<Real> d) {
+        dense = std::move(d);
+        series_ = TimeSeries<Real>();
+        seriesValid_ = false;
+        notifier->notifyObservers();
+    }
+
     bool IndexManager::hasHistory(const std::string& name) const {
         return data_.find(name) != data_.end();
     }
 
     const TimeSeries<Real>& IndexManager::getHistory(const std::string& name) const {
-        return data_[name].value();
+        return data_[name].series();
     }
 
     void IndexManager::setHistory(const std::string& name, TimeSeries<Real> history) {
-        data_[name] = std::move(history);
+        data_[name].set(std::move(history));
+    }
+
+    void IndexManager::setHistory(const std::string& name,
+                                  const Date& firstDate,
+                                  std::vector<Real> values) {
+        data_[name].set(DenseDateMap<Real>(firstDate, std::move(values)));
     }
 
     ext::shared_ptr<Observable> IndexManager::notifier(const std::string& name) const {
-        return data_[name];
+        return data_[name].notifier;
     }
 
     std::vector<std::string> IndexManager::histories() const {
@@ -52,7 +102,41 @@ namespace QuantLib {
     bool IndexManager::hasHistoricalFixing(const std::string& name, const Date& fixingDate) const {
         auto const& indexIter = data_.find(name);
         return (indexIter != data_.end()) &&
-               ((*indexIter).second.value()[fixingDate] != Null<Real>());
+               (indexIter->second.dense.value(fixingDate) != Null<Real>());
+    }
+
+    Real IndexManager::historicalFixing(const std::string& name, const Date& fixingDate) const {
+        auto indexIter = data_.find(name);
+        if (indexIter == data_.end())
+            return Null<Real>();
+        return indexIter->second.dense.value(fixingDate);
+    }
+
+    void IndexManager::save(std::ostream& out) const {
+        detail::writeBinaryHeader(out, historiesTag, historiesVersion);
+        detail::writeBinary(out, std::uint64_t(data_.size()));
+        for (const auto& i : data_) {
+            const DenseDateMap<Real>& dense = i.second.dense;
+            detail::writeBinaryString(out, i.first);
+            detail::writeBinary(
+                out, std::int64_t(dense.empty() ? 0 : dense.firstDate().serialNumber()));
+            detail::writeBinaryVector(out, dense.data());
+        }
+        QL_REQUIRE(out, "could not write fixing data");
+    }
+
+    void IndexManager::load(std::istream& in) {
+        detail::readBinaryHeader(in, historiesTag, historiesVersion);
+        auto n = detail::readBinary<std::uint64_t>(in);
+        for (std::uint64_t k = 0; k < n; ++k) {
+            std::string name = detail::readBinaryString(in);
+            auto first = detail::readBinary<std::int64_t>(in);
+            std::vector<Real> values = detail::readBinaryVector<Real>(in);
+            if (values.empty())
+                setHistory(name, TimeSeries<Real>());
+            else
+                setHistory(name, Date(Date::serial_type(first)), std::move(values));
+        }
     }
 
 }
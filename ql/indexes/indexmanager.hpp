@@ -24,11 +24,15 @@
 #ifndef quantlib_index_manager_hpp
 #define quantlib_index_manager_hpp
 
+#include <ql/patterns/observable.hpp>
 #include <ql/patterns/singleton.hpp>
 #include <ql/timeseries.hpp>
-#include <ql/utilities/observablevalue.hpp>
+#include <ql/utilities/densedatemap.hpp>
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <iosfwd>
+#include <mutex>
 
 namespace QuantLib {
 
@@ -47,6 +51,16 @@ namespace QuantLib {
         const TimeSeries<Real>& getHistory(const std::string& name) const;
         //! stores the historical fixings of the index
         void setHistory(const std::string& name, TimeSeries<Real> history);
+        //! stores the historical fixings of the index from a flat array
+        /*! The values are assigned to consecutive dates starting from
+            \c firstDate; null values mark missing fixings, e.g., on
+            holidays, and are not stored.  They are kept in the
+            contiguous form used for lookups; the TimeSeries returned
+            by getHistory() is only built when first requested.
+        */
+        void setHistory(const std::string& name,
+                        const Date& firstDate,
+                        std::vector<Real> values);
         //! observer notifying of changes in the index fixings
         ext::shared_ptr<Observable> notifier(const std::string& name) const;
         //! returns all names of the indexes for which fixings were stored
@@ -57,6 +71,27 @@ namespace QuantLib {
         void clearHistories();
         //! returns whether a specific historical fixing was stored for the index and date
         bool hasHistoricalFixing(const std::string& name, const Date& fixingDate) const;
+        //! returns the stored fixing for the index and date, or Null<Real>() if missing
+        /*! The lookup takes constant time, as it goes through a
+            contiguous date-indexed copy of the history which is
+            updated whenever the history is set.
+        */
+        Real historicalFixing(const std::string& name, const Date& fixingDate) const;
+        //! \name Persistence
+        //@{
+        //! writes all stored histories to a binary stream
+        /*! Each history is written as the flat array of its fixings
+            on consecutive dates.  The format depends on the size and
+            byte order of Real on the writing platform; null fixings
+            are not preserved.
+        */
+        void save(std::ostream& out) const;
+        //! reads histories written by save()
+        /*! The loaded histories replace any stored ones for the same
+            indexes; the fixings of other indexes are left untouched.
+        */
+        void load(std::istream& in);
+        //@}
 
       private:
         struct CaseInsensitiveCompare {
@@ -67,7 +102,23 @@ namespace QuantLib {
           }
         };
 
-        mutable std::map<std::string, ObservableValue<TimeSeries<Real>>, CaseInsensitiveCompare> data_;
+        /* The contiguous copy is always up to date and is only read
+           after being set, so that lookups can run concurrently.  The
+           TimeSeries might be built on request from a const method,
+           which is guarded so that concurrent readers don't race. */
+        struct History {
+            ext::shared_ptr<Observable> notifier = ext::make_shared<Observable>();
+            DenseDateMap<Real> dense;
+            const TimeSeries<Real>& series() const;
+            void set(TimeSeries<Real> series);
+            void set(DenseDateMap<Real> dense);
+          private:
+            mutable TimeSeries<Real> series_;
+            mutable std::atomic<bool> seriesValid_{true};
+            mutable std::mutex mutex_;
+        };
+
+        mutable std::map<std::string, History, CaseInsensitiveCompare> data_;
     };
 
 }
@@ -148,7 +148,10 @@ namespace QuantLib {
         engine_->reset();
         setupArguments(engine_->getArguments());
         engine_->getArguments()->validate();
-        engine_->calculate();
+        {
+            QL_INSTRUMENT_SCOPE("PricingEngine::calculate");
+            engine_->calculate();
+        }
         fetchResults(engine_->getResults());
     }
 
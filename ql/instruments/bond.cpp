@@ -137,6 +137,14 @@ namespace QuantLib {
         }
     }
 
+    const ext::shared_ptr<CompiledLeg>& Bond::compiledCashflows() const {
+        // derived classes add their cash flows after the base
+        // constructor ran, so they are compiled when first needed
+        if (!compiledCashflows_ || compiledCashflows_->leg() != cashflows_)
+            compiledCashflows_ = ext::make_shared<CompiledLeg>(cashflows_);
+        return compiledCashflows_;
+    }
+
     const ext::shared_ptr<CashFlow>& Bond::redemption() const {
         QL_REQUIRE(redemptions_.size() == 1,
                    "multiple redemption cash flows given");
@@ -299,6 +307,7 @@ namespace QuantLib {
 
         arguments->settlementDate = settlementDate();
         arguments->cashflows = cashflows_;
+        arguments->compiledCashflows = compiledCashflows();
         arguments->calendar = calendar_;
     }
 
@@ -33,6 +33,7 @@
 
 #include <ql/time/calendar.hpp>
 #include <ql/cashflow.hpp>
+#include <ql/cashflows/compiledleg.hpp>
 #include <ql/compounding.hpp>
 
 #include <vector>
@@ -119,6 +120,8 @@ namespace QuantLib {
 
         /*! \note returns all the cashflows, including the redemptions. */
         const Leg& cashflows() const;
+        /*! returns all the cashflows, cached for fast discounting */
+        const ext::shared_ptr<CompiledLeg>& compiledCashflows() const;
         /*! returns just the redemption flows (not interest payments) */
         const Leg& redemptions() const;
         /*! returns the redemption, if only one is defined */
@@ -304,12 +307,16 @@ namespace QuantLib {
 
         Date maturityDate_, issueDate_;
         mutable Real settlementValue_;
+      private:
+        mutable ext::shared_ptr<CompiledLeg> compiledCashflows_;
     };
 
     class Bond::arguments : public PricingEngine::arguments {
       public:
         Date settlementDate;
         Leg cashflows;
+        //! the cash flows cached for fast discounting, if available
+        ext::shared_ptr<CompiledLeg> compiledCashflows;
         Calendar calendar;
         void validate() const override;
     };
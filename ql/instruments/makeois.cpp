@@ -24,6 +24,7 @@
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/indexes/iborindex.hpp>
 #include <ql/time/schedule.hpp>
+#include <ql/time/schedulecache.hpp>
 
 namespace QuantLib {
 
@@ -98,21 +99,37 @@ namespace QuantLib {
             overnightRule = overnightRule_;
         }
 
-        Schedule fixedSchedule(startDate, endDate,
-                               Period(fixedPaymentFrequency),
-                               fixedCalendar_,
-                               fixedConvention_,
-                               fixedTerminationDateConvention_,
-                               fixedRule,
-                               fixedEndOfMonth);
-
-        Schedule overnightSchedule(startDate, endDate,
-                                   Period(overnightPaymentFrequency),
-                                   overnightCalendar_,
-                                   overnightConvention_,
-                                   overnightTerminationDateConvention_,
-                                   overnightRule,
-                                   overnightEndOfMonth);
+        Schedule fixedSchedule = useScheduleCache_ ?
+            *ScheduleCache::instance().schedule(startDate, endDate,
+                                                Period(fixedPaymentFrequency),
+                                                fixedCalendar_,
+                                                fixedConvention_,
+                                                fixedTerminationDateConvention_,
+                                                fixedRule,
+                                                fixedEndOfMonth) :
+            Schedule(startDate, endDate,
+                     Period(fixedPaymentFrequency),
+                     fixedCalendar_,
+                     fixedConvention_,
+                     fixedTerminationDateConvention_,
+                     fixedRule,
+                     fixedEndOfMonth);
+
+        Schedule overnightSchedule = useScheduleCache_ ?
+            *ScheduleCache::instance().schedule(startDate, endDate,
+                                                Period(overnightPaymentFrequency),
+                                                overnightCalendar_,
+                                                overnightConvention_,
+                                                overnightTerminationDateConvention_,
+                                                overnightRule,
+                                                overnightEndOfMonth) :
+            Schedule(startDate, endDate,
+                     Period(overnightPaymentFrequency),
+                     overnightCalendar_,
+                     overnightConvention_,
+                     overnightTerminationDateConvention_,
+                     overnightRule,
+                     overnightEndOfMonth);
 
         Rate usedFixedRate = fixedRate_;
         if (fixedRate_ == Null<Rate>()) {
@@ -267,6 +284,11 @@ namespace QuantLib {
         return *this;
     }
 
+    MakeOIS& MakeOIS::withScheduleCache(bool flag) {
+        useScheduleCache_ = flag;
+        return *this;
+    }
+
     MakeOIS& MakeOIS::withFixedLegDayCount(const DayCounter& dc) {
         fixedDayCount_ = dc;
         return *this;
@@ -94,6 +94,9 @@ namespace QuantLib {
 
         MakeOIS& withPricingEngine(
                               const ext::shared_ptr<PricingEngine>& engine);
+
+        //! takes the leg schedules from the global ScheduleCache
+        MakeOIS& withScheduleCache(bool flag = true);
       private:
         Period swapTenor_;
         ext::shared_ptr<OvernightIndex> overnightIndex_;
@@ -125,6 +128,7 @@ namespace QuantLib {
         DayCounter fixedDayCount_;
 
         ext::shared_ptr<PricingEngine> engine_;
+        bool useScheduleCache_ = false;
 
         bool telescopicValueDates_ = false;
         RateAveraging::Type averagingMethod_ = RateAveraging::Compound;
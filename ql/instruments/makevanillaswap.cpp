@@ -28,6 +28,7 @@
 #include <ql/time/daycounters/actual365fixed.hpp>
 #include <ql/indexes/iborindex.hpp>
 #include <ql/time/schedule.hpp>
+#include <ql/time/schedulecache.hpp>
 #include <ql/currencies/america.hpp>
 #include <ql/currencies/asia.hpp>
 #include <ql/currencies/europe.hpp>
@@ -117,19 +118,33 @@ namespace QuantLib {
                 QL_FAIL("unknown fixed leg default tenor for " << curr);
         }
 
-        Schedule fixedSchedule(startDate, endDate,
-                               fixedTenor, fixedCalendar_,
-                               fixedConvention_,
-                               fixedTerminationDateConvention_,
-                               fixedRule_, fixedEndOfMonth_,
-                               fixedFirstDate_, fixedNextToLastDate_);
-
-        Schedule floatSchedule(startDate, endDate,
-                               floatTenor_, floatCalendar_,
-                               floatConvention_,
-                               floatTerminationDateConvention_,
-                               floatRule_, floatEndOfMonth_,
-                               floatFirstDate_, floatNextToLastDate_);
+        Schedule fixedSchedule = useScheduleCache_ ?
+            *ScheduleCache::instance().schedule(startDate, endDate,
+                                                fixedTenor, fixedCalendar_,
+                                                fixedConvention_,
+                                                fixedTerminationDateConvention_,
+                                                fixedRule_, fixedEndOfMonth_,
+                                                fixedFirstDate_, fixedNextToLastDate_) :
+            Schedule(startDate, endDate,
+                     fixedTenor, fixedCalendar_,
+                     fixedConvention_,
+                     fixedTerminationDateConvention_,
+                     fixedRule_, fixedEndOfMonth_,
+                     fixedFirstDate_, fixedNextToLastDate_);
+
+        Schedule floatSchedule = useScheduleCache_ ?
+            *ScheduleCache::instance().schedule(startDate, endDate,
+                                                floatTenor_, floatCalendar_,
+                                                floatConvention_,
+                                                floatTerminationDateConvention_,
+                                                floatRule_, floatEndOfMonth_,
+                                                floatFirstDate_, floatNextToLastDate_) :
+            Schedule(startDate, endDate,
+                     floatTenor_, floatCalendar_,
+                     floatConvention_,
+                     floatTerminationDateConvention_,
+                     floatRule_, floatEndOfMonth_,
+                     floatFirstDate_, floatNextToLastDate_);
 
         DayCounter fixedDayCount;
         if (fixedDayCount_ != DayCounter())
@@ -362,4 +377,9 @@ namespace QuantLib {
         return *this;
     }
 
+    MakeVanillaSwap& MakeVanillaSwap::withScheduleCache(bool flag) {
+        useScheduleCache_ = flag;
+        return *this;
+    }
+
 }
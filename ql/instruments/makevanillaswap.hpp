@@ -85,6 +85,8 @@ namespace QuantLib {
                               const ext::shared_ptr<PricingEngine>& engine);
         MakeVanillaSwap& withIndexedCoupons(const ext::optional<bool>& b = true);
         MakeVanillaSwap& withAtParCoupons(bool b = true);
+        //! takes the leg schedules from the global ScheduleCache
+        MakeVanillaSwap& withScheduleCache(bool flag = true);
       private:
         Period swapTenor_;
         ext::shared_ptr<IborIndex> iborIndex_;
@@ -110,6 +112,7 @@ namespace QuantLib {
         DayCounter fixedDayCount_, floatDayCount_;
         ext::optional<bool> useIndexedCoupons_;
         ext::optional<BusinessDayConvention> paymentConvention_;
+        bool useScheduleCache_ = false;
 
         ext::shared_ptr<PricingEngine> engine_;
     };
@@ -90,6 +90,18 @@ namespace QuantLib {
 
         arguments->legs = legs_;
         arguments->payer = payer_;
+        arguments->compiledLegs = compiledLegs();
+    }
+
+    const std::vector<ext::shared_ptr<CompiledLeg> >& Swap::compiledLegs() const {
+        // derived classes might build their legs after the base
+        // constructor ran, so they are compiled when first needed
+        compiledLegs_.resize(legs_.size());
+        for (Size j=0; j<legs_.size(); ++j) {
+            if (!compiledLegs_[j] || compiledLegs_[j]->leg() != legs_[j])
+                compiledLegs_[j] = ext::make_shared<CompiledLeg>(legs_[j]);
+        }
+        return compiledLegs_;
     }
 
     void Swap::fetchResults(const PricingEngine::results* r) const {
@@ -28,6 +28,7 @@
 
 #include <ql/instrument.hpp>
 #include <ql/cashflow.hpp>
+#include <ql/cashflows/compiledleg.hpp>
 #include <iosfwd>
 
 namespace QuantLib {
@@ -136,6 +137,9 @@ namespace QuantLib {
         mutable std::vector<Real> legBPS_;
         mutable std::vector<DiscountFactor> startDiscounts_, endDiscounts_;
         mutable DiscountFactor npvDateDiscount_;
+      private:
+        const std::vector<ext::shared_ptr<CompiledLeg> >& compiledLegs() const;
+        mutable std::vector<ext::shared_ptr<CompiledLeg> > compiledLegs_;
     };
 
 
@@ -143,6 +147,8 @@ namespace QuantLib {
       public:
         std::vector<Leg> legs;
         std::vector<Real> payer;
+        //! the legs cached for fast discounting, if available
+        std::vector<ext::shared_ptr<CompiledLeg> > compiledLegs;
         void validate() const override;
     };
 
@@ -68,6 +68,21 @@ namespace QuantLib {
             virtual Real primitive(Real) const = 0;
             virtual Real derivative(Real) const = 0;
             virtual Real secondDerivative(Real) const = 0;
+            /*! These can be overridden by implementations that can
+                take advantage of a hint on the interval containing
+                the query; the hint is updated on return.
+            */
+            virtual Real hintedValue(Real x, Size&) const {
+                return value(x);
+            }
+            virtual Real hintedPrimitive(Real x, Size&) const {
+                return primitive(x);
+            }
+            virtual void values(const Real* x, Real* y, Size n) const {
+                Size hint = 0;
+                for (Size i=0; i<n; ++i)
+                    y[i] = hintedValue(x[i], hint);
+            }
         };
         ext::shared_ptr<Impl> impl_;
       public:
@@ -111,6 +126,19 @@ namespace QuantLib {
                 else
                     return std::upper_bound(xBegin_,xEnd_-1,x)-xBegin_-1;
             }
+            /*! returns the same as locate(x), but checks the interval
+                given by the hint and the next one before falling back
+                to a binary search; this makes monotonic sequences of
+                queries O(1) amortized.  The hint is updated on return.
+            */
+            Size locate(Real x, Size& hint) const {
+                const Size n = xEnd_-xBegin_;
+                for (Size i=hint; i<n-1 && i<=hint+1; ++i) {
+                    if (xBegin_[i] <= x && (i == n-2 || x < xBegin_[i+1]))
+                        return hint = i;
+                }
+                return hint = locate(x);
+            }
             I1 xBegin_, xEnd_;
             I2 yBegin_;
         };
@@ -122,6 +150,32 @@ namespace QuantLib {
             checkRange(x,allowExtrapolation);
             return impl_->value(x);
         }
+        /*! \name Sequential access
+
+            The overloads below take a caller-held hint on the interval
+            containing the query.  The hint should be initialized to 0
+            and passed again for the next query; when the queries are
+            sorted, successive calls don't need a binary search.
+        */
+        //@{
+        Real operator()(Real x, Size& hint,
+                        bool allowExtrapolation = false) const {
+            checkRange(x,allowExtrapolation);
+            return impl_->hintedValue(x, hint);
+        }
+        //! interpolated values y[i] at x[i], with i in [0, n)
+        void operator()(const Real* x, Real* y, Size n,
+                        bool allowExtrapolation = false) const {
+            for (Size i=0; i<n; ++i)
+                checkRange(x[i],allowExtrapolation);
+            impl_->values(x, y, n);
+        }
+        Real primitive(Real x, Size& hint,
+                       bool allowExtrapolation = false) const {
+            checkRange(x,allowExtrapolation);
+            return impl_->hintedPrimitive(x, hint);
+        }
+        //@}
         Real primitive(Real x, bool allowExtrapolation = false) const {
             checkRange(x,allowExtrapolation);
             return impl_->primitive(x);
@@ -94,6 +94,17 @@ namespace QuantLib {
                 else
                     return this->yBegin_[i+1];
             }
+            Real hintedValue(Real x, Size& hint) const override {
+                if (x <= this->xBegin_[0]
+                    || std::distance(this->xBegin_, this->xEnd_) == 1)
+                    return this->yBegin_[0];
+
+                Size i = this->locate(x, hint);
+                if (x == this->xBegin_[i])
+                    return this->yBegin_[i];
+                else
+                    return this->yBegin_[i+1];
+            }
             Real primitive(Real x) const override {
                 if (std::distance(this->xBegin_, this->xEnd_) == 1)
                     return (x - this->xBegin_[0]) * this->yBegin_[0];
@@ -102,6 +113,14 @@ namespace QuantLib {
                 Real dx = x-this->xBegin_[i];
                 return primitive_[i] + dx*this->yBegin_[i+1];
             }
+            Real hintedPrimitive(Real x, Size& hint) const override {
+                if (std::distance(this->xBegin_, this->xEnd_) == 1)
+                    return (x - this->xBegin_[0]) * this->yBegin_[0];
+
+                Size i = this->locate(x, hint);
+                Real dx = x-this->xBegin_[i];
+                return primitive_[i] + dx*this->yBegin_[i+1];
+            }
             Real derivative(Real) const override { return 0.0; }
             Real secondDerivative(Real) const override { return 0.0; }
 
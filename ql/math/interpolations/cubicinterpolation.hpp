@@ -760,6 +760,11 @@ namespace QuantLib {
                 Real dx_ = x-this->xBegin_[j];
                 return this->yBegin_[j] + dx_*(a_[j] + dx_*(b_[j] + dx_*c_[j]));
             }
+            Real hintedValue(Real x, Size& hint) const override {
+                Size j = this->locate(x, hint);
+                Real dx_ = x-this->xBegin_[j];
+                return this->yBegin_[j] + dx_*(a_[j] + dx_*(b_[j] + dx_*c_[j]));
+            }
             Real primitive(Real x) const override {
                 Size j = this->locate(x);
                 Real dx_ = x-this->xBegin_[j];
@@ -767,6 +772,13 @@ namespace QuantLib {
                     + dx_*(this->yBegin_[j] + dx_*(a_[j]/2.0
                     + dx_*(b_[j]/3.0 + dx_*c_[j]/4.0)));
             }
+            Real hintedPrimitive(Real x, Size& hint) const override {
+                Size j = this->locate(x, hint);
+                Real dx_ = x-this->xBegin_[j];
+                return primitiveConst_[j]
+                    + dx_*(this->yBegin_[j] + dx_*(a_[j]/2.0
+                    + dx_*(b_[j]/3.0 + dx_*c_[j]/4.0)));
+            }
             Real derivative(Real x) const override {
                 Size j = this->locate(x);
                 Real dx_ = x-this->xBegin_[j];
@@ -89,11 +89,23 @@ namespace QuantLib {
                 Size i = this->locate(x);
                 return this->yBegin_[i];
             }
+            Real hintedValue(Real x, Size& hint) const override {
+                if (x >= this->xBegin_[n_-1])
+                    return this->yBegin_[n_-1];
+
+                Size i = this->locate(x, hint);
+                return this->yBegin_[i];
+            }
             Real primitive(Real x) const override {
                 Size i = this->locate(x);
                 Real dx = x-this->xBegin_[i];
                 return primitive_[i] + dx*this->yBegin_[i];
             }
+            Real hintedPrimitive(Real x, Size& hint) const override {
+                Size i = this->locate(x, hint);
+                Real dx = x-this->xBegin_[i];
+                return primitive_[i] + dx*this->yBegin_[i];
+            }
             Real derivative(Real) const override { return 0.0; }
             Real secondDerivative(Real) const override { return 0.0; }
 
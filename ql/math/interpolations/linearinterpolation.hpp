@@ -89,12 +89,22 @@ namespace QuantLib {
                 Size i = this->locate(x);
                 return this->yBegin_[i] + (x-this->xBegin_[i])*s_[i];
             }
+            Real hintedValue(Real x, Size& hint) const override {
+                Size i = this->locate(x, hint);
+                return this->yBegin_[i] + (x-this->xBegin_[i])*s_[i];
+            }
             Real primitive(Real x) const override {
                 Size i = this->locate(x);
                 Real dx = x-this->xBegin_[i];
                 return primitiveConst_[i] +
                     dx*(this->yBegin_[i] + 0.5*dx*s_[i]);
             }
+            Real hintedPrimitive(Real x, Size& hint) const override {
+                Size i = this->locate(x, hint);
+                Real dx = x-this->xBegin_[i];
+                return primitiveConst_[i] +
+                    dx*(this->yBegin_[i] + 0.5*dx*s_[i]);
+            }
             Real derivative(Real x) const override {
                 Size i = this->locate(x);
                 return s_[i];
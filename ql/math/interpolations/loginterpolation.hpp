@@ -377,6 +377,9 @@ namespace QuantLib {
                 interpolation_.update();
             }
             Real value(Real x) const override { return std::exp(interpolation_(x, true)); }
+            Real hintedValue(Real x, Size& hint) const override {
+                return std::exp(interpolation_(x, hint, true));
+            }
             Real primitive(Real) const override {
                 QL_FAIL("LogInterpolation primitive not implemented");
             }
@@ -39,8 +39,199 @@
 #pragma warning(pop)
 #endif
 
+#if defined(QL_USE_CBLAS)
+#include <cblas.h>
+#include <type_traits>
+#endif
+
 namespace QuantLib {
 
+    namespace {
+
+        /* Block sizes for the matrix product: a panel of kBlock rows
+           and jBlock columns of the right operand (256 Kb in double
+           precision) is reused for all the rows of the left one while
+           it sits in the L2 cache, and the corresponding segments of
+           the result rows stay in L1.  Within a panel, the innermost
+           loops run over contiguous rows and are vectorized by the
+           compiler.
+        */
+        const Size jBlock = 256;
+        const Size kBlock = 128;
+        const Size transposeBlock = 32;
+
+        #if defined(QL_USE_CBLAS)
+        static_assert(std::is_same<Real, double>::value,
+                      "the CBLAS interface can only be used when Real is double");
+        #endif
+
+        /* Adds the contributions of columns [k0,k1) of a and rows
+           [k0,k1) of b to columns [j0,j1) of the result.  Four rows
+           are processed at a time so that each row of b is loaded
+           once for all of them.  Each element of the result still
+           accumulates its terms in increasing order of k, so that
+           the result is the same as that of the textbook loop.
+        */
+        void multiplyPanel(const Real* a, const Real* b, Real* c,
+                           Size rows, Size inner, Size columns,
+                           Size k0, Size k1, Size j0, Size j1) {
+            Size n = j1 - j0;
+            Size i = 0;
+            for (; i+4 <= rows; i += 4) {
+                Real* c0 = c + i*columns + j0;
+                Real* c1 = c0 + columns;
+                Real* c2 = c1 + columns;
+                Real* c3 = c2 + columns;
+                const Real* a0 = a + i*inner;
+                const Real* a1 = a0 + inner;
+                const Real* a2 = a1 + inner;
+                const Real* a3 = a2 + inner;
+                for (Size k=k0; k<k1; ++k) {
+                    const Real* bk = b + k*columns + j0;
+                    Real x0 = a0[k], x1 = a1[k], x2 = a2[k], x3 = a3[k];
+                    for (Size j=0; j<n; ++j) {
+                        Real y = bk[j];
+                        c0[j] += x0*y;
+                        c1[j] += x1*y;
+                        c2[j] += x2*y;
+                        c3[j] += x3*y;
+                    }
+                }
+            }
+            for (; i<rows; ++i) {
+                Real* ci = c + i*columns + j0;
+                const Real* ai = a + i*inner;
+                for (Size k=k0; k<k1; ++k) {
+                    const Real* bk = b + k*columns + j0;
+                    Real x = ai[k];
+                    for (Size j=0; j<n; ++j)
+                        ci[j] += x*bk[j];
+                }
+            }
+        }
+
+    }
+
+    Array operator*(const Array& v, const Matrix& m) {
+        QL_REQUIRE(v.size() == m.rows(),
+                   "vectors and matrices with different sizes ("
+                   << v.size() << ", " << m.rows() << "x" << m.columns() <<
+                   ") cannot be multiplied");
+        Array result(m.columns(), 0.0);
+        if (m.empty())
+            return result;
+        #if defined(QL_USE_CBLAS)
+        cblas_dgemv(CblasRowMajor, CblasTrans,
+                    int(m.rows()), int(m.columns()), 1.0, m.begin(), int(m.columns()),
+                    v.begin(), 1, 0.0, result.begin(), 1);
+        #else
+        // accumulate the rows of m weighted by v, which runs over
+        // contiguous memory instead of striding along the columns
+        Real* r = result.begin();
+        Size n = m.columns();
+        for (Size i=0; i<m.rows(); ++i) {
+            const Real* mi = m.row_begin(i);
+            Real x = v[i];
+            for (Size j=0; j<n; ++j)
+                r[j] += x*mi[j];
+        }
+        #endif
+        return result;
+    }
+
+    Array operator*(const Matrix& m, const Array& v) {
+        QL_REQUIRE(v.size() == m.columns(),
+                   "vectors and matrices with different sizes ("
+                   << v.size() << ", " << m.rows() << "x" << m.columns() <<
+                   ") cannot be multiplied");
+        Array result(m.rows(), 0.0);
+        if (m.empty())
+            return result;
+        #if defined(QL_USE_CBLAS)
+        cblas_dgemv(CblasRowMajor, CblasNoTrans,
+                    int(m.rows()), int(m.columns()), 1.0, m.begin(), int(m.columns()),
+                    v.begin(), 1, 0.0, result.begin(), 1);
+        #else
+        // four rows at a time, so that v is read once for all of them
+        const Real* x = v.begin();
+        Size n = m.columns();
+        Size i = 0;
+        for (; i+4 <= m.rows(); i += 4) {
+            const Real* m0 = m.row_begin(i);
+            const Real* m1 = m0 + n;
+            const Real* m2 = m1 + n;
+            const Real* m3 = m2 + n;
+            Real s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+            for (Size j=0; j<n; ++j) {
+                s0 += m0[j]*x[j];
+                s1 += m1[j]*x[j];
+                s2 += m2[j]*x[j];
+                s3 += m3[j]*x[j];
+            }
+            result[i] = s0;
+            result[i+1] = s1;
+            result[i+2] = s2;
+            result[i+3] = s3;
+        }
+        for (; i<m.rows(); ++i) {
+            const Real* mi = m.row_begin(i);
+            Real s = 0.0;
+            for (Size j=0; j<n; ++j)
+                s += mi[j]*x[j];
+            result[i] = s;
+        }
+        #endif
+        return result;
+    }
+
+    Matrix operator*(const Matrix& m1, const Matrix& m2) {
+        QL_REQUIRE(m1.columns() == m2.rows(),
+                   "matrices with different sizes (" <<
+                   m1.rows() << "x" << m1.columns() << ", " <<
+                   m2.rows() << "x" << m2.columns() << ") cannot be "
+                   "multiplied");
+        Matrix result(m1.rows(), m2.columns(), 0.0);
+        if (result.empty() || m1.columns() == 0)
+            return result;
+        #if defined(QL_USE_CBLAS)
+        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+                    int(m1.rows()), int(m2.columns()), int(m1.columns()),
+                    1.0, m1.begin(), int(m1.columns()), m2.begin(), int(m2.columns()),
+                    0.0, result.begin(), int(result.columns()));
+        #else
+        Size rows = m1.rows(), inner = m1.columns(), columns = m2.columns();
+        for (Size j0=0; j0<columns; j0+=jBlock) {
+            Size j1 = std::min(j0+jBlock, columns);
+            for (Size k0=0; k0<inner; k0+=kBlock) {
+                Size k1 = std::min(k0+kBlock, inner);
+                multiplyPanel(m1.begin(), m2.begin(), result.begin(),
+                              rows, inner, columns, k0, k1, j0, j1);
+            }
+        }
+        #endif
+        return result;
+    }
+
+    Matrix transpose(const Matrix& m) {
+        Matrix result(m.columns(), m.rows());
+        // copy square tiles, so that both the rows being read and the
+        // ones being written stay in cache
+        Size rows = m.rows(), columns = m.columns();
+        const Real* a = m.begin();
+        Real* t = result.begin();
+        for (Size i0=0; i0<rows; i0+=transposeBlock) {
+            Size i1 = std::min(i0+transposeBlock, rows);
+            for (Size j0=0; j0<columns; j0+=transposeBlock) {
+                Size j1 = std::min(j0+transposeBlock, columns);
+                for (Size i=i0; i<i1; ++i) {
+                    for (Size j=j0; j<j1; ++j)
+                        t[j*rows+i] = a[i*columns+j];
+                }
+            }
+        }
+        return result;
+    }
+
     Matrix inverse(const Matrix& m) {
         QL_REQUIRE(m.rows() == m.columns(), "matrix is not square");
 
@@ -190,7 +190,11 @@ namespace QuantLib {
     Array operator*(const Array&, const Matrix&);
     /*! \relates Matrix */
     Array operator*(const Matrix&, const Array&);
-    /*! \relates Matrix */
+    /*! \relates Matrix
+
+        The product is computed by a cache-blocked kernel, or by the
+        system CBLAS library if QL_USE_CBLAS is defined.
+    */
     Matrix operator*(const Matrix&, const Matrix&);
 
     // misc. operations
@@ -655,58 +659,6 @@ namespace QuantLib {
         return std::move(m);
     }
 
-    inline Array operator*(const Array& v, const Matrix& m) {
-        QL_REQUIRE(v.size() == m.rows(),
-                   "vectors and matrices with different sizes ("
-                   << v.size() << ", " << m.rows() << "x" << m.columns() <<
-                   ") cannot be multiplied");
-        Array result(m.columns());
-        for (Size i=0; i<result.size(); i++)
-            result[i] =
-                std::inner_product(v.begin(),v.end(),
-                                   m.column_begin(i),Real(0.0));
-        return result;
-    }
-
-    inline Array operator*(const Matrix& m, const Array& v) {
-        QL_REQUIRE(v.size() == m.columns(),
-                   "vectors and matrices with different sizes ("
-                   << v.size() << ", " << m.rows() << "x" << m.columns() <<
-                   ") cannot be multiplied");
-        Array result(m.rows());
-        for (Size i=0; i<result.size(); i++)
-            result[i] =
-                std::inner_product(v.begin(),v.end(),m.row_begin(i),Real(0.0));
-        return result;
-    }
-
-    inline Matrix operator*(const Matrix& m1, const Matrix& m2) {
-        QL_REQUIRE(m1.columns() == m2.rows(),
-                   "matrices with different sizes (" <<
-                   m1.rows() << "x" << m1.columns() << ", " <<
-                   m2.rows() << "x" << m2.columns() << ") cannot be "
-                   "multiplied");
-        Matrix result(m1.rows(),m2.columns(),0.0);
-        for (Size i=0; i<result.rows(); ++i) {
-            for (Size k=0; k<m1.columns(); ++k) {
-                for (Size j=0; j<result.columns(); ++j) {
-                    result[i][j] += m1[i][k]*m2[k][j];
-                }
-            }
-        }
-        return result;
-    }
-
-    inline Matrix transpose(const Matrix& m) {
-        Matrix result(m.columns(),m.rows());
-        #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
-        if (!m.empty())
-        #endif
-        for (Size i=0; i<m.rows(); i++)
-            std::copy(m.row_begin(i),m.row_end(i),result.column_begin(i));
-        return result;
-    }
-
     inline Matrix outerProduct(const Array& v1, const Array& v2) {
         return outerProduct(v1.begin(), v1.end(), v2.begin(), v2.end());
     }
@@ -0,0 +1,110 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    CsrMatrix::CsrMatrix(const SparseMatrix& m)
+    : rows_(m.size1()), columns_(m.size2()), rowOffsets_(m.size1()+1, 0) {
+        // uBLAS only fills the offsets up to the last non-empty row
+        const Size filled = std::min<Size>(m.filled1(), rows_+1);
+        for (Size i=0; i<filled; ++i)
+            rowOffsets_[i] = m.index1_data()[i];
+        for (Size i=std::max<Size>(filled, 1); i<=rows_; ++i)
+            rowOffsets_[i] = rowOffsets_[i-1];
+
+        const Size n = rowOffsets_.back();
+        QL_REQUIRE(n == m.nnz(), "inconsistent uBLAS sparse matrix storage");
+        columnIndices_.assign(m.index2_data().begin(), m.index2_data().begin() + n);
+        values_.assign(m.value_data().begin(), m.value_data().begin() + n);
+    }
+
+    CsrMatrix::CsrMatrix(Size rows,
+                         Size columns,
+                         std::vector<Size> rowOffsets,
+                         std::vector<Size> columnIndices,
+                         std::vector<Real> values)
+    : rows_(rows), columns_(columns), rowOffsets_(std::move(rowOffsets)),
+      columnIndices_(std::move(columnIndices)), values_(std::move(values)) {
+        QL_REQUIRE(rowOffsets_.size() == rows_+1,
+                   rows_+1 << " row offsets required, "
+                   << rowOffsets_.size() << " given");
+        QL_REQUIRE(rowOffsets_.front() == 0, "first row offset must be zero");
+        QL_REQUIRE(columnIndices_.size() == values_.size()
+                   && rowOffsets_.back() == values_.size(),
+                   "mismatch between row offsets ("
+                   << rowOffsets_.back() << " elements), column indices ("
+                   << columnIndices_.size() << ") and values ("
+                   << values_.size() << ")");
+        for (Size i=0; i<rows_; ++i) {
+            QL_REQUIRE(rowOffsets_[i] <= rowOffsets_[i+1],
+                       "decreasing row offsets at row " << i);
+            for (Size k=rowOffsets_[i]; k<rowOffsets_[i+1]; ++k) {
+                QL_REQUIRE(columnIndices_[k] < columns_,
+                           "column index " << columnIndices_[k]
+                           << " out of range at row " << i);
+                QL_REQUIRE(k == rowOffsets_[i]
+                           || columnIndices_[k-1] < columnIndices_[k],
+                           "column indices not increasing at row " << i);
+            }
+        }
+    }
+
+    Real CsrMatrix::operator()(Size i, Size j) const {
+        QL_REQUIRE(i < rows_ && j < columns_,
+                   "sparse matrix access (" << i << ", " << j
+                   << ") out of range");
+        const auto begin = columnIndices_.begin() + rowOffsets_[i];
+        const auto end = columnIndices_.begin() + rowOffsets_[i+1];
+        const auto k = std::lower_bound(begin, end, j);
+        return (k != end && *k == j) ? values_[k - columnIndices_.begin()] : 0.0;
+    }
+
+    SparseMatrix CsrMatrix::toSparseMatrix() const {
+        SparseMatrix m(rows_, columns_, values_.size());
+        for (Size i=0; i<rows_; ++i) {
+            for (Size k=rowOffsets_[i]; k<rowOffsets_[i+1]; ++k)
+                m.push_back(i, columnIndices_[k], values_[k]);
+        }
+        return m;
+    }
+
+    Array prod(const CsrMatrix& A, const Array& x) {
+        QL_REQUIRE(x.size() == A.columns(),
+                   "vectors and sparse matrices with different sizes ("
+                   << x.size() << ", " << A.rows() << "x" << A.columns() <<
+                   ") cannot be multiplied");
+
+        Array y(A.rows());
+        const Size* offsets = A.rowOffsets().data();
+        const Size* indices = A.columnIndices().data();
+        const Real* values = A.values().data();
+        const Real* v = x.begin();
+
+        #pragma omp parallel for if(A.nonZeros() > 100000)
+        for (long i=0; i<(long)A.rows(); ++i) {
+            Real t = 0.0;
+            for (Size k=offsets[i]; k<offsets[i+1]; ++k)
+                t += values[k]*v[indices[k]];
+            y[i] = t;
+        }
+        return y;
+    }
+
+}
@@ -0,0 +1,87 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file csrmatrix.hpp
+    \brief compressed sparse row matrix
+*/
+
+#ifndef quantlib_csr_matrix_hpp
+#define quantlib_csr_matrix_hpp
+
+#include <ql/math/array.hpp>
+#include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! immutable sparse matrix in compressed sparse row format
+    /*! SparseMatrix is convenient for assembling operators, but each
+        element access goes through a binary search in the uBLAS
+        storage.  Once assembled, a matrix used repeatedly, e.g., in
+        the products of an iterative solver, can be copied into this
+        class, which keeps row offsets, column indices and values in
+        three contiguous arrays.
+
+        Products with arrays are distributed over rows with OpenMP
+        when the library is compiled with OpenMP enabled.
+    */
+    class CsrMatrix {
+      public:
+        CsrMatrix() = default;
+        //! copies the compressed storage of a uBLAS matrix
+        explicit CsrMatrix(const SparseMatrix& m);
+        /*! \pre row offsets must be non-decreasing, start at zero and
+                 have rows+1 elements, the last one being the number
+                 of stored elements; column indices must be increasing
+                 within each row.
+        */
+        CsrMatrix(Size rows,
+                  Size columns,
+                  std::vector<Size> rowOffsets,
+                  std::vector<Size> columnIndices,
+                  std::vector<Real> values);
+
+        //! \name Inspectors
+        //@{
+        Size rows() const { return rows_; }
+        Size columns() const { return columns_; }
+        Size nonZeros() const { return values_.size(); }
+        const std::vector<Size>& rowOffsets() const { return rowOffsets_; }
+        const std::vector<Size>& columnIndices() const { return columnIndices_; }
+        const std::vector<Real>& values() const { return values_; }
+        //! returns the stored element, or zero if none is stored
+        Real operator()(Size i, Size j) const;
+        //@}
+
+        //! \name Conversions
+        //@{
+        SparseMatrix toSparseMatrix() const;
+        //@}
+
+      private:
+        Size rows_ = 0, columns_ = 0;
+        std::vector<Size> rowOffsets_ = std::vector<Size>(1, 0);
+        std::vector<Size> columnIndices_;
+        std::vector<Real> values_;
+    };
+
+    /*! \relates CsrMatrix */
+    Array prod(const CsrMatrix& A, const Array& x);
+
+}
+
+#endif
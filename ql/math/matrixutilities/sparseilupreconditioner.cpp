@@ -18,131 +18,113 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 */
 
 #include <ql/math/matrixutilities/sparseilupreconditioner.hpp>
-#include <ql/math/matrix.hpp>
-
+#include <algorithm>
 #include <set>
 
 namespace QuantLib {
 
-    using namespace boost::numeric::ublas;
-
     SparseILUPreconditioner::SparseILUPreconditioner(const SparseMatrix& A,
                                                      Integer lfil)
-    : L_(A.size1(),A.size2()),
-      U_(A.size1(),A.size2()) {
-
-        QL_REQUIRE(A.size1() == A.size2(),
-                   "sparse ILU preconditioner works only with square matrices");
+    : SparseILUPreconditioner(CsrMatrix(A), lfil) {}
 
-        for (SparseMatrix::size_type i=0; i < L_.size1(); ++i)
-            L_(i,i) = 1.0;
+    SparseILUPreconditioner::SparseILUPreconditioner(const CsrMatrix& A,
+                                                     Integer lfil) {
 
-        const Integer n = A.size1();
-        std::set<Integer> lBandSet, uBandSet;
-
-        compressed_matrix<Integer> levs(n,n);
-        Integer lfilp = lfil + 1;
+        QL_REQUIRE(A.rows() == A.columns(),
+                   "sparse ILU preconditioner works only with square matrices");
 
-        for (Integer ii=0; ii<n; ++ii) {
-            Array w(n);
-            for(Integer k=0; k<n; ++k) {
-                w[k] = A(ii,k);
+        const Size n = A.rows();
+        const Integer lfilp = lfil + 1;
+        const auto nonZero = [](Real x) {
+            return x > QL_EPSILON || x < -1.0*QL_EPSILON;
+        };
+
+        std::vector<Size> lOffsets(1, 0), lIndices, uOffsets(1, 0), uIndices;
+        std::vector<Real> lValues, uValues;
+        // fill levels of the elements of U
+        std::vector<Integer> uLevels;
+
+        // work row with the levels of its elements; only the
+        // elements listed in the pattern are reset after each row
+        std::vector<Real> w(n, 0.0);
+        std::vector<Integer> levii(n, 0);
+        std::vector<Size> pattern;
+        std::set<Size> lower;
+
+        for (Size ii=0; ii<n; ++ii) {
+            for (Size k=A.rowOffsets()[ii]; k<A.rowOffsets()[ii+1]; ++k) {
+                const Real entry = A.values()[k];
+                if (nonZero(entry)) {
+                    const Size j = A.columnIndices()[k];
+                    w[j] = entry;
+                    levii[j] = 1;
+                    pattern.push_back(j);
+                    if (j < ii)
+                        lower.insert(j);
+                }
             }
 
-            std::vector<Integer> levii(n, 0);
-            for (Integer i=0; i<n; ++i) {
-                if(   w[i] > QL_EPSILON
-                      || w[i] < -1.0*QL_EPSILON) levii[i] = 1;
-            }
-            Integer jj = -1;
-            while (jj < ii) {
-                for (Integer k=jj+1; k<n; ++k) {
-                    if (levii[k] != 0) {
-                        jj = k;
-                        break;
-                    }
-                }
-                if (jj >= ii) {
-                    break;
-                }
-                Integer jlev = levii[jj];
-                if (jlev <= lfilp) {
-                    std::vector<Integer> nonZeros;
-                    std::vector<Real> nonZeroEntries;
-                    nonZeros.reserve(uBandSet.size()+1);
-                    nonZeroEntries.reserve(uBandSet.size()+1);
-                    const Real entry = U_(jj,jj);
-                    if(entry > QL_EPSILON || entry < -1.0*QL_EPSILON) {
-                        nonZeros.push_back(jj);
-                        nonZeroEntries.push_back(entry);
-                    }
-                    auto iter = uBandSet.begin();
-                    auto end = uBandSet.end();
-                    for (; iter != end; ++iter) {
-                        const Real entry = U_(jj,jj+*iter);
-                        if(entry > QL_EPSILON || entry < -1.0*QL_EPSILON) {
-                            nonZeros.push_back(jj+*iter);
-                            nonZeroEntries.push_back(entry);
+            // eliminate the lower part in increasing column order,
+            // including the fill-in created along the way
+            while (!lower.empty()) {
+                const Size jj = *lower.begin();
+                lower.erase(lower.begin());
+                const Integer jlev = levii[jj];
+                if (jlev > lfilp)
+                    continue;
+
+                const Size begin = uOffsets[jj], end = uOffsets[jj+1];
+                Real fact = w[jj];
+                if (begin != end)
+                    fact /= uValues[begin];
+                for (Size k=begin; k<end; ++k) {
+                    const Size j = uIndices[k];
+                    const Integer temp = uLevels[k] + jlev;
+                    if (levii[j] == 0) {
+                        if (temp <= lfilp) {
+                            w[j] = -fact*uValues[k];
+                            levii[j] = temp;
+                            pattern.push_back(j);
+                            if (j < ii)
+                                lower.insert(j);
                         }
                     }
-                    Real fact = w[jj];
-                    if(!nonZeroEntries.empty()) {
-                        fact /= nonZeroEntries[0];
+                    else {
+                        w[j] -= fact*uValues[k];
+                        levii[j] = std::min(levii[j], temp);
                     }
-                    for (Size k=0; k<nonZeros.size(); ++k) {
-                        const Integer j = nonZeros[k] ;
-                        const Integer temp = levs(jj,j) + jlev ;
-                        if (levii[j] == 0) {
-                            if (temp <= lfilp) {
-                                w[j] =  - fact*nonZeroEntries[k];
-                                levii[j] = temp;
-                            }
-                        }
-                        else {
-                            w[j] -= fact*nonZeroEntries[k];
-                            levii[j] = std::min(levii[j],temp);
-                        }
-                    }
-                    w[jj] = fact;
-                }
-            }
-            std::vector<Integer> wNonZeros;
-            std::vector<Real> wNonZeroEntries;
-            wNonZeros.reserve(w.size());
-            wNonZeroEntries.reserve(w.size());
-            for (Size i=0; i<w.size(); ++i) {
-                const Real entry = w[i];
-                if(entry > QL_EPSILON || entry < -1.0*QL_EPSILON) {
-                    wNonZeros.push_back(i);
-                    wNonZeroEntries.push_back(entry);
                 }
+                w[jj] = fact;
             }
-            std::vector<Integer> leviiNonZeroEntries;
-            leviiNonZeroEntries.reserve(levii.size());
-            for (int entry : levii) {
-                if (entry > QL_EPSILON || entry < -1.0 * QL_EPSILON) {
-                    leviiNonZeroEntries.push_back(entry);
-                }
-            }
-            for (Size k=0; k<wNonZeros.size(); ++k) {
-                Integer j = wNonZeros[k];
-                if (j < ii) {
-                    L_(ii,j) = wNonZeroEntries[k];
-                    lBandSet.insert(ii-j);
-                }
-                else {
-                    U_(ii,j) = wNonZeroEntries[k];
-                    levs(ii,j) = leviiNonZeroEntries[k];
-                    if(j-ii > 0) {
-                        uBandSet.insert(j-ii);
+
+            std::sort(pattern.begin(), pattern.end());
+            for (Size j : pattern) {
+                if (nonZero(w[j])) {
+                    if (j < ii) {
+                        lIndices.push_back(j);
+                        lValues.push_back(w[j]);
+                    }
+                    else {
+                        uIndices.push_back(j);
+                        uValues.push_back(w[j]);
+                        uLevels.push_back(levii[j]);
                     }
                 }
+                w[j] = 0.0;
+                levii[j] = 0;
             }
+            pattern.clear();
+
+            lIndices.push_back(ii);
+            lValues.push_back(1.0);
+            lOffsets.push_back(lIndices.size());
+            uOffsets.push_back(uIndices.size());
         }
-        lBands_.resize(lBandSet.size());
-        uBands_.resize(uBandSet.size());
-        std::copy(lBandSet.begin(), lBandSet.end(), lBands_.begin());
-        std::copy(uBandSet.begin(), uBandSet.end(), uBands_.begin());
+
+        l_ = CsrMatrix(n, n, std::move(lOffsets), std::move(lIndices), std::move(lValues));
+        u_ = CsrMatrix(n, n, std::move(uOffsets), std::move(uIndices), std::move(uValues));
+        L_ = l_.toSparseMatrix();
+        U_ = u_.toSparseMatrix();
     }
 
     const SparseMatrix& SparseILUPreconditioner::L() const {
@@ -158,33 +140,38 @@ namespace QuantLib {
     }
 
     Array SparseILUPreconditioner::forwardSolve(const Array& b) const {
-        Integer n = b.size();
-        Array y(n, 0.0);
-        y[0]=b[0]/L_(0,0);
-        for (Integer i=1; i<=n-1; ++i) {
-            y[i] = b[i]/L_(i,i);
-            for (Integer j=lBands_.size()-1;
-                 j>=0 && i-Integer(lBands_[j]) <= i-1; --j) {
-                const Integer k = i-Integer(lBands_[j]);
-                if (k >= 0)
-                    y[i]-=L_(i,k)*y[k]/L_(i,i);
-            }
+        const std::vector<Size>& offsets = l_.rowOffsets();
+        const std::vector<Size>& indices = l_.columnIndices();
+        const std::vector<Real>& values = l_.values();
+
+        // L has a unit diagonal, stored as the last element of each row
+        Array y(b.size());
+        for (Size i=0; i<b.size(); ++i) {
+            Real t = b[i];
+            for (Size k=offsets[i]; k+1<offsets[i+1]; ++k)
+                t -= values[k]*y[indices[k]];
+            y[i] = t;
         }
         return y;
     }
 
     Array SparseILUPreconditioner::backwardSolve(const Array& y) const {
-        Size n = y.size();
-        Array x(n, 0.0);
-        x[n-1] = y[n-1]/U_(n-1,n-1);
-        for (Integer i=n-2; i>=0; --i) {
-            x[i] = y[i]/U_(i,i);
-            for (Size j=0; j<uBands_.size() && i+uBands_[j] <= n-1; ++j) {
-                x[i] -= U_(i,i+uBands_[j])*x[i+uBands_[j]]/U_(i,i);
-            }
+        const std::vector<Size>& offsets = u_.rowOffsets();
+        const std::vector<Size>& indices = u_.columnIndices();
+        const std::vector<Real>& values = u_.values();
+
+        Array x(y.size());
+        for (Size i=y.size(); i-- > 0;) {
+            Size k = offsets[i];
+            const Size end = offsets[i+1];
+            // the diagonal, if stored, is the first element of the row
+            const Real diag = (k < end && indices[k] == i) ? values[k++] : 0.0;
+            Real t = y[i]/diag;
+            for (; k<end; ++k)
+                t -= values[k]*x[indices[k]]/diag;
+            x[i] = t;
         }
         return x;
     }
 
 }
-
@@ -25,7 +25,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #define quantlib_sparse_ilu_preconditioner_hpp
 
 #include <ql/math/array.hpp>
-#include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 
 namespace QuantLib {
 
@@ -36,6 +36,12 @@ namespace QuantLib {
     class SparseILUPreconditioner  {
       public:
         explicit SparseILUPreconditioner(const SparseMatrix& A, Integer lfil = 1);
+        /*! The factorization runs over the stored elements of each
+            row, so that its cost grows with the number of non-zero
+            elements of the factors rather than with the square of
+            the size of the matrix.
+        */
+        explicit SparseILUPreconditioner(const CsrMatrix& A, Integer lfil = 1);
 
         const SparseMatrix& L() const;
         const SparseMatrix& U() const;
@@ -43,8 +49,8 @@ namespace QuantLib {
         Array apply(const Array& b) const;
 
       private:
+        CsrMatrix l_, u_;
         SparseMatrix L_, U_;
-        std::vector<Size> lBands_, uBands_;
 
         Array forwardSolve(const Array& b) const;
         Array backwardSolve(const Array& y) const;
@@ -8,6 +8,7 @@
 #include <ql/math/optimization/costfunction.hpp>
 #include <ql/math/optimization/differentialevolution.hpp>
 #include <ql/math/optimization/endcriteria.hpp>
+#include <ql/math/optimization/evaluationexecutor.hpp>
 #include <ql/math/optimization/goldstein.hpp>
 #include <ql/math/optimization/leastsquare.hpp>
 #include <ql/math/optimization/levenbergmarquardt.hpp>
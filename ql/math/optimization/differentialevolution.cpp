@@ -74,8 +74,10 @@ namespace QuantLib {
                 population[i].values = configuration().initialPopulation[i];
                 QL_REQUIRE(population[i].values.size() == p.currentValue().size(),
                            "wrong values size in initial population");
-                population[i].cost = p.costFunction().value(population[i].values);
             }
+            p.executor().run(population.size(), [&](Size i) {
+                population[i].cost = p.costFunction().value(population[i].values);
+            });
         } else {
             population = std::vector<Candidate>(configuration().populationMembers,
                                                 Candidate(p.currentValue().size()));
@@ -293,15 +295,18 @@ namespace QuantLib {
                                - lowerBound_[memIter]);
                 }
             }
-            // evaluate objective function as soon as possible to avoid unnecessary loops
-            try {
-                population[popIter].cost = p.value(population[popIter].values);
-            } catch (Error&) {
-                population[popIter].cost = QL_MAX_REAL;
-            }
-            if (!std::isfinite(population[popIter].cost))
-                population[popIter].cost = QL_MAX_REAL;
+        }
 
+        // evaluate objective function; the candidates are independent
+        // and can be evaluated concurrently by the problem executor
+        std::vector<Array> candidates(population.size());
+        for (Size popIter = 0; popIter < population.size(); popIter++)
+            candidates[popIter] = population[popIter].values;
+        Array costs;
+        p.evaluate(candidates, costs, QL_MAX_REAL);
+        for (Size popIter = 0; popIter < population.size(); popIter++) {
+            population[popIter].cost =
+                std::isfinite(costs[popIter]) ? costs[popIter] : QL_MAX_REAL;
         }
     }
 
@@ -381,17 +386,18 @@ namespace QuantLib {
 
         // use initial values provided by the user
         population.front().values = p.currentValue();
-        population.front().cost = p.costFunction().value(population.front().values);
         // rest of the initial population is random
         for (Size j = 1; j < population.size(); ++j) {
             for (Size i = 0; i < p.currentValue().size(); ++i) {
                 Real l = lowerBound_[i], u = upperBound_[i];
                 population[j].values[i] = l + (u-l)*rng_.nextReal();
             }
+        }
+        p.executor().run(population.size(), [&](Size j) {
             population[j].cost = p.costFunction().value(population[j].values);
-            if (!std::isfinite(population[j].cost))
+            if (j > 0 && !std::isfinite(population[j].cost))
                 population[j].cost = QL_MAX_REAL;
-        }
+        });
     }
 
 }
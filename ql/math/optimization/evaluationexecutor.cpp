@@ -0,0 +1,63 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/optimization/evaluationexecutor.hpp>
+#include <exception>
+#include <vector>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace QuantLib {
+
+    void EvaluationExecutor::run(Size n,
+                                 const std::function<void(Size)>& task) const {
+        for (Size i=0; i<n; ++i)
+            task(i);
+    }
+
+    void ParallelEvaluationExecutor::run(Size n,
+                                         const std::function<void(Size)>& task) const {
+        #if defined(_OPENMP)
+
+        // exceptions can't leave the parallel region; they are stored
+        // and the one with the lowest index is rethrown afterwards
+        std::vector<std::exception_ptr> errors(n);
+        int threads = threads_ > 0 ? int(threads_) : omp_get_max_threads();
+
+        #pragma omp parallel for schedule(dynamic) num_threads(threads) if(n > 1)
+        for (long i=0; i<static_cast<long>(n); ++i) {
+            try {
+                task(Size(i));
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+
+        for (const auto& e : errors) {
+            if (e)
+                std::rethrow_exception(e);
+        }
+
+        #else
+
+        EvaluationExecutor::run(n, task);
+
+        #endif
+    }
+
+}
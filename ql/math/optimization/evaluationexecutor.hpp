@@ -0,0 +1,78 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file evaluationexecutor.hpp
+    \brief executors for independent cost-function evaluations
+*/
+
+#ifndef quantlib_optimization_evaluation_executor_hpp
+#define quantlib_optimization_evaluation_executor_hpp
+
+#include <ql/types.hpp>
+#include <functional>
+
+namespace QuantLib {
+
+    //! Runs independent evaluations of a cost function
+    /*! Population-based optimizers evaluate their cost function on
+        several points at once through the executor of their
+        Problem.  This base class runs the evaluations sequentially.
+
+        Implementations can run the evaluations in any order and
+        concurrently; since each result is stored in the slot of its
+        point, the optimizers return the same results regardless of
+        the executor being used.
+    */
+    class EvaluationExecutor {
+      public:
+        virtual ~EvaluationExecutor() = default;
+        //! calls task(i) for each i in [0, n)
+        /*! If any call throws, the exception thrown by the call with
+            the lowest index is propagated; calls with higher indices
+            might not be made.
+        */
+        virtual void run(Size n, const std::function<void(Size)>& task) const;
+    };
+
+    //! Runs independent evaluations of a cost function in parallel
+    /*! The evaluations are distributed with OpenMP; when the library
+        is not compiled with OpenMP support, they are run
+        sequentially.
+
+        \warning the cost function must allow concurrent calls to its
+                 value() method.  This is not the case for cost
+                 functions that modify shared objects, such as the
+                 ones used by CalibratedModel::calibrate, which set the
+                 parameters of the model; nor for those which trigger
+                 recalculations of lazy objects shared between threads.
+    */
+    class ParallelEvaluationExecutor : public EvaluationExecutor {
+      public:
+        /*! \param threads  maximum number of threads to be used; if 0,
+                            the OpenMP default is used.
+        */
+        explicit ParallelEvaluationExecutor(Size threads = 0)
+        : threads_(threads) {}
+        void run(Size n, const std::function<void(Size)>& task) const override;
+      private:
+        Size threads_;
+    };
+
+}
+
+
+#endif
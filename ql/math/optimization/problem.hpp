@@ -28,8 +28,11 @@
 
 #include <ql/math/optimization/constraint.hpp>
 #include <ql/math/optimization/costfunction.hpp>
+#include <ql/math/optimization/evaluationexecutor.hpp>
 #include <ql/math/optimization/method.hpp>
+#include <ql/shared_ptr.hpp>
 #include <utility>
+#include <vector>
 
 namespace QuantLib {
 
@@ -42,9 +45,15 @@ namespace QuantLib {
     class Problem {
       public:
         //! default constructor
-        Problem(CostFunction& costFunction, Constraint& constraint, Array initialValue = Array())
+        /*! The executor is used by evaluate(); if none is passed, the
+            evaluations are run sequentially.
+        */
+        Problem(CostFunction& costFunction,
+                Constraint& constraint,
+                Array initialValue = Array(),
+                ext::shared_ptr<EvaluationExecutor> executor = {})
         : costFunction_(costFunction), constraint_(constraint),
-          currentValue_(std::move(initialValue)) {
+          currentValue_(std::move(initialValue)), executor_(std::move(executor)) {
             QL_REQUIRE(!constraint.empty(), "empty constraint given");
         }
 
@@ -58,6 +67,19 @@ namespace QuantLib {
         //! call cost values computation and increment evaluation counter
         Array values(const Array& x);
 
+        //! call cost function computation on several points and
+        //  increment evaluation counter
+        /*! The evaluations are run by the executor of the problem and
+            might be concurrent; the value in points[i] is stored in
+            results[i].  If \c errorValue is not null, it is stored for
+            the points whose evaluation throws a QuantLib::Error;
+            otherwise, the exception thrown for the point with the
+            lowest index is propagated.
+        */
+        void evaluate(const std::vector<Array>& points,
+                      Array& results,
+                      Real errorValue = Null<Real>());
+
         //! call cost function gradient computation and increment
         //  evaluation counter
         void gradient(Array& grad_f,
@@ -73,6 +95,16 @@ namespace QuantLib {
         //! Cost function
         CostFunction& costFunction() const { return costFunction_; }
 
+        //! executor used for evaluations on several points
+        const EvaluationExecutor& executor() const;
+
+        /*! Sets the executor used by evaluate(); by default, the
+            evaluations are run sequentially.
+        */
+        void setExecutor(ext::shared_ptr<EvaluationExecutor> executor) {
+            executor_ = std::move(executor);
+        }
+
         void setCurrentValue(const Array& currentValue) {
             currentValue_=currentValue;
         }
@@ -110,6 +142,8 @@ namespace QuantLib {
         Real functionValue_, squaredNorm_;
         //! number of evaluation of cost function and its gradient
         Integer functionEvaluation_, gradientEvaluation_;
+        //! executor of evaluations on several points
+        ext::shared_ptr<EvaluationExecutor> executor_;
     };
 
     // inline definitions
@@ -123,6 +157,29 @@ namespace QuantLib {
         return costFunction_.values(x);
     }
 
+    inline const EvaluationExecutor& Problem::executor() const {
+        static const EvaluationExecutor sequential;
+        return executor_ != nullptr ? *executor_ : sequential;
+    }
+
+    inline void Problem::evaluate(const std::vector<Array>& points,
+                                  Array& results,
+                                  Real errorValue) {
+        results = Array(points.size());
+        functionEvaluation_ += Integer(points.size());
+        executor().run(points.size(), [&](Size i) {
+            if (errorValue == Null<Real>()) {
+                results[i] = costFunction_.value(points[i]);
+            } else {
+                try {
+                    results[i] = costFunction_.value(points[i]);
+                } catch (Error&) {
+                    results[i] = errorValue;
+                }
+            }
+        });
+    }
+
     inline void Problem::gradient(Array& grad_f,
                                   const Array& x) {
         ++gradientEvaluation_;
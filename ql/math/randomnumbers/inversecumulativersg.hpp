@@ -45,6 +45,13 @@ namespace QuantLib {
             Size USG::dimension() const;
         \endcode
 
+        If a client of this class wants to use the discard method,
+        class USG must also implement
+        \code
+            void USG::discard(BigNatural n);
+        \endcode
+        skipping the next \c n sequences.
+
         The inverse cumulative distribution is supplied by IC.
 
         Class IC must implement the following interface:
@@ -62,6 +69,8 @@ namespace QuantLib {
         //! returns next sample from the inverse cumulative distribution
         const sample_type& nextSequence() const;
         const sample_type& lastSequence() const { return x_; }
+        //! skips the next \c n samples
+        void discard(BigNatural n) { uniformSequenceGenerator_.discard(n); }
         Size dimension() const { return dimension_; }
       private:
         USG uniformSequenceGenerator_;
@@ -0,0 +1,102 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/randomnumbers/philox4x32uniformrng.hpp>
+#include <ql/math/randomnumbers/seedgenerator.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        const std::uint32_t multiplier0 = 0xD2511F53;
+        const std::uint32_t multiplier1 = 0xCD9E8D57;
+        const std::uint32_t weyl0 = 0x9E3779B9;
+        const std::uint32_t weyl1 = 0xBB67AE85;
+
+        inline void mulhilo(std::uint32_t a, std::uint32_t b,
+                            std::uint32_t& high, std::uint32_t& low) {
+            std::uint64_t product = std::uint64_t(a) * std::uint64_t(b);
+            high = std::uint32_t(product >> 32);
+            low = std::uint32_t(product);
+        }
+
+    }
+
+    Philox4x32UniformRng::Philox4x32UniformRng(std::uint64_t seed,
+                                               std::uint64_t stream)
+    : stream_(stream) {
+        if (seed == 0)
+            seed = SeedGenerator::instance().get();
+        key_[0] = std::uint32_t(seed);
+        key_[1] = std::uint32_t(seed >> 32);
+    }
+
+    Philox4x32UniformRng Philox4x32UniformRng::split(std::uint64_t stream) const {
+        Philox4x32UniformRng rng(*this);
+        rng.stream_ = stream;
+        rng.block_ = 0;
+        rng.word_ = 0;
+        rng.valid_ = false;
+        return rng;
+    }
+
+    void Philox4x32UniformRng::discard(std::uint64_t n) {
+        // each number takes two words, and each block has four
+        block_ += n >> 1;
+        if ((n & 1) != 0U) {
+            word_ += 2;
+            if (word_ >= 4) {
+                word_ -= 4;
+                ++block_;
+            }
+        }
+    }
+
+    std::uint64_t Philox4x32UniformRng::seed() const {
+        return (std::uint64_t(key_[1]) << 32) | key_[0];
+    }
+
+    std::uint64_t Philox4x32UniformRng::stream() const {
+        return stream_;
+    }
+
+    void Philox4x32UniformRng::generate(std::uint64_t block) const {
+        std::uint32_t c0 = std::uint32_t(block),
+                      c1 = std::uint32_t(block >> 32),
+                      c2 = std::uint32_t(stream_),
+                      c3 = std::uint32_t(stream_ >> 32);
+        std::uint32_t k0 = key_[0], k1 = key_[1];
+        for (Size round = 0; round < 10; ++round) {
+            if (round > 0) {
+                k0 += weyl0;
+                k1 += weyl1;
+            }
+            std::uint32_t high0, low0, high1, low1;
+            mulhilo(multiplier0, c0, high0, low0);
+            mulhilo(multiplier1, c2, high1, low1);
+            c0 = high1 ^ c1 ^ k0;
+            c1 = low1;
+            c2 = high0 ^ c3 ^ k1;
+            c3 = low0;
+        }
+        buffer_[0] = c0;
+        buffer_[1] = c1;
+        buffer_[2] = c2;
+        buffer_[3] = c3;
+    }
+
+}
@@ -0,0 +1,116 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file philox4x32uniformrng.hpp
+    \brief Philox-4x32-10 counter-based uniform random number generator
+*/
+
+#ifndef quantlib_philox4x32_uniform_rng_hpp
+#define quantlib_philox4x32_uniform_rng_hpp
+
+#include <ql/methods/montecarlo/sample.hpp>
+#include <ql/types.hpp>
+#include <cstdint>
+
+namespace QuantLib {
+
+    //! Counter-based uniform random number generator
+    /*! Philox-4x32-10 generator as described in J.K. Salmon,
+        M.A. Moraes, R.O. Dror and D.E. Shaw, "Parallel random
+        numbers: as easy as 1, 2, 3", Proceedings of SC11 (2011).
+
+        The random numbers are obtained by encrypting a 128-bit
+        counter with a key given by the seed; each counter value
+        yields four 32-bit integers.  The higher 64 bits of the
+        counter select a stream and the lower 64 bits the position
+        in it, so that each stream has period 2**66 and independent
+        streams (e.g., one per path or per thread) can be obtained in
+        constant time, as can any position in a stream.  This allows
+        multi-threaded simulations to be reproducible regardless of
+        how paths are assigned to threads.
+
+        \test the returned values are checked against the known-answer
+              tests of the reference implementation.
+    */
+    class Philox4x32UniformRng {
+      public:
+        typedef Sample<Real> sample_type;
+
+        /*! If the given seed is 0, a random seed will be chosen
+            based on the SeedGenerator.
+        */
+        explicit Philox4x32UniformRng(std::uint64_t seed = 0,
+                                      std::uint64_t stream = 0);
+
+        /*! returns a sample with weight 1.0 containing a random number
+            in the (0.0, 1.0) interval */
+        sample_type next() const { return {nextReal(), 1.0}; }
+
+        //! return a random number in the (0.0, 1.0)-interval
+        Real nextReal() const { return (Real(nextInt64() >> 11) + 0.5) * (1.0 / Real(1ULL << 53)); }
+
+        //! return a random integer in the [0,0xffffffff]-interval
+        std::uint32_t nextInt32() const {
+            if (!valid_ || cachedBlock_ != block_) {
+                generate(block_);
+                cachedBlock_ = block_;
+                valid_ = true;
+            }
+            std::uint32_t result = buffer_[word_];
+            if (++word_ == 4) {
+                word_ = 0;
+                ++block_;
+            }
+            return result;
+        }
+
+        //! return a random integer in the [0,0xffffffffffffffffULL]-interval
+        std::uint64_t nextInt64() const {
+            std::uint64_t low = nextInt32();
+            std::uint64_t high = nextInt32();
+            return (high << 32) | low;
+        }
+
+        //! \name Streams
+        //@{
+        //! returns a generator for the given stream with the same seed
+        Philox4x32UniformRng split(std::uint64_t stream) const;
+        /*! skips the numbers that \c n calls to next(), nextReal()
+            or nextInt64() would return (i.e., \c 2n calls to
+            nextInt32()) in constant time
+        */
+        void discard(std::uint64_t n);
+        std::uint64_t seed() const;
+        std::uint64_t stream() const;
+        //@}
+
+      private:
+        void generate(std::uint64_t block) const;
+        std::uint32_t key_[2];
+        std::uint64_t stream_;
+        // position of the next number
+        mutable std::uint64_t block_ = 0;
+        mutable Size word_ = 0;
+        // last generated block
+        mutable std::uint32_t buffer_[4] = {0, 0, 0, 0};
+        mutable std::uint64_t cachedBlock_ = 0;
+        mutable bool valid_ = false;
+    };
+
+}
+
+#endif
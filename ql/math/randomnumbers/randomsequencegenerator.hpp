@@ -26,6 +26,7 @@
 
 #include <ql/methods/montecarlo/sample.hpp>
 #include <ql/errors.hpp>
+#include <cstdint>
 #include <vector>
 
 namespace QuantLib {
@@ -43,6 +44,11 @@ namespace QuantLib {
         \code
             unsigned long RNG::nextInt32() const;
         \endcode
+        and if it wants to use the discard method, RNG must implement
+        \code
+            void RNG::discard(unsigned long long n);
+        \endcode
+        skipping the results of \c n calls to RNG::next().
 
         \warning do not use with low-discrepancy sequence generator.
     */
@@ -83,6 +89,10 @@ namespace QuantLib {
         const sample_type& lastSequence() const {
             return sequence_;
         }
+        //! skips the next \c n sequences
+        void discard(BigNatural n) {
+            rng_.discard(std::uint64_t(n) * dimensionality_);
+        }
         Size dimension() const {return dimensionality_;}
       private:
         Size dimensionality_;
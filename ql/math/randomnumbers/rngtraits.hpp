@@ -28,6 +28,7 @@
 
 #include <ql/methods/montecarlo/pathgenerator.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/randomnumbers/philox4x32uniformrng.hpp>
 #include <ql/math/randomnumbers/inversecumulativerng.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
@@ -77,6 +78,14 @@ namespace QuantLib {
     typedef GenericPseudoRandom<MersenneTwisterUniformRng,
                                 InverseCumulativePoisson> PoissonPseudoRandom;
 
+    //! traits for counter-based pseudo-random number generation
+    /*! The sequence generators can skip any number of sequences in
+        constant time, so that each path can be simulated from its
+        index alone.
+    */
+    typedef GenericPseudoRandom<Philox4x32UniformRng,
+                                InverseCumulativeNormal> PhiloxPseudoRandom;
+
 
     template <class URSG, class IC>
     struct GenericLowDiscrepancy {
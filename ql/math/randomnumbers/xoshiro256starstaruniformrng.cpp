@@ -65,4 +65,35 @@ namespace QuantLib {
                                                                std::uint64_t s3)
     : s0_(s0), s1_(s1), s2_(s2), s3_(s3) {}
 
+    void Xoshiro256StarStarUniformRng::jump() {
+        static const std::uint64_t polynomial[] = {
+            0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c};
+        jump(polynomial);
+    }
+
+    void Xoshiro256StarStarUniformRng::longJump() {
+        static const std::uint64_t polynomial[] = {
+            0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241, 0x39109bb02acbe635};
+        jump(polynomial);
+    }
+
+    void Xoshiro256StarStarUniformRng::jump(const std::uint64_t* polynomial) {
+        std::uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        for (Size i = 0; i < 4; ++i) {
+            for (Size b = 0; b < 64; ++b) {
+                if ((polynomial[i] & (std::uint64_t(1) << b)) != 0U) {
+                    s0 ^= s0_;
+                    s1 ^= s1_;
+                    s2 ^= s2_;
+                    s3 ^= s3_;
+                }
+                nextInt64();
+            }
+        }
+        s0_ = s0;
+        s1_ = s1;
+        s2_ = s2;
+        s3_ = s3;
+    }
+
 }
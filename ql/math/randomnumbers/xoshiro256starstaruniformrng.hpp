@@ -90,7 +90,21 @@ namespace QuantLib {
             return result;
         }
 
+        //! \name Jumps
+        /*! These can be used to obtain non-overlapping subsequences
+            for parallel computations: copies of a generator, each
+            advanced by a different number of jumps, will generate
+            independent streams.
+        */
+        //@{
+        //! advances the state as 2**128 calls to nextInt64() would do
+        void jump();
+        //! advances the state as 2**192 calls to nextInt64() would do
+        void longJump();
+        //@}
+
       private:
+        void jump(const std::uint64_t* polynomial);
         static std::uint64_t rotl(std::uint64_t x, std::int32_t k) { return (x << k) | (x >> (64 - k)); }
         mutable std::uint64_t s0_, s1_, s2_, s3_;
     };
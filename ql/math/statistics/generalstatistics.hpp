@@ -178,6 +178,9 @@ namespace QuantLib {
                 add(*begin, *wbegin);
         }
 
+        //! adds the samples collected by another instance
+        void merge(const GeneralStatistics& other);
+
         //! resets the data to a null set
         void reset();
 
@@ -235,6 +238,16 @@ namespace QuantLib {
         sorted_ = false;
     }
 
+    inline void GeneralStatistics::merge(const GeneralStatistics& other) {
+        // copied by index, since other might be this same instance
+        Size n = other.samples_.size();
+        samples_.reserve(samples_.size() + n);
+        for (Size i=0; i<n; ++i)
+            samples_.push_back(other.samples_[i]);
+        if (n > 0)
+            sorted_ = false;
+    }
+
     inline void GeneralStatistics::reset() {
         samples_ = std::vector<std::pair<Real,Real> >();
         sorted_ = true;
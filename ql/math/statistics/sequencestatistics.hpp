@@ -43,6 +43,13 @@ namespace QuantLib {
         requested to the 1-D underlying StatisticsType class, with the
         usual compile-time checks provided by the template approach.
 
+        The accumulation of the covariance matrix takes time
+        quadratic in the dimension and can dominate the cost of
+        simulations with many outputs; it can be disabled when only
+        the 1-D statistics are needed.  Samples can also be added in
+        batches, in which case the covariance is updated with a
+        single matrix product.
+
         \test the correctness of the returned values is tested by
               checking them against numerical calculations.
     */
@@ -53,10 +60,13 @@ namespace QuantLib {
         typedef StatisticsType statistics_type;
         typedef std::vector<typename StatisticsType::value_type> value_type;
         // constructor
-        GenericSequenceStatistics(Size dimension = 0);
+        GenericSequenceStatistics(Size dimension = 0,
+                                  bool trackCovariance = true);
         //! \name inspectors
         //@{
         Size size() const { return dimension_; }
+        //! whether the covariance matrix is being accumulated
+        bool tracksCovariance() const { return trackCovariance_; }
         //@}
         //! \name covariance and correlation
         //@{
@@ -132,16 +142,36 @@ namespace QuantLib {
                        " required, " << std::distance(begin, end) <<
                        " provided");
 
-            quadraticSum_ += weight * outerProduct(begin, end,
-                                                   begin, end);
+            if (trackCovariance_) {
+                Iterator x = begin;
+                for (Size i=0; i<dimension_; ++x, ++i) {
+                    Real wx = weight * (*x);
+                    Iterator y = begin;
+                    for (Size j=0; j<=i; ++y, ++j)
+                        quadraticSum_[i][j] += wx * (*y);
+                    for (Size j=0; j<i; ++j)
+                        quadraticSum_[j][i] = quadraticSum_[i][j];
+                }
+            }
 
             for (Size i=0; i<dimension_; ++begin, ++i)
                 stats_[i].add(*begin, weight);
 
         }
+        //! adds a batch of samples, one for each row of the matrix
+        void add(const Matrix& samples);
+        //! adds a batch of weighted samples, one for each row of the matrix
+        void add(const Matrix& samples, const Array& weights);
+        //! adds the samples collected by another instance
+        /*! This allows separate instances to collect samples, e.g.,
+            in different threads, and to be combined afterwards.  The
+            underlying statistics class must provide a merge method.
+        */
+        void merge(const GenericSequenceStatistics& other);
         //@}
       protected:
         Size dimension_ = 0;
+        bool trackCovariance_;
         std::vector<statistics_type> stats_;
         mutable std::vector<Real> results_;
         Matrix quadraticSum_;
@@ -157,7 +187,9 @@ namespace QuantLib {
     // inline definitions
 
     template <class Stat>
-    inline GenericSequenceStatistics<Stat>::GenericSequenceStatistics(Size dimension) {
+    inline GenericSequenceStatistics<Stat>::GenericSequenceStatistics(Size dimension,
+                                                                      bool trackCovariance)
+    : trackCovariance_(trackCovariance) {
         reset(dimension);
     }
 
@@ -237,14 +269,73 @@ namespace QuantLib {
                 stats_ = std::vector<Stat>(dimension);
                 results_ = std::vector<Real>(dimension);
             }
-            quadraticSum_ = Matrix(dimension_, dimension_, 0.0);
+            if (trackCovariance_)
+                quadraticSum_ = Matrix(dimension_, dimension_, 0.0);
         } else {
             dimension_ = dimension;
         }
     }
 
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::add(const Matrix& samples) {
+        add(samples, Array(samples.rows(), 1.0));
+    }
+
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::add(const Matrix& samples,
+                                              const Array& weights) {
+        QL_REQUIRE(weights.size() == samples.rows(),
+                   "weights size mismatch: " << samples.rows() <<
+                   " required, " << weights.size() << " provided");
+        if (samples.rows() == 0)
+            return;
+        if (dimension_ == 0)
+            reset(samples.columns());
+
+        QL_REQUIRE(samples.columns() == dimension_,
+                   "sample size mismatch: " << dimension_ <<
+                   " required, " << samples.columns() << " provided");
+
+        if (trackCovariance_) {
+            // rank-k update of the sum of weighted outer products
+            Matrix weighted(samples.rows(), dimension_);
+            for (Size k=0; k<samples.rows(); ++k)
+                std::transform(samples.row_begin(k), samples.row_end(k),
+                               weighted.row_begin(k),
+                               [w = weights[k]](Real x) { return w * x; });
+            quadraticSum_ += transpose(samples) * weighted;
+        }
+
+        for (Size k=0; k<samples.rows(); ++k) {
+            auto x = samples.row_begin(k);
+            for (Size i=0; i<dimension_; ++x, ++i)
+                stats_[i].add(*x, weights[k]);
+        }
+    }
+
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::merge(const GenericSequenceStatistics& other) {
+        if (other.dimension_ == 0)
+            return;
+        if (dimension_ == 0)
+            reset(other.dimension_);
+
+        QL_REQUIRE(other.dimension_ == dimension_,
+                   "sample size mismatch: " << dimension_ <<
+                   " required, " << other.dimension_ << " provided");
+        if (trackCovariance_) {
+            QL_REQUIRE(other.trackCovariance_,
+                       "cannot merge statistics without covariance");
+            quadraticSum_ += other.quadraticSum_;
+        }
+
+        for (Size i=0; i<dimension_; ++i)
+            stats_[i].merge(other.stats_[i]);
+    }
+
     template <class Stat>
     Matrix GenericSequenceStatistics<Stat>::covariance() const {
+        QL_REQUIRE(trackCovariance_, "covariance not tracked");
         Real sampleWeight = weightSum();
         QL_REQUIRE(sampleWeight > 0.0,
                    "sampleWeight=0, unsufficient");
@@ -0,0 +1,249 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/comparison.hpp>
+#include <ql/math/statistics/tdigeststatistics.hpp>
+#include <ql/mathconstants.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+
+        /* Scale function k1 of Dunning and Ertl: a centroid starting
+           at quantile q can grow up to the quantile returned here,
+           which keeps centroids small where q(1-q) is small.
+        */
+        Real quantileLimit(Real q, Real compression) {
+            const Real k = compression/(2.0*M_PI)*std::asin(2.0*q-1.0) + 1.0;
+            if (k >= compression/4.0)
+                return 1.0;
+            return 0.5*(1.0 + std::sin(2.0*M_PI*k/compression));
+        }
+
+    }
+
+    TDigestStatistics::TDigestStatistics(Real compression)
+    : compression_(compression) {
+        QL_REQUIRE(compression >= 10.0,
+                   "compression (" << compression << ") must be at least 10");
+        reset();
+    }
+
+    Real TDigestStatistics::mean() const {
+        QL_REQUIRE(weightSum_ > 0.0, "empty sample set");
+        return mean_;
+    }
+
+    Real TDigestStatistics::variance() const {
+        Size N = samples();
+        QL_REQUIRE(N > 1,
+                   "sample number <=1, unsufficient");
+        return (m2_/weightSum_)*N/(N-1.0);
+    }
+
+    Real TDigestStatistics::skewness() const {
+        Size N = samples();
+        QL_REQUIRE(N > 2,
+                   "sample number <=2, unsufficient");
+        Real X = m3_/weightSum_;
+        Real sigma = standardDeviation();
+        return (X/(sigma*sigma*sigma))*(N/(N-1.0))*(N/(N-2.0));
+    }
+
+    Real TDigestStatistics::kurtosis() const {
+        Size N = samples();
+        QL_REQUIRE(N > 3,
+                   "sample number <=3, unsufficient");
+        Real X = m4_/weightSum_;
+        Real sigma2 = variance();
+
+        Real c1 = (N/(N-1.0)) * (N/(N-2.0)) * ((N+1.0)/(N-3.0));
+        Real c2 = 3.0 * ((N-1.0)/(N-2.0)) * ((N-1.0)/(N-3.0));
+
+        return c1*(X/(sigma2*sigma2))-c2;
+    }
+
+    Real TDigestStatistics::min() const {
+        QL_REQUIRE(samples() > 0, "empty sample set");
+        return min_;
+    }
+
+    Real TDigestStatistics::max() const {
+        QL_REQUIRE(samples() > 0, "empty sample set");
+        return max_;
+    }
+
+    Real TDigestStatistics::percentile(Real percent) const {
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        return quantile(percent);
+    }
+
+    Real TDigestStatistics::topPercentile(Real percent) const {
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        return quantile(1.0-percent);
+    }
+
+    const std::vector<TDigestStatistics::Centroid>&
+    TDigestStatistics::centroids() const {
+        compress();
+        return centroids_;
+    }
+
+    void TDigestStatistics::add(Real value, Real weight) {
+        QL_REQUIRE(weight>=0.0, "negative weight not allowed");
+        ++samples_;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+        if (weight == 0.0)
+            return;
+        addMoments(weight, value, 0.0, 0.0, 0.0);
+        buffer_.push_back({value, weight, 1});
+        if (buffer_.size() >= 5*compression_)
+            compress();
+    }
+
+    void TDigestStatistics::merge(const TDigestStatistics& other) {
+        if (other.samples_ == 0)
+            return;
+        if (&other == this) {
+            TDigestStatistics copy(other);
+            merge(copy);
+            return;
+        }
+        samples_ += other.samples_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+        if (other.weightSum_ > 0.0)
+            addMoments(other.weightSum_, other.mean_,
+                       other.m2_, other.m3_, other.m4_);
+        buffer_.insert(buffer_.end(),
+                       other.centroids_.begin(), other.centroids_.end());
+        buffer_.insert(buffer_.end(),
+                       other.buffer_.begin(), other.buffer_.end());
+        if (buffer_.size() >= 5*compression_)
+            compress();
+    }
+
+    void TDigestStatistics::reset() {
+        samples_ = 0;
+        weightSum_ = mean_ = m2_ = m3_ = m4_ = 0.0;
+        min_ = QL_MAX_REAL;
+        max_ = QL_MIN_REAL;
+        centroids_.clear();
+        buffer_.clear();
+        nodes_.clear();
+    }
+
+    void TDigestStatistics::addMoments(Real wb, Real mb,
+                                       Real m2b, Real m3b, Real m4b) {
+        // pairwise update of the central moments (Pebay, 2008)
+        const Real wa = weightSum_, w = wa + wb;
+        const Real d = mb - mean_, d2 = d*d;
+        const Real m2a = m2_, m3a = m3_, m4a = m4_;
+
+        mean_ += d*wb/w;
+        m2_ = m2a + m2b + d2*wa*wb/w;
+        m3_ = m3a + m3b + d2*d*wa*wb*(wa-wb)/(w*w)
+            + 3.0*d*(wa*m2b - wb*m2a)/w;
+        m4_ = m4a + m4b + d2*d2*wa*wb*(wa*wa - wa*wb + wb*wb)/(w*w*w)
+            + 6.0*d2*(wa*wa*m2b + wb*wb*m2a)/(w*w)
+            + 4.0*d*(wa*m3b - wb*m3a)/w;
+        weightSum_ = w;
+    }
+
+    Real TDigestStatistics::quantile(Real q) const {
+        QL_REQUIRE(weightSum_ > 0.0, "empty sample set");
+        const std::vector<Centroid>& c = centroids();
+
+        // each centroid is centered on its share of the total weight;
+        // the minimum and maximum close the interpolation at both ends
+        const Real target = q*weightSum_;
+        Real cumulated = 0.5*c.front().weight;
+        if (target < cumulated)
+            return min_ + (c.front().mean - min_)*target/cumulated;
+        for (Size i=0; i+1<c.size(); ++i) {
+            const Real dw = 0.5*(c[i].weight + c[i+1].weight);
+            if (target <= cumulated + dw)
+                return c[i].mean + (c[i+1].mean - c[i].mean)*(target - cumulated)/dw;
+            cumulated += dw;
+        }
+        const Real lastHalf = 0.5*c.back().weight;
+        const Real t = std::min((target - cumulated)/lastHalf, 1.0);
+        return c.back().mean + (max_ - c.back().mean)*t;
+    }
+
+    const std::vector<std::pair<Real,Real> >& TDigestStatistics::nodes() const {
+        const std::vector<Centroid>& c = centroids();
+        if (!nodes_.empty() || c.empty())
+            return nodes_;
+
+        // the interpolation used for percentiles spreads the weight
+        // uniformly between consecutive means, and between the
+        // extreme means and the minimum and maximum; each segment is
+        // represented by a few equally weighted points
+        const Size points = 4;
+        const auto addSegment = [this](Real from, Real to, Real weight) {
+            for (Size j=0; j<points; ++j)
+                nodes_.emplace_back(from + (to-from)*(j+0.5)/points, weight/points);
+        };
+        nodes_.reserve(points*(c.size()+1));
+        addSegment(min_, c.front().mean, 0.5*c.front().weight);
+        for (Size i=0; i+1<c.size(); ++i)
+            addSegment(c[i].mean, c[i+1].mean, 0.5*(c[i].weight + c[i+1].weight));
+        addSegment(c.back().mean, max_, 0.5*c.back().weight);
+        return nodes_;
+    }
+
+    void TDigestStatistics::compress() const {
+        if (buffer_.empty())
+            return;
+        nodes_.clear();
+
+        buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+        std::sort(buffer_.begin(), buffer_.end(),
+                  [](const Centroid& a, const Centroid& b) {
+                      return a.mean < b.mean;
+                  });
+        Real total = 0.0;
+        for (const auto& b : buffer_)
+            total += b.weight;
+
+        centroids_.clear();
+        Centroid current = buffer_.front();
+        Real cumulated = 0.0;
+        Real limit = total*quantileLimit(0.0, compression_);
+        for (Size i=1; i<buffer_.size(); ++i) {
+            const Centroid& next = buffer_[i];
+            if (cumulated + current.weight + next.weight <= limit) {
+                current.weight += next.weight;
+                current.mean += (next.mean - current.mean)*next.weight/current.weight;
+                current.samples += next.samples;
+            } else {
+                cumulated += current.weight;
+                centroids_.push_back(current);
+                current = next;
+                limit = total*quantileLimit(cumulated/total, compression_);
+            }
+        }
+        centroids_.push_back(current);
+        buffer_.clear();
+    }
+
+}
@@ -0,0 +1,228 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file tdigeststatistics.hpp
+    \brief statistics tool with bounded memory based on t-digests
+*/
+
+#ifndef quantlib_t_digest_statistics_hpp
+#define quantlib_t_digest_statistics_hpp
+
+#include <ql/utilities/null.hpp>
+#include <ql/errors.hpp>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Statistics tool with bounded memory
+    /*! This class can replace GeneralStatistics when the number of
+        samples is too large for all of them to be stored, as in
+        Monte Carlo simulations of exposures over millions of paths.
+
+        Moments, minimum and maximum are accumulated exactly.  The
+        empirical distribution is summarized by a t-digest (see
+        T. Dunning and O. Ertl, "Computing extremely accurate
+        quantiles using t-digests", 2019), i.e., a set of weighted
+        centroids which is finer in the tails of the distribution;
+        their number is bounded by the compression parameter, so that
+        the memory used does not depend on the number of samples.
+        Percentiles are interpolated between centroids and are most
+        accurate at extreme levels, such as those used for
+        value-at-risk; a compression of 100 gives errors on the
+        order of 0.1% in probability terms at the median and much
+        smaller ones in the tails.
+
+        Expectation values, and thus the measures provided by
+        GenericRiskStatistics, are calculated on the distribution
+        implied by the interpolation of the centroids, which is
+        uniform between the means of consecutive ones.
+
+        Two accumulators can be merged, so that each thread of a
+        parallel simulation can collect its own samples.
+    */
+    class TDigestStatistics {
+      public:
+        typedef Real value_type;
+
+        struct Centroid {
+            Real mean;
+            Real weight;
+            Size samples;
+        };
+
+        explicit TDigestStatistics(Real compression = 200.0);
+        //! \name Inspectors
+        //@{
+        //! number of samples collected
+        Size samples() const { return samples_; }
+
+        //! sum of data weights
+        Real weightSum() const { return weightSum_; }
+
+        /*! returns the mean, defined as
+            \f[ \langle x \rangle = \frac{\sum w_i x_i}{\sum w_i}. \f]
+        */
+        Real mean() const;
+
+        /*! returns the variance, defined as
+            \f[ \sigma^2 = \frac{N}{N-1} \left\langle \left(
+                x-\langle x \rangle \right)^2 \right\rangle. \f]
+        */
+        Real variance() const;
+
+        /*! returns the standard deviation \f$ \sigma \f$, defined as the
+            square root of the variance.
+        */
+        Real standardDeviation() const;
+
+        /*! returns the error estimate on the mean value, defined as
+            \f$ \epsilon = \sigma/\sqrt{N}. \f$
+        */
+        Real errorEstimate() const;
+
+        /*! returns the skewness, defined as
+            \f[ \frac{N^2}{(N-1)(N-2)} \frac{\left\langle \left(
+                x-\langle x \rangle \right)^3 \right\rangle}{\sigma^3}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real skewness() const;
+
+        /*! returns the excess kurtosis, defined as
+            \f[ \frac{N^2(N+1)}{(N-1)(N-2)(N-3)}
+                \frac{\left\langle \left(x-\langle x \rangle \right)^4
+                \right\rangle}{\sigma^4} - \frac{3(N-1)^2}{(N-2)(N-3)}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real kurtosis() const;
+
+        /*! returns the minimum sample value */
+        Real min() const;
+
+        /*! returns the maximum sample value */
+        Real max() const;
+
+        /*! Approximate expectation value of a function \f$ f \f$ on
+            a given range; see GeneralStatistics::expectationValue.
+            The sums run over a discretization of the distribution
+            implied by the digest, consistent with the interpolation
+            used for percentiles; the number of observations returned
+            is estimated from the weight in the range.
+        */
+        template <class Func, class Predicate>
+        std::pair<Real,Size> expectationValue(const Func& f,
+                                              const Predicate& inRange) const {
+            Real num = 0.0, den = 0.0;
+            for (const auto& node : nodes()) {
+                if (inRange(node.first)) {
+                    num += f(node.first)*node.second;
+                    den += node.second;
+                }
+            }
+            if (den == 0.0)
+                return std::make_pair<Real,Size>(Null<Real>(),0);
+            auto N = Size(std::lround(samples_*den/weightSum_));
+            return std::make_pair(num/den, std::max<Size>(N,1));
+        }
+
+        /*! Approximate expectation value of a function \f$ f \f$ over
+            the whole set of samples.
+        */
+        template <class Func>
+        std::pair<Real,Size> expectationValue(const Func& f) const {
+            return expectationValue(f, [](Real) { return true; });
+        }
+
+        /*! approximate \f$ y \f$-th percentile; see
+            GeneralStatistics::percentile.
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real percentile(Real y) const;
+
+        /*! approximate \f$ y \f$-th top percentile; see
+            GeneralStatistics::topPercentile.
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real topPercentile(Real y) const;
+
+        //! compression parameter of the digest
+        Real compression() const { return compression_; }
+
+        //! centroids of the digest, sorted by mean
+        const std::vector<Centroid>& centroids() const;
+        //@}
+
+        //! \name Modifiers
+        //@{
+        //! adds a datum to the set, possibly with a weight
+        /*! \pre weights must be positive or null */
+        void add(Real value, Real weight = 1.0);
+        //! adds a sequence of data to the set, with default weight
+        template <class DataIterator>
+        void addSequence(DataIterator begin, DataIterator end) {
+            for (;begin!=end;++begin)
+                add(*begin);
+        }
+        //! adds a sequence of data to the set, each with its weight
+        template <class DataIterator, class WeightIterator>
+        void addSequence(DataIterator begin, DataIterator end,
+                         WeightIterator wbegin) {
+            for (;begin!=end;++begin,++wbegin)
+                add(*begin, *wbegin);
+        }
+
+        //! adds the samples collected by another accumulator
+        /*! The result does not depend on the order of the merges,
+            except for the grouping of samples into centroids.
+        */
+        void merge(const TDigestStatistics& other);
+
+        //! resets the data to a null set
+        void reset();
+        //@}
+      private:
+        void addMoments(Real weight, Real mean, Real m2, Real m3, Real m4);
+        Real quantile(Real q) const;
+        void compress() const;
+        const std::vector<std::pair<Real,Real> >& nodes() const;
+
+        Real compression_;
+        Size samples_;
+        Real weightSum_, mean_, m2_, m3_, m4_, min_, max_;
+        // incoming data are buffered and merged into the centroids
+        // in batches, which only requires sorting the buffer
+        mutable std::vector<Centroid> centroids_, buffer_;
+        // values and weights used for expectation values
+        mutable std::vector<std::pair<Real,Real> > nodes_;
+    };
+
+    inline Real TDigestStatistics::standardDeviation() const {
+        return std::sqrt(variance());
+    }
+
+    inline Real TDigestStatistics::errorEstimate() const {
+        return std::sqrt(variance()/samples());
+    }
+
+}
+
+
+#endif
@@ -27,6 +27,7 @@
 #include <ql/methods/finitedifferences/boundarycondition.hpp>
 #include <ql/methods/finitedifferences/operatortraits.hpp>
 #include <ql/methods/finitedifferences/stepcondition.hpp>
+#include <ql/utilities/instrumentationmacros.hpp>
 #include <utility>
 
 namespace QuantLib {
@@ -88,6 +89,8 @@ namespace QuantLib {
                           Time to,
                           Size steps,
                           const condition_type* condition) {
+            QL_INSTRUMENT_SCOPE("FiniteDifferenceModel::rollback");
+            QL_INSTRUMENT_COUNTER("FiniteDifferenceModel::steps", steps);
 
             QL_REQUIRE(from >= to,
                        "trying to roll back from " << from << " to " << to);
@@ -109,5 +109,59 @@ namespace QuantLib {
         }
     }
 
+    void BrownianBridge::transform(const Matrix& variates,
+                                   Matrix& output) const {
+        QL_REQUIRE(variates.rows() == size_,
+                   "incompatible sequence size");
+        QL_REQUIRE(&variates != &output,
+                   "input and output must be different matrices");
+        const Size n = variates.columns();
+        if (output.rows() != size_ || output.columns() != n)
+            output = Matrix(size_, n);
+        if (n == 0)
+            return;
+
+        // Same as the single-sequence version, with the loop over
+        // sequences innermost.  We use output to store the paths...
+        {
+            const Real* z = variates.row_begin(0);
+            Real* w = output.row_begin(size_-1);
+            const Real s = stdDev_[0];
+            for (Size p=0; p<n; ++p)
+                w[p] = s * z[p];
+        }
+        for (Size i=1; i<size_; ++i) {
+            Size j = leftIndex_[i];
+            Size k = rightIndex_[i];
+            Size l = bridgeIndex_[i];
+            const Real* z = variates.row_begin(i);
+            const Real* right = output.row_begin(k);
+            Real* w = output.row_begin(l);
+            const Real rw = rightWeight_[i], s = stdDev_[i];
+            if (j != 0) {
+                const Real* left = output.row_begin(j-1);
+                const Real lw = leftWeight_[i];
+                for (Size p=0; p<n; ++p)
+                    w[p] = lw * left[p] + rw * right[p] + s * z[p];
+            } else {
+                for (Size p=0; p<n; ++p)
+                    w[p] = rw * right[p] + s * z[p];
+            }
+        }
+        // ...after which, we calculate the variations and
+        // normalize to unit times
+        for (Size i=size_-1; i>=1; --i) {
+            const Real* previous = output.row_begin(i-1);
+            Real* w = output.row_begin(i);
+            const Real dt = sqrtdt_[i];
+            for (Size p=0; p<n; ++p)
+                w[p] = (w[p] - previous[p]) / dt;
+        }
+        Real* w = output.row_begin(0);
+        const Real dt = sqrtdt_[0];
+        for (Size p=0; p<n; ++p)
+            w[p] /= dt;
+    }
+
 }
 
@@ -36,6 +36,7 @@
 #ifndef quantlib_brownian_bridge_hpp
 #define quantlib_brownian_bridge_hpp
 
+#include <ql/math/matrix.hpp>
 #include <ql/methods/montecarlo/path.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
 
@@ -135,6 +136,24 @@ namespace QuantLib {
             }
             output[0] /= sqrtdt_[0];
         }
+        //! Brownian-bridge generator function for a batch of sequences
+        /*! Transforms a batch of input sequences at once.  The
+            sequences are stored by column, i.e., the i-th row of
+            \c variates contains the i-th variate of each sequence;
+            the variations are stored in \c output with the same
+            layout.  This allows the loops over the sequences to be
+            vectorized.
+
+            \param variates A matrix with size() rows and one column
+                            for each input sequence.
+            \param output   The resulting variations; it's resized if
+                            needed, and must be a different matrix
+                            than \c variates.
+
+            The results are the same that would be obtained by
+            transforming each column separately.
+        */
+        void transform(const Matrix& variates, Matrix& output) const;
       private:
         void initialize();
         Size size_;
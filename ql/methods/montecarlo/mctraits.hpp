@@ -27,6 +27,7 @@
 
 #include <ql/methods/montecarlo/pathgenerator.hpp>
 #include <ql/methods/montecarlo/multipathgenerator.hpp>
+#include <ql/methods/montecarlo/multipathmatrixgenerator.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
 
@@ -56,6 +57,17 @@ namespace QuantLib {
         enum { allowsErrorEstimate = RNG::allowsErrorEstimate };
     };
 
+    //! Monte Carlo traits for multi-variate models with contiguous paths
+    template <class RNG = PseudoRandom>
+    struct MultiVariateMatrix {
+        typedef RNG rng_traits;
+        typedef MultiPathMatrix path_type;
+        typedef PathPricer<path_type> path_pricer_type;
+        typedef typename RNG::rsg_type rsg_type;
+        typedef MultiPathMatrixGenerator<rsg_type> path_generator_type;
+        enum { allowsErrorEstimate = RNG::allowsErrorEstimate };
+    };
+
 }
 
 
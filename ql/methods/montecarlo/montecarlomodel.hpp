@@ -28,6 +28,7 @@
 #include <ql/math/statistics/statistics.hpp>
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/shared_ptr.hpp>
+#include <ql/utilities/instrumentationmacros.hpp>
 #include <utility>
 
 namespace QuantLib {
@@ -90,6 +91,8 @@ namespace QuantLib {
     // inline definitions
     template <template <class> class MC, class RNG, class S>
     inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
+        QL_INSTRUMENT_SCOPE("MonteCarloModel::addSamples");
+        QL_INSTRUMENT_COUNTER("MonteCarloModel::samples", samples);
         for(Size j = 1; j <= samples; j++) {
 
             const sample_type& path = pathGenerator_->next();
@@ -0,0 +1,114 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multipathmatrix.hpp
+    \brief Correlated multiple asset paths in contiguous storage
+*/
+
+#ifndef quantlib_montecarlo_multi_path_matrix_hpp
+#define quantlib_montecarlo_multi_path_matrix_hpp
+
+#include <ql/math/matrix.hpp>
+#include <ql/methods/montecarlo/multipath.hpp>
+#include <ql/methods/montecarlo/pathpricer.hpp>
+#include <ql/shared_ptr.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Correlated multiple asset paths in contiguous storage
+    /*! The values of all paths are stored in a single matrix with one
+        row per asset, so that multipath[j][i] is the value of the
+        j-th asset at the i-th time; the time grid is shared by all
+        assets and by the copies of the instance.  This avoids the
+        separate allocations and time-grid copies of MultiPath, which
+        become significant for baskets of many assets.
+
+        Pricers written for MultiPath can be used on these paths
+        through the MultiPathPricerAdapter class.
+
+        \ingroup mcarlo
+    */
+    class MultiPathMatrix {
+      public:
+        MultiPathMatrix() = default;
+        MultiPathMatrix(Size nAsset, const TimeGrid& timeGrid);
+        //! \name inspectors
+        //@{
+        Size assetNumber() const { return values_.rows(); }
+        Size pathSize() const { return values_.columns(); }
+        const TimeGrid& timeGrid() const { return *timeGrid_; }
+        //! path values, one row per asset
+        const Matrix& values() const { return values_; }
+        //@}
+        //! \name read/write access to components
+        //@{
+        //! values of the path followed by the j-th asset
+        Matrix::const_row_iterator operator[](Size j) const { return values_[j]; }
+        Matrix::row_iterator operator[](Size j) { return values_[j]; }
+        Matrix& values() { return values_; }
+        //@}
+      private:
+        ext::shared_ptr<const TimeGrid> timeGrid_;
+        Matrix values_;
+    };
+
+
+    //! Prices MultiPathMatrix samples with a MultiPath pricer
+    /*! The values are copied into a MultiPath allocated once and
+        reused for all the following samples with the same layout.
+
+        \ingroup mcarlo
+    */
+    class MultiPathPricerAdapter : public PathPricer<MultiPathMatrix> {
+      public:
+        explicit MultiPathPricerAdapter(ext::shared_ptr<PathPricer<MultiPath> > pricer)
+        : pricer_(std::move(pricer)) {}
+        Real operator()(const MultiPathMatrix& multiPath) const override;
+      private:
+        ext::shared_ptr<PathPricer<MultiPath> > pricer_;
+        mutable MultiPath multiPath_;
+    };
+
+
+    // inline definitions
+
+    inline MultiPathMatrix::MultiPathMatrix(Size nAsset, const TimeGrid& timeGrid)
+    : timeGrid_(ext::make_shared<const TimeGrid>(timeGrid)),
+      values_(nAsset, timeGrid.size()) {
+        QL_REQUIRE(nAsset > 0, "number of asset must be positive");
+    }
+
+    inline Real MultiPathPricerAdapter::operator()(const MultiPathMatrix& multiPath) const {
+        Size n = multiPath.assetNumber();
+        QL_REQUIRE(n > 0, "no asset given");
+        const TimeGrid& grid = multiPath.timeGrid();
+        if (multiPath_.assetNumber() != n ||
+            multiPath_.pathSize() != grid.size() ||
+            !std::equal(grid.begin(), grid.end(), multiPath_[0].timeGrid().begin()))
+            multiPath_ = MultiPath(n, grid);
+        for (Size j=0; j<n; ++j)
+            std::copy(multiPath[j], multiPath[j] + multiPath.pathSize(),
+                      &multiPath_[j][0]);
+        return (*pricer_)(multiPath_);
+    }
+
+}
+
+
+#endif
@@ -0,0 +1,138 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multipathmatrixgenerator.hpp
+    \brief Generates contiguous multi paths from a random-array generator
+*/
+
+#ifndef quantlib_multi_path_matrix_generator_hpp
+#define quantlib_multi_path_matrix_generator_hpp
+
+#include <ql/methods/montecarlo/multipathmatrix.hpp>
+#include <ql/methods/montecarlo/sample.hpp>
+#include <ql/stochasticprocess.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Generates a contiguous multipath from a random number generator.
+    /*! This class generates the same paths as MultiPathGenerator
+        and stores them in a MultiPathMatrix.  The storage of the
+        paths and the buffers for the random increments are
+        allocated once at construction; the initial values of the
+        process are also read at construction.
+
+        \ingroup mcarlo
+
+        \test the generated paths are checked against the ones
+              returned by MultiPathGenerator.
+    */
+    template <class GSG>
+    class MultiPathMatrixGenerator {
+      public:
+        typedef Sample<MultiPathMatrix> sample_type;
+        MultiPathMatrixGenerator(const ext::shared_ptr<StochasticProcess>&,
+                                 const TimeGrid&,
+                                 GSG generator,
+                                 bool brownianBridge = false);
+        const sample_type& next() const;
+        const sample_type& antithetic() const;
+      private:
+        const sample_type& next(bool antithetic) const;
+        bool brownianBridge_;
+        ext::shared_ptr<StochasticProcess> process_;
+        GSG generator_;
+        Array initialValues_;
+        mutable Array asset_, dw_;
+        mutable sample_type next_;
+    };
+
+
+    // template definitions
+
+    template <class GSG>
+    MultiPathMatrixGenerator<GSG>::MultiPathMatrixGenerator(
+                                const ext::shared_ptr<StochasticProcess>& process,
+                                const TimeGrid& times,
+                                GSG generator,
+                                bool brownianBridge)
+    : brownianBridge_(brownianBridge), process_(process), generator_(std::move(generator)),
+      initialValues_(process->initialValues()), dw_(process->factors()),
+      next_(MultiPathMatrix(process->size(), times), 1.0) {
+
+        QL_REQUIRE(generator_.dimension() ==
+                   process->factors()*(times.size()-1),
+                   "dimension (" << generator_.dimension()
+                   << ") is not equal to ("
+                   << process->factors() << " * " << times.size()-1
+                   << ") the number of factors "
+                   << "times the number of time steps");
+        QL_REQUIRE(times.size() > 1,
+                   "no times given");
+    }
+
+    template <class GSG>
+    inline const typename MultiPathMatrixGenerator<GSG>::sample_type&
+    MultiPathMatrixGenerator<GSG>::next() const {
+        return next(false);
+    }
+
+    template <class GSG>
+    inline const typename MultiPathMatrixGenerator<GSG>::sample_type&
+    MultiPathMatrixGenerator<GSG>::antithetic() const {
+        return next(true);
+    }
+
+    template <class GSG>
+    const typename MultiPathMatrixGenerator<GSG>::sample_type&
+    MultiPathMatrixGenerator<GSG>::next(bool antithetic) const {
+
+        QL_REQUIRE(!brownianBridge_, "Brownian bridge not supported");
+
+        typedef typename GSG::sample_type sequence_type;
+        const sequence_type& sequence_ =
+            antithetic ? generator_.lastSequence()
+                       : generator_.nextSequence();
+
+        Size m = process_->size();
+        Size n = process_->factors();
+
+        MultiPathMatrix& path = next_.value;
+        next_.weight = sequence_.weight;
+
+        asset_ = initialValues_;
+        for (Size j=0; j<m; j++)
+            path[j][0] = asset_[j];
+
+        const TimeGrid& timeGrid = path.timeGrid();
+        for (Size i = 1; i < path.pathSize(); i++) {
+            auto dw = sequence_.value.begin() + (i-1)*n;
+            if (antithetic)
+                std::transform(dw, dw+n, dw_.begin(), std::negate<>());
+            else
+                std::copy(dw, dw+n, dw_.begin());
+
+            asset_ = process_->evolve(timeGrid[i-1], asset_, timeGrid.dt(i-1), dw_);
+            for (Size j=0; j<m; j++)
+                path[j][i] = asset_[j];
+        }
+        return next_;
+    }
+
+}
+
+#endif
@@ -112,10 +112,23 @@ namespace QuantLib {
     void AccountingEngine::multiplePathValues(SequenceStatisticsInc& stats,
                                               Size numberOfPaths)
     {
+        // paths are added in batches, so that the covariance of the
+        // values is accumulated by matrix products
+        const Size batchSize = 256;
         std::vector<Real> values(product_->numberOfProducts());
-        for (Size i=0; i<numberOfPaths; ++i) {
-            Real weight = singlePathValues(values);
-            stats.add(values,weight);
+        Matrix batch;
+        Array weights;
+        for (Size done=0; done<numberOfPaths; done+=batch.rows()) {
+            Size n = std::min(batchSize, numberOfPaths-done);
+            if (batch.rows() != n) {
+                batch = Matrix(n, values.size());
+                weights = Array(n);
+            }
+            for (Size k=0; k<n; ++k) {
+                weights[k] = singlePathValues(values);
+                std::copy(values.begin(), values.end(), batch.row_begin(k));
+            }
+            stats.add(batch, weights);
         }
     }
 
@@ -19,6 +19,7 @@
 
 #include <ql/models/marketmodels/browniangenerators/sobolbrowniangenerator.hpp>
 #include <boost/iterator/permutation_iterator.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -160,26 +161,27 @@ namespace QuantLib {
 
         const Size dim    = factors_*steps_;
         const Size nPaths = variates.front().size();
-        
+
+        for (Size k=0; k < dim; ++k)
+            QL_REQUIRE(variates[k].size() == nPaths,
+                       "inconsistent number of paths");
+
         std::vector<std::vector<Real> > 
                        retVal(factors_, std::vector<Real>(nPaths*steps_));
-        
-        for (Size j=0; j < nPaths; ++j) {
-            std::vector<Real> sample(steps_*factors_);
-            for (Size k=0; k < dim; ++k) {
-                sample[k] = variates[k][j];
-            }
-            for (Size i=0; i<factors_; ++i) {
-                bridge_.transform(boost::make_permutation_iterator(
-                                                  sample.begin(),
-                                                  orderedIndices_[i].begin()),
-                          boost::make_permutation_iterator(
-                                                  sample.begin(),
-                                                  orderedIndices_[i].end()),
-                          retVal[i].begin()+j*steps_);
+
+        // all the paths are bridged at once for each factor
+        Matrix sample(steps_, nPaths), bridged(steps_, nPaths);
+        for (Size i=0; i<factors_; ++i) {
+            for (Size k=0; k < steps_; ++k) {
+                const std::vector<Real>& v = variates[orderedIndices_[i][k]];
+                std::copy(v.begin(), v.end(), sample.row_begin(k));
             }
+            bridge_.transform(sample, bridged);
+            for (Size j=0; j < nPaths; ++j)
+                for (Size k=0; k < steps_; ++k)
+                    retVal[i][j*steps_+k] = bridged[k][j];
         }
-        
+
         return retVal;
     }
 
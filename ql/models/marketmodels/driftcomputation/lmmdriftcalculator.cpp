@@ -34,7 +34,7 @@ namespace QuantLib {
     : numberOfRates_(taus.size()), numberOfFactors_(pseudo.columns()),
       isFullFactor_(numberOfFactors_ == numberOfRates_), numeraire_(numeraire), alive_(alive),
       displacements_(displacements), oneOverTaus_(taus.size()), pseudo_(pseudo),
-      tmp_(taus.size(), 0.0), e_(pseudo_.columns(), pseudo_.rows(), 0.0), downs_(taus.size()),
+      tmp_(taus.size(), 0.0), e_(pseudo_.rows(), pseudo_.columns(), 0.0), downs_(taus.size()),
       ups_(taus.size()) {
 
         // Check requirements
@@ -126,8 +126,8 @@ namespace QuantLib {
                 (oneOverTaus_[i]+forwards[i]);
 
         // Enforce initialization
-        for (Size r=0; r<numberOfFactors_; ++r)
-            e_[r][std::max(0,static_cast<Integer>(numeraire_)-1)] = 0.0;
+        if (numeraire_>0)
+            std::fill(e_.row_begin(numeraire_-1), e_.row_end(numeraire_-1), 0.0);
 
         // Now compute drifts: take the numeraire P_N (numeraire_=N)
         // as the reference point, divide the summation into 3 steps,
@@ -137,44 +137,49 @@ namespace QuantLib {
         // (if N=0 no drift is null, if N=numberOfRates_ the last drift is null).
         if (numeraire_>0) drifts[numeraire_-1] = 0.0;
 
+        // Both e_ and pseudo_ are stored rate-major, so that the loops
+        // on factors below run over contiguous memory and can be
+        // vectorized by the compiler.
+
         // 2nd step: then, move backward from N-2 (included) back to
         // alive (included) (if N=0 jumps to 3rd step, if N=numberOfRates_ the
-        // e_[r][N-1] are correctly initialized):
+        // e_[N-1][r] are correctly initialized):
 
         for (Integer i=static_cast<Integer>(numeraire_)-2;
              i>=static_cast<Integer>(alive_); --i) {
-            drifts[i] = 0.0;
+            Real* ei = e_.row_begin(i);
+            const Real* ei1 = e_.row_begin(i+1);
+            const Real* ai = pseudo_.row_begin(i);
+            const Real* ai1 = pseudo_.row_begin(i+1);
+            const Real x = tmp_[i+1];
+            Real drift = 0.0;
             for (Size r=0; r<numberOfFactors_; ++r) {
-                e_[r][i] = e_[r][i+1] + tmp_[i+1] * pseudo_[i+1][r];
-                drifts[i] -= e_[r][i]*pseudo_[i][r];
-            }
-
-            /*
-            Matrix::column_iterator p1 = e_.column_begin(i);
-            Matrix::column_iterator end = e_.column_end(i);
-            Matrix::const_column_iterator p2 = e_.column_begin(i+1);
-            Matrix::const_row_iterator q1 = pseudo_.row_begin(i);
-            Matrix::const_row_iterator q2 = pseudo_.row_begin(i+1);
-            Real x = tmp_[i+1];
-            while (p1 != end) {
-                *p1 = *p2 + x*(*q2);
-                drifts[i] -= *p1*(*q1);
-                ++p1; ++p2; ++q1; ++q2;
+                ei[r] = ei1[r] + x * ai1[r];
+                drift -= ei[r]*ai[r];
             }
-            */
+            drifts[i] = drift;
         }
 
         // 3rd step: now, move forward from N (included) up to n (excluded)
         // (if N=0 this is the only relevant computation):
         for (Size i=numeraire_; i<numberOfRates_; ++i) {
-            drifts[i] = 0.0;
-            for (Size r=0; r<numberOfFactors_; ++r) {
-                if (i==0)
-                    e_[r][i] = tmp_[i] * pseudo_[i][r];
-                else
-                    e_[r][i] = e_[r][i-1] + tmp_[i] * pseudo_[i][r];
-                drifts[i] += e_[r][i]*pseudo_[i][r];
+            Real* ei = e_.row_begin(i);
+            const Real* ai = pseudo_.row_begin(i);
+            const Real x = tmp_[i];
+            Real drift = 0.0;
+            if (i==0) {
+                for (Size r=0; r<numberOfFactors_; ++r) {
+                    ei[r] = x * ai[r];
+                    drift += ei[r]*ai[r];
+                }
+            } else {
+                const Real* ei1 = e_.row_begin(i-1);
+                for (Size r=0; r<numberOfFactors_; ++r) {
+                    ei[r] = ei1[r] + x * ai[r];
+                    drift += ei[r]*ai[r];
+                }
             }
+            drifts[i] = drift;
         }
     }
 
@@ -73,6 +73,7 @@ namespace QuantLib {
         Matrix C_, pseudo_;
         // temporary variables to be added later
         mutable std::vector<Real> tmp_;
+        // rates x factors, i.e., laid out as pseudo_
         mutable Matrix e_;
         std::vector<Size> downs_, ups_;
     };
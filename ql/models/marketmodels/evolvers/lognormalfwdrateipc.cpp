@@ -119,9 +119,10 @@ namespace QuantLib {
         Integer alive = alive_[currentStep_];
         Real drifts2;
         for (Integer i=numberOfRates_-1; i>=alive; --i) {
+            const Real* Ci = C.row_begin(i);
             drifts2 = 0.0;
             for (Size j=i+1; j<numberOfRates_; ++j) {
-                drifts2 -= g_[j]*C[i][j];
+                drifts2 -= g_[j]*Ci[j];
             }
             logForwards_[i] += 0.5*(drifts1_[i]+drifts2) + fixedDrift[i];
             logForwards_[i] +=
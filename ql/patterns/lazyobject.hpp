@@ -26,6 +26,7 @@
 
 #include <ql/patterns/observable.hpp>
 #include <ql/shared_ptr.hpp>
+#include <ql/utilities/instrumentationmacros.hpp>
 
 namespace QuantLib {
 
@@ -255,6 +256,7 @@ namespace QuantLib {
             calculated_ = true;   // prevent infinite recursion in
                                   // case of bootstrapping
             try {
+                QL_INSTRUMENT_SCOPE("LazyObject::performCalculations");
                 performCalculations();
             } catch (...) {
                 calculated_ = false;
@@ -418,9 +418,9 @@ namespace QuantLib {
                    "non tradable at " << settlement <<
                    " (maturity being " << bond.maturityDate() << ")");
 
-        return CashFlows::duration(bond.cashflows(), yield,
-                                   type,
-                                   false, settlement);
+        return bond.compiledCashflows()->duration(yield,
+                                                  type,
+                                                  false, settlement);
     }
 
     Time BondFunctions::duration(const Bond& bond,
@@ -43,11 +43,21 @@ namespace QuantLib {
                                        *includeSettlementDateFlows_ :
                                        Settings::instance().includeReferenceDateEvents();
 
-        results_.value = CashFlows::npv(arguments_.cashflows,
-                                        **discountCurve_,
-                                        includeRefDateFlows,
-                                        results_.valuationDate,
-                                        results_.valuationDate);
+        const CompiledLeg* compiled = arguments_.compiledCashflows.get();
+        auto npv = [&](bool includeSettlementDateFlows,
+                       const Date& settlementDate) {
+            if (compiled != nullptr)
+                return compiled->npv(**discountCurve_,
+                                     includeSettlementDateFlows,
+                                     settlementDate, settlementDate);
+            else
+                return CashFlows::npv(arguments_.cashflows,
+                                      **discountCurve_,
+                                      includeSettlementDateFlows,
+                                      settlementDate, settlementDate);
+        };
+
+        results_.value = npv(includeRefDateFlows, results_.valuationDate);
 
         // a bond's cashflow on settlement date is never taken into
         // account, so we might have to play it safe and recalculate
@@ -58,11 +68,7 @@ namespace QuantLib {
         } else {
             // no such luck
             results_.settlementValue =
-                CashFlows::npv(arguments_.cashflows,
-                               **discountCurve_,
-                               false,
-                               arguments_.settlementDate,
-                               arguments_.settlementDate);
+                npv(false, arguments_.settlementDate);
         }
     }
 
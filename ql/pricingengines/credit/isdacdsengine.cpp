@@ -29,6 +29,8 @@
 #include <ql/time/calendars/weekendsonly.hpp>
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/optional.hpp>
+#include <map>
+#include <tuple>
 #include <utility>
 
 namespace QuantLib {
@@ -43,13 +45,192 @@ namespace QuantLib {
     : probability_(std::move(probability)), recoveryRate_(recoveryRate),
       discountCurve_(std::move(discountCurve)),
       includeSettlementDateFlows_(includeSettlementDateFlows), numericalFix_(numericalFix),
-      accrualBias_(accrualBias), forwardsInCouponPeriod_(forwardsInCouponPeriod) {
+      accrualBias_(accrualBias), forwardsInCouponPeriod_(forwardsInCouponPeriod),
+      nodeValues_(ext::make_shared<NodeValues>(discountCurve_, probability_)) {
 
         registerWith(probability_);
         registerWith(discountCurve_);
     }
 
+    // Curve values used by the engine.  They are memoized by date and
+    // kept between calculations, so that the tenors of a name (or the
+    // iterations of a bootstrap) don't evaluate the curves and the
+    // default-accrual integrals again.  The dates queried by a swap
+    // are a few per coupon period, so they are stored in a vector
+    // sorted by date rather than indexed by day.  Integration nodes
+    // need both curves; other dates (coupon payments and the days
+    // before them) only query the curve they need, so that the curves
+    // don't need to cover more dates than with a direct evaluation.
+    //
+    // The cache is cleared when the curves notify a change; however,
+    // curves being bootstrapped change without notifying, so the
+    // values at the nodes are also checked before each calculation.
+    // Since the engine requires curves which are flat-forward between
+    // their nodes, the values at any date only depend on those at the
+    // enclosing nodes: when a node changes, the cached values after
+    // the previous node are dropped and the others can be kept.
+    class IsdaCdsEngine::NodeValues {
+      public:
+        struct Values {
+            Time t = Null<Time>();
+            DiscountFactor P = Null<Real>();
+            Probability Q = Null<Real>();
+            Real logP = Null<Real>(), logQ = Null<Real>();
+        };
+        NodeValues(const Handle<YieldTermStructure>& discountCurve,
+                   const Handle<DefaultProbabilityTermStructure>& probability)
+        : discountCurve_(discountCurve), probability_(probability) {}
+        const std::vector<Date>& nodes() const { return nodes_; }
+        //! drops all cached values
+        void reset() {
+            nodes_.clear();
+            referenceDate_ = Date();
+            values_.clear();
+            defaultAccruals_.clear();
+        }
+        //! checks the cached values for a calculation up to the given date
+        void update(std::vector<Date> nodes, const Date& lastDate) {
+            Date referenceDate = discountCurve_->referenceDate();
+            if (referenceDate != referenceDate_ || nodes != nodes_) {
+                reset();
+                nodes_ = std::move(nodes);
+                referenceDate_ = referenceDate;
+            }
+            // the nodes up to the first one after the last date are
+            // enough to determine the curves; failing that, the last
+            // date itself is checked
+            auto last = std::lower_bound(nodes_.begin(), nodes_.end(), lastDate);
+            Date previous = referenceDate_;
+            for (auto node = nodes_.begin(); node != last; ++node)
+                check(*node, previous);
+            check(last != nodes_.end() ? *last : lastDate, previous);
+        }
+        //! both curves at an integration node
+        const Values& operator()(const Date& d) {
+            Values& x = entry(d);
+            if (x.t == Null<Time>())
+                x.t = discountCurve_->timeFromReference(d);
+            if (x.logP == Null<Real>())
+                x.logP = std::log(discount(x, d));
+            if (x.logQ == Null<Real>())
+                x.logQ = std::log(survivalProbability(x, d));
+            return x;
+        }
+        DiscountFactor discount(const Date& d) {
+            return discount(entry(d), d);
+        }
+        Probability survivalProbability(const Date& d) {
+            return survivalProbability(entry(d), d);
+        }
+        /* default accrual per unit of notional and rate over a coupon
+           period, identified by accrual start, integration start and
+           integration end; it's set to Null<Real>() if not available. */
+        Real& defaultAccrual(const Date& accrualStart, const Date& start, const Date& end) {
+            return defaultAccruals_.insert(
+                std::make_pair(std::make_tuple(end, accrualStart, start),
+                               Null<Real>())).first->second;
+        }
+      private:
+        typedef std::pair<Date, Values> Entry;
+        static bool before(const Entry& e, const Date& d) { return e.first < d; }
+        Values& entry(const Date& d) {
+            // queries come mostly in increasing date order
+            if (values_.empty() || values_.back().first < d) {
+                values_.emplace_back(d, Values());
+                return values_.back().second;
+            }
+            auto i = std::lower_bound(values_.begin(), values_.end(), d, before);
+            if (i->first != d)
+                i = values_.insert(i, Entry(d, Values()));
+            return i->second;
+        }
+        DiscountFactor discount(Values& x, const Date& d) {
+            if (x.P == Null<Real>())
+                x.P = discountCurve_->discount(d);
+            return x.P;
+        }
+        Probability survivalProbability(Values& x, const Date& d) {
+            if (x.Q == Null<Real>())
+                x.Q = probability_->survivalProbability(d);
+            return x.Q;
+        }
+        // compares the cached values at d with the curves, dropping
+        // the ones after the previous checked date if they changed
+        void check(const Date& d, Date& previous) {
+            if (d <= referenceDate_)
+                return;
+            DiscountFactor P = discountCurve_->discount(d);
+            Probability Q = probability_->survivalProbability(d);
+            Values& x = entry(d);
+            if (x.P != P || x.Q != Q) {
+                truncate(previous);
+                Values& y = entry(d);
+                y.P = P;
+                y.Q = Q;
+            }
+            previous = d;
+        }
+        // drops the cached values after the given date
+        void truncate(const Date& d) {
+            values_.erase(std::upper_bound(values_.begin(), values_.end(), d,
+                                           [](const Date& d, const Entry& e) {
+                                               return d < e.first;
+                                           }),
+                          values_.end());
+            defaultAccruals_.erase(
+                defaultAccruals_.upper_bound(std::make_tuple(d, Date::maxDate(), Date::maxDate())),
+                defaultAccruals_.end());
+        }
+        const Handle<YieldTermStructure>& discountCurve_;
+        const Handle<DefaultProbabilityTermStructure>& probability_;
+        std::vector<Date> nodes_;
+        Date referenceDate_;
+        std::vector<Entry> values_;
+        // keyed by integration end first, so that they can be truncated
+        std::map<std::tuple<Date, Date, Date>, Real> defaultAccruals_;
+    };
+
+    void IsdaCdsEngine::update() {
+        nodeValues_->reset();
+        CreditDefaultSwap::engine::update();
+    }
+
     void IsdaCdsEngine::calculate() const {
+        calculate(arguments_, results_, nodeValues(lastDate(arguments_)));
+    }
+
+    std::vector<CreditDefaultSwap::results> IsdaCdsEngine::calculate(
+        const std::vector<ext::shared_ptr<CreditDefaultSwap> >& swaps) const {
+        std::vector<CreditDefaultSwap::arguments> arguments(swaps.size());
+        Date last;
+        for (Size i=0; i<swaps.size(); ++i) {
+            QL_REQUIRE(swaps[i], "null credit default swap given");
+            swaps[i]->setupArguments(&arguments[i]);
+            arguments[i].validate();
+            last = std::max(last, lastDate(arguments[i]));
+        }
+        NodeValues& values = nodeValues(last);
+        std::vector<CreditDefaultSwap::results> results(swaps.size());
+        for (Size i=0; i<swaps.size(); ++i) {
+            results[i].reset();
+            calculate(arguments[i], results[i], values);
+        }
+        return results;
+    }
+
+    Date IsdaCdsEngine::lastDate(const CreditDefaultSwap::arguments& arguments) {
+        Date last = arguments.maturity;
+        for (const auto& cf : arguments.leg)
+            last = std::max(last, cf->date());
+        return last;
+    }
+
+    IsdaCdsEngine::NodeValues& IsdaCdsEngine::nodeValues(const Date& lastDate) const {
+        nodeValues_->update(integrationNodes(), lastDate);
+        return *nodeValues_;
+    }
+
+    std::vector<Date> IsdaCdsEngine::integrationNodes() const {
 
         QL_REQUIRE(numericalFix_ == None || numericalFix_ == Taylor,
                    "numerical fix must be None or Taylor");
@@ -64,8 +245,6 @@ namespace QuantLib {
         // so we just forbid them too
 
         Actual365Fixed dc;
-        Actual360 dc1;
-        Actual360 dc2(true);
 
         Date evalDate = Settings::instance().evaluationDate();
 
@@ -90,20 +269,9 @@ namespace QuantLib {
                    "probability term structure reference date ("
                        << probability_->referenceDate()
                        << " should be evaluation date (" << evalDate << ")");
-        QL_REQUIRE(arguments_.settlesAccrual,
-                   "ISDA engine not compatible with non accrual paying CDS");
-        QL_REQUIRE(arguments_.paysAtDefaultTime,
-                   "ISDA engine not compatible with end period payment");
-        QL_REQUIRE(ext::dynamic_pointer_cast<FaceValueClaim>(arguments_.claim) != nullptr,
-                   "ISDA engine not compatible with non face value claim");
-
-        Date maturity = arguments_.maturity;
-        Date effectiveProtectionStart =
-            std::max<Date>(arguments_.protectionStart, evalDate + 1);
 
         // collect nodes from both curves and sort them
         std::vector<Date> yDates, cDates;
-
         // the calls to dates() below might not trigger bootstrap (because
         // they will call the InterpolatedCurve methods, not the ones from
         // PiecewiseYieldCurve or PiecewiseDefaultCurve) so we force it here
@@ -149,19 +317,42 @@ namespace QuantLib {
 
         std::vector<Date> nodes;
         std::set_union(yDates.begin(), yDates.end(), cDates.begin(), cDates.end(), std::back_inserter(nodes));
+        return nodes;
+    }
 
+    void IsdaCdsEngine::calculate(const CreditDefaultSwap::arguments& arguments,
+                                  CreditDefaultSwap::results& results,
+                                  NodeValues& values) const {
+
+        Actual365Fixed dc;
+        Actual360 dc1;
+        Actual360 dc2(true);
+
+        Date evalDate = Settings::instance().evaluationDate();
+
+        QL_REQUIRE(arguments.settlesAccrual,
+                   "ISDA engine not compatible with non accrual paying CDS");
+        QL_REQUIRE(arguments.paysAtDefaultTime,
+                   "ISDA engine not compatible with end period payment");
+        QL_REQUIRE(ext::dynamic_pointer_cast<FaceValueClaim>(arguments.claim) != nullptr,
+                   "ISDA engine not compatible with non face value claim");
+
+        Date maturity = arguments.maturity;
+        Date effectiveProtectionStart =
+            std::max<Date>(arguments.protectionStart, evalDate + 1);
+
+        std::vector<Date> maturityNode;
+        if (values.nodes().empty())
+            maturityNode.push_back(maturity);
+        const std::vector<Date>& nodes =
+            maturityNode.empty() ? values.nodes() : maturityNode;
 
-        if(nodes.empty()){
-            nodes.push_back(maturity);
-        }
         const Real nFix = (numericalFix_ == None ? 1E-50 : 0.0);
 
         // protection leg pricing (npv is always negative at this stage)
         Real protectionNpv = 0.0;
 
-        Date d0 = effectiveProtectionStart-1;
-        Real P0 = discountCurve_->discount(d0);
-        Real Q0 = probability_->survivalProbability(d0);
+        NodeValues::Values v0 = values(effectiveProtectionStart-1);
         Date d1;
         auto it =
             std::upper_bound(nodes.begin(), nodes.end(), effectiveProtectionStart);
@@ -173,11 +364,11 @@ namespace QuantLib {
             } else {
                 d1 = *it;
             }
-            Real P1 = discountCurve_->discount(d1);
-            Real Q1 = probability_->survivalProbability(d1);
+            NodeValues::Values v1 = values(d1);
+            Real P0 = v0.P, Q0 = v0.Q, P1 = v1.P, Q1 = v1.Q;
 
-            Real fhat = std::log(P0) - std::log(P1);
-            Real hhat = std::log(Q0) - std::log(Q1);
+            Real fhat = v0.logP - v1.logP;
+            Real hhat = v0.logQ - v1.logQ;
             Real fhphh = fhat + hhat;
 
             if (fhphh < 1E-4 && numericalFix_ == Taylor) {
@@ -189,19 +380,17 @@ namespace QuantLib {
             } else {
                 protectionNpv += hhat / (fhphh + nFix) * (P0 * Q0 - P1 * Q1);
             }
-            d0 = d1;
-            P0 = P1;
-            Q0 = Q1;
+            v0 = v1;
         }
-        protectionNpv *= arguments_.claim->amount(
-            Null<Date>(), arguments_.notional, recoveryRate_);
+        protectionNpv *= arguments.claim->amount(
+            Null<Date>(), arguments.notional, recoveryRate_);
 
-        results_.defaultLegNPV = protectionNpv;
+        results.defaultLegNPV = protectionNpv;
 
         // premium leg pricing (npv is always positive at this stage)
 
         Real premiumNpv = 0.0, defaultAccrualNpv = 0.0;
-        for (auto& i : arguments_.leg) {
+        for (auto& i : arguments.leg) {
             ext::shared_ptr<FixedRateCoupon> coupon = ext::dynamic_pointer_cast<FixedRateCoupon>(i);
 
             QL_REQUIRE(coupon->dayCounter() == dc ||
@@ -214,8 +403,8 @@ namespace QuantLib {
             if (!i->hasOccurred(effectiveProtectionStart, includeSettlementDateFlows_)) {
                 premiumNpv +=
                     coupon->amount() *
-                    discountCurve_->discount(coupon->date()) *
-                    probability_->survivalProbability(coupon->date()-1);
+                    values.discount(coupon->date()) *
+                    values.survivalProbability(coupon->date()-1);
             }
 
             // default accruals
@@ -225,142 +414,143 @@ namespace QuantLib {
                 Date start = std::max<Date>(coupon->accrualStartDate(),
                                             effectiveProtectionStart)-1;
                 Date end = coupon->date()-1;
-                Real tstart =
-                    discountCurve_->timeFromReference(coupon->accrualStartDate()-1) -
-                    (accrualBias_ == HalfDayBias ? 1.0 / 730.0 : 0.0);
-                std::vector<Date> localNodes;
-                localNodes.push_back(start);
-                //add intermediary nodes, if any
-                if (forwardsInCouponPeriod_ == Piecewise) {
-                    auto it0 =
-                        std::upper_bound(nodes.begin(), nodes.end(), start);
-                    auto it1 =
-                        std::lower_bound(nodes.begin(), nodes.end(), end);
-                    localNodes.insert(localNodes.end(), it0, it1);
-                }
-                localNodes.push_back(end);
-
-                Real defaultAccrThisNode = 0.;
-                auto node = localNodes.begin();
-                Real t0 = discountCurve_->timeFromReference(*node);
-                Real P0 = discountCurve_->discount(*node);
-                Real Q0 = probability_->survivalProbability(*node);
-
-                for (++node; node != localNodes.end(); ++node) {
-                    Real t1 = discountCurve_->timeFromReference(*node);
-                    Real P1 = discountCurve_->discount(*node);
-                    Real Q1 = probability_->survivalProbability(*node);
-                    Real fhat = std::log(P0) - std::log(P1);
-                    Real hhat = std::log(Q0) - std::log(Q1);
-                    Real fhphh = fhat + hhat;
-                    if (fhphh < 1E-4 && numericalFix_ == Taylor) {
-                        // see above, terms up to (f+h)^3 seem more than enough,
-                        // what exactly is implemented in the standard isda C
-                        // code ?
-                        Real fhphhq = fhphh * fhphh;
-                        defaultAccrThisNode +=
-                            hhat * P0 * Q0 *
-                            ((t0 - tstart) *
-                                 (1.0 - 0.5 * fhphh + 1.0 / 6.0 * fhphhq -
-                                  1.0 / 24.0 * fhphhq * fhphh) +
-                             (t1 - t0) *
-                                 (0.5 - 1.0 / 3.0 * fhphh + 1.0 / 8.0 * fhphhq -
-                                  1.0 / 30.0 * fhphhq * fhphh));
-                    } else {
-                        defaultAccrThisNode +=
-                            (hhat / (fhphh + nFix)) *
-                            ((t1 - t0) * ((P0 * Q0 - P1 * Q1) / (fhphh + nFix) -
-                                          P1 * Q1) +
-                             (t0 - tstart) * (P0 * Q0 - P1 * Q1));
+                Real& defaultAccrThisNode =
+                    values.defaultAccrual(coupon->accrualStartDate(), start, end);
+                if (defaultAccrThisNode == Null<Real>()) {
+                    defaultAccrThisNode = 0.0;
+                    // the accrual start can precede the curve reference date,
+                    // so only its time is needed (and can be computed)
+                    Real tstart =
+                        discountCurve_->timeFromReference(coupon->accrualStartDate()-1) -
+                        (accrualBias_ == HalfDayBias ? 1.0 / 730.0 : 0.0);
+                    std::vector<Date> localNodes;
+                    localNodes.push_back(start);
+                    //add intermediary nodes, if any
+                    if (forwardsInCouponPeriod_ == Piecewise) {
+                        auto it0 =
+                            std::upper_bound(nodes.begin(), nodes.end(), start);
+                        auto it1 =
+                            std::lower_bound(nodes.begin(), nodes.end(), end);
+                        localNodes.insert(localNodes.end(), it0, it1);
+                    }
+                    localNodes.push_back(end);
+
+                    auto node = localNodes.begin();
+                    NodeValues::Values v0 = values(*node);
+
+                    for (++node; node != localNodes.end(); ++node) {
+                        NodeValues::Values v1 = values(*node);
+                        Real t0 = v0.t, P0 = v0.P, Q0 = v0.Q;
+                        Real t1 = v1.t, P1 = v1.P, Q1 = v1.Q;
+                        Real fhat = v0.logP - v1.logP;
+                        Real hhat = v0.logQ - v1.logQ;
+                        Real fhphh = fhat + hhat;
+                        if (fhphh < 1E-4 && numericalFix_ == Taylor) {
+                            // see above, terms up to (f+h)^3 seem more than enough,
+                            // what exactly is implemented in the standard isda C
+                            // code ?
+                            Real fhphhq = fhphh * fhphh;
+                            defaultAccrThisNode +=
+                                hhat * P0 * Q0 *
+                                ((t0 - tstart) *
+                                     (1.0 - 0.5 * fhphh + 1.0 / 6.0 * fhphhq -
+                                      1.0 / 24.0 * fhphhq * fhphh) +
+                                 (t1 - t0) *
+                                     (0.5 - 1.0 / 3.0 * fhphh + 1.0 / 8.0 * fhphhq -
+                                      1.0 / 30.0 * fhphhq * fhphh));
+                        } else {
+                            defaultAccrThisNode +=
+                                (hhat / (fhphh + nFix)) *
+                                ((t1 - t0) * ((P0 * Q0 - P1 * Q1) / (fhphh + nFix) -
+                                              P1 * Q1) +
+                                 (t0 - tstart) * (P0 * Q0 - P1 * Q1));
+                        }
+                        v0 = v1;
                     }
-
-                    t0 = t1;
-                    P0 = P1;
-                    Q0 = Q1;
                 }
-                defaultAccrualNpv += defaultAccrThisNode * arguments_.notional *
+                defaultAccrualNpv += defaultAccrThisNode * arguments.notional *
                     coupon->rate() * 365. / 360.;
 			}
         }
 
 
-        results_.couponLegNPV = premiumNpv + defaultAccrualNpv;
+        results.couponLegNPV = premiumNpv + defaultAccrualNpv;
 
         // upfront flow npv
 
         Real upfPVO1 = 0.0;
-        results_.upfrontNPV = 0.0;
-        if (!arguments_.upfrontPayment->hasOccurred(
+        results.upfrontNPV = 0.0;
+        if (!arguments.upfrontPayment->hasOccurred(
                 evalDate, includeSettlementDateFlows_)) {
             upfPVO1 =
-                discountCurve_->discount(arguments_.upfrontPayment->date());
-            if(arguments_.upfrontPayment->amount() != 0.) {
-                results_.upfrontNPV = upfPVO1 * arguments_.upfrontPayment->amount();
+                discountCurve_->discount(arguments.upfrontPayment->date());
+            if(arguments.upfrontPayment->amount() != 0.) {
+                results.upfrontNPV = upfPVO1 * arguments.upfrontPayment->amount();
             }
         }
 
-        results_.accrualRebateNPV = 0.;
+        results.accrualRebateNPV = 0.;
         // NOLINTNEXTLINE(readability-implicit-bool-conversion)
-        if (arguments_.accrualRebate && arguments_.accrualRebate->amount() != 0. &&
-            !arguments_.accrualRebate->hasOccurred(evalDate, includeSettlementDateFlows_)) {
-            results_.accrualRebateNPV =
-                discountCurve_->discount(arguments_.accrualRebate->date()) *
-                arguments_.accrualRebate->amount();
+        if (arguments.accrualRebate && arguments.accrualRebate->amount() != 0. &&
+            !arguments.accrualRebate->hasOccurred(evalDate, includeSettlementDateFlows_)) {
+            results.accrualRebateNPV =
+                discountCurve_->discount(arguments.accrualRebate->date()) *
+                arguments.accrualRebate->amount();
         }
 
         Real upfrontSign = 1.0;
-        switch (arguments_.side) {
+        switch (arguments.side) {
           case Protection::Seller:
-            results_.defaultLegNPV *= -1.0;
-            results_.accrualRebateNPV *= -1.0;
+            results.defaultLegNPV *= -1.0;
+            results.accrualRebateNPV *= -1.0;
             break;
           case Protection::Buyer:
-            results_.couponLegNPV *= -1.0;
-            results_.upfrontNPV   *= -1.0;
+            results.couponLegNPV *= -1.0;
+            results.upfrontNPV   *= -1.0;
             upfrontSign = -1.0;
             break;
           default:
             QL_FAIL("unknown protection side");
         }
 
-        results_.value = results_.defaultLegNPV + results_.couponLegNPV +
-                         results_.upfrontNPV + results_.accrualRebateNPV;
+        results.value = results.defaultLegNPV + results.couponLegNPV +
+                         results.upfrontNPV + results.accrualRebateNPV;
 
-        results_.errorEstimate = Null<Real>();
+        results.errorEstimate = Null<Real>();
 
-        if (results_.couponLegNPV != 0.0) {
-            results_.fairSpread =
-                -results_.defaultLegNPV * arguments_.spread /
-                (results_.couponLegNPV + results_.accrualRebateNPV);
+        if (results.couponLegNPV != 0.0) {
+            results.fairSpread =
+                -results.defaultLegNPV * arguments.spread /
+                (results.couponLegNPV + results.accrualRebateNPV);
         } else {
-            results_.fairSpread = Null<Rate>();
+            results.fairSpread = Null<Rate>();
         }
 
-        Real upfrontSensitivity = upfPVO1 * arguments_.notional;
+        Real upfrontSensitivity = upfPVO1 * arguments.notional;
         if (upfrontSensitivity != 0.0) {
-            results_.fairUpfront =
-                -upfrontSign * (results_.defaultLegNPV + results_.couponLegNPV +
-                                results_.accrualRebateNPV) /
+            results.fairUpfront =
+                -upfrontSign * (results.defaultLegNPV + results.couponLegNPV +
+                                results.accrualRebateNPV) /
                 upfrontSensitivity;
         } else {
-            results_.fairUpfront = Null<Rate>();
+            results.fairUpfront = Null<Rate>();
         }
 
         static const Rate basisPoint = 1.0e-4;
 
-        if (arguments_.spread != 0.0) {
-            results_.couponLegBPS =
-                results_.couponLegNPV * basisPoint / arguments_.spread;
+        if (arguments.spread != 0.0) {
+            results.couponLegBPS =
+                results.couponLegNPV * basisPoint / arguments.spread;
         } else {
-            results_.couponLegBPS = Null<Rate>();
+            results.couponLegBPS = Null<Rate>();
         }
 
         // NOLINTNEXTLINE(readability-implicit-bool-conversion)
-        if (arguments_.upfront && *arguments_.upfront != 0.0) {
-            results_.upfrontBPS =
-                results_.upfrontNPV * basisPoint / (*arguments_.upfront);
+        if (arguments.upfront && *arguments.upfront != 0.0) {
+            results.upfrontBPS =
+                results.upfrontNPV * basisPoint / (*arguments.upfront);
         } else {
-            results_.upfrontBPS = Null<Rate>();
+            results.upfrontBPS = Null<Rate>();
         }
     }
 }
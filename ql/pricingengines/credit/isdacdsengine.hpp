@@ -107,8 +107,28 @@ namespace QuantLib {
         Handle<DefaultProbabilityTermStructure> isdaCreditCurve() const { return probability_; }
 
         void calculate() const override;
+        void update() override;
+
+        /*! Prices a set of swaps on the curves of this engine, e.g., the
+            different tenors quoted for a name.  The integration nodes,
+            the curve values at the nodes and the default-accrual
+            integrals over coupon periods shared by several swaps are
+            computed once for the whole set; the results are the same
+            as the ones obtained by pricing the swaps one at a time.
+            The arguments and results of the engine are not modified.
+        */
+        std::vector<CreditDefaultSwap::results>
+        calculate(const std::vector<ext::shared_ptr<CreditDefaultSwap> >& swaps) const;
 
       private:
+        class NodeValues;
+        std::vector<Date> integrationNodes() const;
+        static Date lastDate(const CreditDefaultSwap::arguments& arguments);
+        NodeValues& nodeValues(const Date& lastDate) const;
+        void calculate(const CreditDefaultSwap::arguments& arguments,
+                       CreditDefaultSwap::results& results,
+                       NodeValues& values) const;
+
         Handle<DefaultProbabilityTermStructure> probability_;
         const Real recoveryRate_;
         Handle<YieldTermStructure> discountCurve_;
@@ -116,6 +136,8 @@ namespace QuantLib {
         const NumericalFix numericalFix_;
         const AccrualBias accrualBias_;
         const ForwardsInCouponPeriod forwardsInCouponPeriod_;
+        // curve values kept between calculations
+        ext::shared_ptr<NodeValues> nodeValues_;
     };
 }
 
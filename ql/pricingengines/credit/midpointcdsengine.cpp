@@ -24,6 +24,7 @@
 #include <ql/pricingengines/credit/midpointcdsengine.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/optional.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -39,43 +40,128 @@ namespace QuantLib {
         registerWith(discountCurve_);
     }
 
+    // Curve values used during a calculation.  When pricing a batch,
+    // they are memoized by date so that swaps sharing coupon dates
+    // evaluate the curves once; the caches are indexed by the number
+    // of days from the reference date.
+    class MidPointCdsEngine::CurveValues {
+      public:
+        CurveValues(const Handle<YieldTermStructure>& discountCurve,
+                    const Handle<DefaultProbabilityTermStructure>& probability,
+                    bool memoize)
+        : discountCurve_(discountCurve), probability_(probability), memoize_(memoize),
+          referenceDate_(probability->referenceDate()) {}
+        DiscountFactor discount(const Date& d) {
+            Size i;
+            if (!cached(d, discounts_, i))
+                return discountCurve_->discount(d);
+            if (discounts_[i] == Null<Real>())
+                discounts_[i] = discountCurve_->discount(d);
+            return discounts_[i];
+        }
+        Probability survivalProbability(const Date& d) {
+            Size i;
+            if (!cached(d, survivals_, i))
+                return probability_->survivalProbability(d);
+            if (survivals_[i] == Null<Real>())
+                survivals_[i] = probability_->survivalProbability(d);
+            return survivals_[i];
+        }
+        // as in DefaultProbabilityTermStructure::defaultProbability(d1, d2)
+        Probability defaultProbability(const Date& d1, const Date& d2) {
+            if (!memoize_)
+                return probability_->defaultProbability(d1, d2);
+            QL_REQUIRE(d1 <= d2,
+                       "initial date (" << d1 << ") "
+                       "later than final date (" << d2 << ")");
+            Probability p1 = d1 < referenceDate_ ? 0.0 :
+                                                   1.0 - survivalProbability(d1),
+                        p2 = 1.0 - survivalProbability(d2);
+            return p2 - p1;
+        }
+      private:
+        // grows the cache as needed and returns whether d can be cached
+        bool cached(const Date& d, std::vector<Real>& cache, Size& i) const {
+            if (!memoize_ || d < referenceDate_)
+                return false;
+            i = d - referenceDate_;
+            if (i >= cache.size())
+                cache.resize(std::max<Size>(i+1, 2*cache.size()), Null<Real>());
+            return true;
+        }
+        const Handle<YieldTermStructure>& discountCurve_;
+        const Handle<DefaultProbabilityTermStructure>& probability_;
+        bool memoize_;
+        Date referenceDate_;
+        std::vector<DiscountFactor> discounts_;
+        std::vector<Probability> survivals_;
+    };
+
     void MidPointCdsEngine::calculate() const {
         QL_REQUIRE(!discountCurve_.empty(),
                    "no discount term structure set");
         QL_REQUIRE(!probability_.empty(),
                    "no probability term structure set");
 
+        CurveValues values(discountCurve_, probability_, false);
+        calculate(arguments_, results_, values);
+    }
+
+    std::vector<CreditDefaultSwap::results> MidPointCdsEngine::calculate(
+        const std::vector<ext::shared_ptr<CreditDefaultSwap> >& swaps) const {
+        QL_REQUIRE(!discountCurve_.empty(),
+                   "no discount term structure set");
+        QL_REQUIRE(!probability_.empty(),
+                   "no probability term structure set");
+
+        CurveValues values(discountCurve_, probability_, true);
+        CreditDefaultSwap::arguments arguments;
+        std::vector<CreditDefaultSwap::results> results(swaps.size());
+        for (Size i=0; i<swaps.size(); ++i) {
+            QL_REQUIRE(swaps[i], "null credit default swap given");
+            swaps[i]->setupArguments(&arguments);
+            arguments.validate();
+            results[i].reset();
+            calculate(arguments, results[i], values);
+        }
+        return results;
+    }
+
+    void MidPointCdsEngine::calculate(const CreditDefaultSwap::arguments& arguments,
+                                      CreditDefaultSwap::results& results,
+                                      CurveValues& values) const {
+
         Date today = Settings::instance().evaluationDate();
         Date settlementDate = discountCurve_->referenceDate();
 
         // Upfront amount.
         Real upfPVO1 = 0.0;
-        results_.upfrontNPV = 0.0;
-        if (!arguments_.upfrontPayment->hasOccurred(
+        results.upfrontNPV = 0.0;
+        if (!arguments.upfrontPayment->hasOccurred(
             settlementDate, includeSettlementDateFlows_)) {
-            upfPVO1 = discountCurve_->discount(arguments_.upfrontPayment->date());
-            results_.upfrontNPV = upfPVO1 * arguments_.upfrontPayment->amount();
+            upfPVO1 = discountCurve_->discount(arguments.upfrontPayment->date());
+            results.upfrontNPV = upfPVO1 * arguments.upfrontPayment->amount();
         }
 
         // Accrual rebate.
-        results_.accrualRebateNPV = 0.;
+        results.accrualRebateNPV = 0.;
         // NOLINTNEXTLINE(readability-implicit-bool-conversion)
-        if (arguments_.accrualRebate &&
-            !arguments_.accrualRebate->hasOccurred(settlementDate, includeSettlementDateFlows_)) {
-            results_.accrualRebateNPV =
-                discountCurve_->discount(arguments_.accrualRebate->date()) *
-                arguments_.accrualRebate->amount();
+        if (arguments.accrualRebate &&
+            !arguments.accrualRebate->hasOccurred(settlementDate, includeSettlementDateFlows_)) {
+            results.accrualRebateNPV =
+                discountCurve_->discount(arguments.accrualRebate->date()) *
+                arguments.accrualRebate->amount();
         }
 
-        results_.couponLegNPV  = 0.0;
-        results_.defaultLegNPV = 0.0;
-        for (Size i=0; i<arguments_.leg.size(); ++i) {
-            if (arguments_.leg[i]->hasOccurred(settlementDate,
+        results.couponLegNPV  = 0.0;
+        results.defaultLegNPV = 0.0;
+        for (Size i=0; i<arguments.leg.size(); ++i) {
+            if (arguments.leg[i]->hasOccurred(settlementDate,
                                                includeSettlementDateFlows_))
                 continue;
 
             ext::shared_ptr<FixedRateCoupon> coupon =
-                ext::dynamic_pointer_cast<FixedRateCoupon>(arguments_.leg[i]);
+                ext::dynamic_pointer_cast<FixedRateCoupon>(arguments.leg[i]);
 
             // In order to avoid a few switches, we calculate the NPV
             // of both legs as a positive quantity. We'll give them
@@ -86,101 +172,101 @@ namespace QuantLib {
                  endDate = coupon->accrualEndDate();
             // this is the only point where it might not coincide
             if (i==0)
-                startDate = arguments_.protectionStart;
+                startDate = arguments.protectionStart;
             Date effectiveStartDate =
                 (startDate <= today && today <= endDate) ? today : startDate;
             Date defaultDate = // mid-point
                 effectiveStartDate + (endDate-effectiveStartDate)/2;
 
-            Probability S = probability_->survivalProbability(paymentDate);
-            Probability P = probability_->defaultProbability(
+            Probability S = values.survivalProbability(paymentDate);
+            Probability P = values.defaultProbability(
                                                 effectiveStartDate,
                                                 endDate);
 
             // on one side, we add the fixed rate payments in case of
             // survival...
-            results_.couponLegNPV +=
+            results.couponLegNPV +=
                 S * coupon->amount() *
-                discountCurve_->discount(paymentDate);
+                values.discount(paymentDate);
             // ...possibly including accrual in case of default.
-            if (arguments_.settlesAccrual) {
-                if (arguments_.paysAtDefaultTime) {
-                    results_.couponLegNPV +=
+            if (arguments.settlesAccrual) {
+                if (arguments.paysAtDefaultTime) {
+                    results.couponLegNPV +=
                         P * coupon->accruedAmount(defaultDate) *
-                        discountCurve_->discount(defaultDate);
+                        values.discount(defaultDate);
                 } else {
                     // pays at the end
-                    results_.couponLegNPV +=
+                    results.couponLegNPV +=
                         P * coupon->amount() *
-                        discountCurve_->discount(paymentDate);
+                        values.discount(paymentDate);
                 }
             }
 
             // on the other side, we add the payment in case of default.
-            Real claim = arguments_.claim->amount(defaultDate,
-                                                  arguments_.notional,
+            Real claim = arguments.claim->amount(defaultDate,
+                                                  arguments.notional,
                                                   recoveryRate_);
-            if (arguments_.paysAtDefaultTime) {
-                results_.defaultLegNPV +=
-                    P * claim * discountCurve_->discount(defaultDate);
+            if (arguments.paysAtDefaultTime) {
+                results.defaultLegNPV +=
+                    P * claim * values.discount(defaultDate);
             } else {
-                results_.defaultLegNPV +=
-                    P * claim * discountCurve_->discount(paymentDate);
+                results.defaultLegNPV +=
+                    P * claim * values.discount(paymentDate);
             }
         }
 
         Real upfrontSign = 1.0;
-        switch (arguments_.side) {
+        switch (arguments.side) {
           case Protection::Seller:
-            results_.defaultLegNPV *= -1.0;
-            results_.accrualRebateNPV *= -1.0;
+            results.defaultLegNPV *= -1.0;
+            results.accrualRebateNPV *= -1.0;
             break;
           case Protection::Buyer:
-            results_.couponLegNPV *= -1.0;
-            results_.upfrontNPV   *= -1.0;
+            results.couponLegNPV *= -1.0;
+            results.upfrontNPV   *= -1.0;
             upfrontSign = -1.0;
             break;
           default:
             QL_FAIL("unknown protection side");
         }
 
-        results_.value =
-            results_.defaultLegNPV + results_.couponLegNPV +
-            results_.upfrontNPV + results_.accrualRebateNPV;
-        results_.errorEstimate = Null<Real>();
+        results.value =
+            results.defaultLegNPV + results.couponLegNPV +
+            results.upfrontNPV + results.accrualRebateNPV;
+        results.errorEstimate = Null<Real>();
 
-        if (results_.couponLegNPV != 0.0) {
-            results_.fairSpread =
-                -results_.defaultLegNPV*arguments_.spread/
-                    (results_.couponLegNPV + results_.accrualRebateNPV);
+        if (results.couponLegNPV != 0.0) {
+            results.fairSpread =
+                -results.defaultLegNPV*arguments.spread/
+                    (results.couponLegNPV + results.accrualRebateNPV);
         } else {
-            results_.fairSpread = Null<Rate>();
+            results.fairSpread = Null<Rate>();
         }
 
         if (upfPVO1 > 0.0) {
-            results_.fairUpfront =
-                -upfrontSign*(results_.defaultLegNPV + results_.couponLegNPV +
-                    results_.accrualRebateNPV)
-                / (upfPVO1 * arguments_.notional);
+            results.fairUpfront =
+                -upfrontSign*(results.defaultLegNPV + results.couponLegNPV +
+                    results.accrualRebateNPV)
+                / (upfPVO1 * arguments.notional);
         } else {
-            results_.fairUpfront = Null<Rate>();
+            results.fairUpfront = Null<Rate>();
         }
 
         static const Rate basisPoint = 1.0e-4;
 
-        if (arguments_.spread != 0.0) {
-            results_.couponLegBPS =
-                results_.couponLegNPV*basisPoint/arguments_.spread;
+        if (arguments.spread != 0.0) {
+            results.couponLegBPS =
+                results.couponLegNPV*basisPoint/arguments.spread;
         } else {
-            results_.couponLegBPS = Null<Rate>();
+            results.couponLegBPS = Null<Rate>();
         }
 
         // NOLINTNEXTLINE(readability-implicit-bool-conversion)
-        if (arguments_.upfront && *arguments_.upfront != 0.0) {
-            results_.upfrontBPS =
-                results_.upfrontNPV*basisPoint/(*arguments_.upfront);
+        if (arguments.upfront && *arguments.upfront != 0.0) {
+            results.upfrontBPS =
+                results.upfrontNPV*basisPoint/(*arguments.upfront);
         } else {
-            results_.upfrontBPS = Null<Rate>();
+            results.upfrontBPS = Null<Rate>();
         }
     }
 
@@ -39,7 +39,22 @@ namespace QuantLib {
                           const ext::optional<bool>& includeSettlementDateFlows = ext::nullopt);
         void calculate() const override;
 
+        /*! Prices a set of swaps on the curves of this engine, e.g., the
+            different tenors quoted for a name.  The curve values at the
+            coupon dates shared by several swaps are computed once for
+            the whole set; the results are the same as the ones obtained
+            by pricing the swaps one at a time.  The arguments and
+            results of the engine are not modified.
+        */
+        std::vector<CreditDefaultSwap::results>
+        calculate(const std::vector<ext::shared_ptr<CreditDefaultSwap> >& swaps) const;
+
       private:
+        class CurveValues;
+        void calculate(const CreditDefaultSwap::arguments& arguments,
+                       CreditDefaultSwap::results& results,
+                       CurveValues& values) const;
+
         Handle<DefaultProbabilityTermStructure> probability_;
         Real recoveryRate_;
         Handle<YieldTermStructure> discountCurve_;
@@ -78,23 +78,37 @@ namespace QuantLib {
         for (Size i=0; i<n; ++i) {
             try {
                 const YieldTermStructure& discount_ref = **discountCurve_;
-                std::tie(results_.legNPV[i], results_.legBPS[i]) =
-                    CashFlows::npvbps(arguments_.legs[i],
-                                      discount_ref,
-                                      includeRefDateFlows,
-                                      settlementDate,
-                                      results_.valuationDate);
+                const Leg& leg = arguments_.legs[i];
+                const CompiledLeg* compiled =
+                    i < arguments_.compiledLegs.size() ?
+                    arguments_.compiledLegs[i].get() : nullptr;
+                if (compiled != nullptr) {
+                    std::tie(results_.legNPV[i], results_.legBPS[i]) =
+                        compiled->npvbps(discount_ref,
+                                         includeRefDateFlows,
+                                         settlementDate,
+                                         results_.valuationDate);
+                } else {
+                    std::tie(results_.legNPV[i], results_.legBPS[i]) =
+                        CashFlows::npvbps(leg,
+                                          discount_ref,
+                                          includeRefDateFlows,
+                                          settlementDate,
+                                          results_.valuationDate);
+                }
                 results_.legNPV[i] *= arguments_.payer[i];
                 results_.legBPS[i] *= arguments_.payer[i];
 
-                if (!arguments_.legs[i].empty()) {
-                    Date d1 = CashFlows::startDate(arguments_.legs[i]);
+                if (!leg.empty()) {
+                    Date d1 = compiled != nullptr ?
+                        compiled->startDate() : CashFlows::startDate(leg);
                     if (d1>=refDate)
                         results_.startDiscounts[i] = discountCurve_->discount(d1);
                     else
                         results_.startDiscounts[i] = Null<DiscountFactor>();
 
-                    Date d2 = CashFlows::maturityDate(arguments_.legs[i]);
+                    Date d2 = compiled != nullptr ?
+                        compiled->maturityDate() : CashFlows::maturityDate(leg);
                     if (d2>=refDate)
                         results_.endDiscounts[i] = discountCurve_->discount(d2);
                     else
@@ -30,6 +30,7 @@
 #include <ql/termstructures/bootstraperror.hpp>
 #include <ql/termstructures/bootstraphelper.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <ql/utilities/instrumentationmacros.hpp>
 #include <algorithm>
 #include <utility>
 
@@ -182,6 +183,7 @@ template <class Curve> void GlobalBootstrap<Curve>::initialize() const {
 }
 
 template <class Curve> void GlobalBootstrap<Curve>::calculate() const {
+    QL_INSTRUMENT_SCOPE("GlobalBootstrap::calculate");
 
     // we might have to call initialize even if the curve is initialized
     // and not moving, just because helpers might be date relative and change
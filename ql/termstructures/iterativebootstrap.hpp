@@ -33,6 +33,7 @@
 #include <ql/math/solvers1d/finitedifferencenewtonsafe.hpp>
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <ql/utilities/instrumentationmacros.hpp>
 
 namespace QuantLib {
 
@@ -231,6 +232,7 @@ namespace detail {
 
     template <class Curve>
     void IterativeBootstrap<Curve>::calculate() const {
+        QL_INSTRUMENT_SCOPE("IterativeBootstrap::calculate");
 
         // we might have to call initialize even if the curve is initialized
         // and not moving, just because helpers might be date relative and change
@@ -265,6 +267,7 @@ namespace detail {
         bool validData = validCurve_;
 
         for (Size iteration=0; ; ++iteration) {
+            QL_INSTRUMENT_COUNTER("IterativeBootstrap::iterations", 1);
             previousData_ = ts_->data_;
 
             // Store min value and max value at each pillar so that we can expand search if necessary.
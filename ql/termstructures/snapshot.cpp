@@ -0,0 +1,263 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/indexes/swapindex.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/termstructures/snapshot.hpp>
+#include <ql/termstructures/volatility/equityfx/blackvariancesurface.hpp>
+#include <ql/termstructures/volatility/swaption/interpolatedswaptionvolatilitycube.hpp>
+#include <ql/utilities/binaryio.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        const char snapshotTag[9] = "QLSNAPSH";
+        const std::uint32_t snapshotVersion = 1;
+
+        enum class SnapshotKind : std::uint32_t {
+            InterpolatedCurve = 1,
+            BlackVarianceSurface = 2,
+            SwaptionVolatilityCube = 3
+        };
+
+        void writeHeader(std::ostream& out, SnapshotKind kind) {
+            detail::writeBinaryHeader(out, snapshotTag, snapshotVersion);
+            detail::writeBinary(out, std::uint32_t(kind));
+        }
+
+        void readHeader(std::istream& in, SnapshotKind kind) {
+            detail::readBinaryHeader(in, snapshotTag, snapshotVersion);
+            QL_REQUIRE(detail::readBinary<std::uint32_t>(in) == std::uint32_t(kind),
+                       "snapshot of a different kind of term structure");
+        }
+
+        std::string conventionName(const Calendar& c) {
+            return c.empty() ? std::string() : c.name();
+        }
+
+        std::string conventionName(const DayCounter& d) {
+            return d.empty() ? std::string() : d.name();
+        }
+
+        void writeConventions(std::ostream& out,
+                              const DayCounter& dayCounter,
+                              const Calendar& calendar) {
+            detail::writeBinaryString(out, conventionName(dayCounter));
+            detail::writeBinaryString(out, conventionName(calendar));
+        }
+
+        void readConventions(std::istream& in,
+                             const DayCounter& dayCounter,
+                             const Calendar& calendar) {
+            std::string dayCounterName = detail::readBinaryString(in);
+            QL_REQUIRE(dayCounterName == conventionName(dayCounter),
+                       "snapshot saved with " << dayCounterName << " day counter, "
+                       << conventionName(dayCounter) << " passed");
+            std::string calendarName = detail::readBinaryString(in);
+            QL_REQUIRE(calendarName == conventionName(calendar),
+                       "snapshot saved with " << calendarName << " calendar, "
+                       << conventionName(calendar) << " passed");
+        }
+
+        std::string swapIndexName(const ext::shared_ptr<SwapIndex>& index) {
+            return index != nullptr ? index->name() : std::string();
+        }
+
+        void writeSwapIndexName(std::ostream& out,
+                                const ext::shared_ptr<SwapIndex>& index) {
+            detail::writeBinaryString(out, swapIndexName(index));
+        }
+
+        void readSwapIndexName(std::istream& in,
+                               const ext::shared_ptr<SwapIndex>& index) {
+            std::string name = detail::readBinaryString(in);
+            QL_REQUIRE(name == swapIndexName(index),
+                       "snapshot saved with " << name << " swap index, "
+                       << swapIndexName(index) << " passed");
+        }
+
+        void writeDate(std::ostream& out, const Date& d) {
+            detail::writeBinary(out, std::int64_t(d.serialNumber()));
+        }
+
+        Date readDate(std::istream& in) {
+            return Date(Date::serial_type(detail::readBinary<std::int64_t>(in)));
+        }
+
+        void writeDates(std::ostream& out, const std::vector<Date>& dates) {
+            std::vector<std::int64_t> serials(dates.size());
+            for (Size i=0; i<dates.size(); ++i)
+                serials[i] = dates[i].serialNumber();
+            detail::writeBinaryVector(out, serials);
+        }
+
+        std::vector<Date> readDates(std::istream& in) {
+            std::vector<std::int64_t> serials = detail::readBinaryVector<std::int64_t>(in);
+            std::vector<Date> dates(serials.size());
+            for (Size i=0; i<serials.size(); ++i)
+                dates[i] = Date(Date::serial_type(serials[i]));
+            return dates;
+        }
+
+        void writePeriods(std::ostream& out, const std::vector<Period>& periods) {
+            std::vector<std::int32_t> data(2*periods.size());
+            for (Size i=0; i<periods.size(); ++i) {
+                data[2*i] = periods[i].length();
+                data[2*i+1] = periods[i].units();
+            }
+            detail::writeBinaryVector(out, data);
+        }
+
+        std::vector<Period> readPeriods(std::istream& in) {
+            std::vector<std::int32_t> data = detail::readBinaryVector<std::int32_t>(in);
+            QL_REQUIRE(data.size() % 2 == 0, "invalid period data in snapshot");
+            std::vector<Period> periods(data.size()/2);
+            for (Size i=0; i<periods.size(); ++i)
+                periods[i] = Period(data[2*i], TimeUnit(data[2*i+1]));
+            return periods;
+        }
+
+        void writeMatrix(std::ostream& out, const Matrix& m) {
+            detail::writeBinary(out, std::uint64_t(m.rows()));
+            detail::writeBinaryVector(out, std::vector<Real>(m.begin(), m.end()));
+        }
+
+        Matrix readMatrix(std::istream& in) {
+            auto rows = Size(detail::readBinary<std::uint64_t>(in));
+            std::vector<Real> data = detail::readBinaryVector<Real>(in);
+            QL_REQUIRE(rows == 0 ? data.empty() : data.size() % rows == 0,
+                       "invalid matrix data in snapshot");
+            Matrix m(rows, rows == 0 ? 0 : data.size()/rows);
+            std::copy(data.begin(), data.end(), m.begin());
+            return m;
+        }
+
+    }
+
+    namespace detail {
+
+        void writeCurveSnapshot(std::ostream& out,
+                                const DayCounter& dayCounter,
+                                const Calendar& calendar,
+                                const CurveSnapshot& snapshot) {
+            writeHeader(out, SnapshotKind::InterpolatedCurve);
+            writeConventions(out, dayCounter, calendar);
+            writeDate(out, snapshot.maxDate);
+            writeDates(out, snapshot.dates);
+            writeBinaryVector(out, snapshot.data);
+            QL_REQUIRE(out, "could not write curve snapshot");
+        }
+
+        CurveSnapshot readCurveSnapshot(std::istream& in,
+                                        const DayCounter& dayCounter,
+                                        const Calendar& calendar) {
+            readHeader(in, SnapshotKind::InterpolatedCurve);
+            readConventions(in, dayCounter, calendar);
+            CurveSnapshot snapshot;
+            snapshot.maxDate = readDate(in);
+            snapshot.dates = readDates(in);
+            snapshot.data = readBinaryVector<Real>(in);
+            QL_REQUIRE(snapshot.dates.size() == snapshot.data.size(),
+                       "mismatch between dates and data in curve snapshot");
+            return snapshot;
+        }
+
+    }
+
+    void saveSnapshot(std::ostream& out, const BlackVarianceSurface& surface) {
+        writeHeader(out, SnapshotKind::BlackVarianceSurface);
+        writeConventions(out, surface.dayCounter(), surface.calendar());
+        writeDate(out, surface.referenceDate());
+        writeDates(out, surface.dates());
+        detail::writeBinaryVector(out, surface.strikes());
+        writeMatrix(out, surface.volatilities());
+        detail::writeBinary(out, std::uint32_t(surface.lowerExtrapolation()));
+        detail::writeBinary(out, std::uint32_t(surface.upperExtrapolation()));
+        QL_REQUIRE(out, "could not write volatility surface snapshot");
+    }
+
+    ext::shared_ptr<BlackVarianceSurface>
+    loadBlackVarianceSurfaceSnapshot(std::istream& in,
+                                     const Calendar& calendar,
+                                     const DayCounter& dayCounter) {
+        readHeader(in, SnapshotKind::BlackVarianceSurface);
+        readConventions(in, dayCounter, calendar);
+        Date referenceDate = readDate(in);
+        std::vector<Date> dates = readDates(in);
+        std::vector<Real> strikes = detail::readBinaryVector<Real>(in);
+        Matrix volatilities = readMatrix(in);
+        auto lower = BlackVarianceSurface::Extrapolation(detail::readBinary<std::uint32_t>(in));
+        auto upper = BlackVarianceSurface::Extrapolation(detail::readBinary<std::uint32_t>(in));
+        return ext::make_shared<BlackVarianceSurface>(referenceDate, calendar, dates,
+                                                      std::move(strikes), volatilities,
+                                                      dayCounter, lower, upper);
+    }
+
+    void saveSnapshot(std::ostream& out, const InterpolatedSwaptionVolatilityCube& cube) {
+        writeHeader(out, SnapshotKind::SwaptionVolatilityCube);
+        writeConventions(out, cube.dayCounter(), cube.calendar());
+        writeSwapIndexName(out, cube.swapIndexBase());
+        writeSwapIndexName(out, cube.shortSwapIndexBase());
+        writePeriods(out, cube.optionTenors());
+        writePeriods(out, cube.swapTenors());
+        detail::writeBinaryVector(out, cube.strikeSpreads());
+        const std::vector<std::vector<Handle<Quote> > >& volSpreads =
+            static_cast<const SwaptionVolatilityCube&>(cube).volSpreads();
+        std::vector<Real> values;
+        values.reserve(volSpreads.size() * cube.strikeSpreads().size());
+        for (const auto& row : volSpreads) {
+            for (const auto& q : row)
+                values.push_back(q->value());
+        }
+        detail::writeBinaryVector(out, values);
+        detail::writeBinary(out, std::uint8_t(cube.vegaWeightedSmileFit()));
+        QL_REQUIRE(out, "could not write swaption cube snapshot");
+    }
+
+    ext::shared_ptr<InterpolatedSwaptionVolatilityCube>
+    loadSwaptionVolatilityCubeSnapshot(
+        std::istream& in,
+        const Handle<SwaptionVolatilityStructure>& atmVolStructure,
+        const ext::shared_ptr<SwapIndex>& swapIndexBase,
+        const ext::shared_ptr<SwapIndex>& shortSwapIndexBase) {
+        readHeader(in, SnapshotKind::SwaptionVolatilityCube);
+        readConventions(in, atmVolStructure->dayCounter(), atmVolStructure->calendar());
+        readSwapIndexName(in, swapIndexBase);
+        readSwapIndexName(in, shortSwapIndexBase);
+        std::vector<Period> optionTenors = readPeriods(in);
+        std::vector<Period> swapTenors = readPeriods(in);
+        std::vector<Spread> strikeSpreads = detail::readBinaryVector<Spread>(in);
+        std::vector<Real> values = detail::readBinaryVector<Real>(in);
+        bool vegaWeightedSmileFit = detail::readBinary<std::uint8_t>(in) != 0;
+
+        Size nStrikes = strikeSpreads.size();
+        QL_REQUIRE(values.size() == optionTenors.size() * swapTenors.size() * nStrikes,
+                   "invalid volatility spreads in swaption cube snapshot");
+        std::vector<std::vector<Handle<Quote> > > volSpreads(
+            optionTenors.size() * swapTenors.size(), std::vector<Handle<Quote> >(nStrikes));
+        for (Size i=0; i<volSpreads.size(); ++i) {
+            for (Size k=0; k<nStrikes; ++k)
+                volSpreads[i][k] = Handle<Quote>(
+                    ext::make_shared<SimpleQuote>(values[i*nStrikes+k]));
+        }
+        return ext::make_shared<InterpolatedSwaptionVolatilityCube>(
+            atmVolStructure, optionTenors, swapTenors, strikeSpreads, volSpreads,
+            swapIndexBase, shortSwapIndexBase, vegaWeightedSmileFit);
+    }
+
+}
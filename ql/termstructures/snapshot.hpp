@@ -0,0 +1,158 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file snapshot.hpp
+    \brief binary snapshots of interpolated term structures
+*/
+
+#ifndef quantlib_term_structure_snapshot_hpp
+#define quantlib_term_structure_snapshot_hpp
+
+#include <ql/handle.hpp>
+#include <ql/time/calendar.hpp>
+#include <ql/time/daycounter.hpp>
+#include <ql/shared_ptr.hpp>
+#include <iosfwd>
+#include <vector>
+
+namespace QuantLib {
+
+    class BlackVarianceSurface;
+    class InterpolatedSwaptionVolatilityCube;
+    class SwaptionVolatilityStructure;
+    class SwapIndex;
+
+    namespace detail {
+
+        struct CurveSnapshot {
+            Date maxDate;
+            std::vector<Date> dates;
+            std::vector<Real> data;
+        };
+
+        void writeCurveSnapshot(std::ostream& out,
+                                const DayCounter& dayCounter,
+                                const Calendar& calendar,
+                                const CurveSnapshot& snapshot);
+        CurveSnapshot readCurveSnapshot(std::istream& in,
+                                        const DayCounter& dayCounter,
+                                        const Calendar& calendar);
+
+        // restores the maximum date of the saved curve, which can
+        // exceed its last node when the curve was bootstrapped
+        template <class Curve>
+        class SnapshotCurve : public Curve {
+          public:
+            template <class... Args>
+            explicit SnapshotCurve(const Date& maxDate, Args&&... args)
+            : Curve(std::forward<Args>(args)...) {
+                this->maxDate_ = maxDate;
+            }
+        };
+
+    }
+
+    //! \name Binary snapshots of term structures
+    /*! Snapshots store the data of calibrated or bootstrapped term
+        structures in a flat binary format, so that they can be
+        loaded back as frozen term structures without repeating the
+        calibration.  Each snapshot starts with a versioned header;
+        as for IndexManager::save(), the format depends on the size
+        and byte order of Real on the writing platform.
+
+        Conventions such as day counters and calendars cannot be
+        serialized; their names are stored and checked against the
+        ones passed when loading.
+    */
+    //@{
+
+    //! writes a snapshot of an interpolated curve
+    /*! Any curve built on InterpolatedCurve and exposing its nodes
+        through dates() and data() can be saved; this includes
+        PiecewiseYieldCurve and PiecewiseDefaultCurve instances,
+        which are bootstrapped if needed.
+
+        \warning jumps are not stored.
+    */
+    template <class Curve>
+    void saveSnapshot(std::ostream& out, const Curve& curve) {
+        detail::writeCurveSnapshot(out, curve.dayCounter(), curve.calendar(),
+                                   {curve.maxDate(), curve.dates(), curve.data()});
+    }
+
+    //! loads a frozen curve from a snapshot
+    /*! \c Curve must be the interpolated curve underlying the saved
+        one; for instance, a PiecewiseYieldCurve<Discount,LogLinear>
+        is loaded back as an InterpolatedDiscountCurve<LogLinear>.
+        The returned curve has a fixed reference date and does not
+        depend on any quote.
+    */
+    template <class Curve, class Interpolator>
+    ext::shared_ptr<Curve> loadCurveSnapshot(std::istream& in,
+                                             const DayCounter& dayCounter,
+                                             const Calendar& calendar,
+                                             const Interpolator& interpolator) {
+        detail::CurveSnapshot s = detail::readCurveSnapshot(in, dayCounter, calendar);
+        return ext::make_shared<detail::SnapshotCurve<Curve> >(
+            s.maxDate, s.dates, s.data, dayCounter, calendar, interpolator);
+    }
+
+    template <class Curve>
+    ext::shared_ptr<Curve> loadCurveSnapshot(std::istream& in,
+                                             const DayCounter& dayCounter,
+                                             const Calendar& calendar = Calendar()) {
+        detail::CurveSnapshot s = detail::readCurveSnapshot(in, dayCounter, calendar);
+        return ext::make_shared<detail::SnapshotCurve<Curve> >(
+            s.maxDate, s.dates, s.data, dayCounter, calendar);
+    }
+
+    //! writes a snapshot of a Black variance surface
+    void saveSnapshot(std::ostream& out, const BlackVarianceSurface& surface);
+
+    //! loads a Black variance surface from a snapshot
+    /*! The returned surface uses bilinear interpolation; a different
+        interpolation can be set with its setInterpolation() method.
+    */
+    ext::shared_ptr<BlackVarianceSurface>
+    loadBlackVarianceSurfaceSnapshot(std::istream& in,
+                                     const Calendar& calendar,
+                                     const DayCounter& dayCounter);
+
+    //! writes a snapshot of the volatility spreads of a swaption cube
+    /*! The ATM volatility structure is not part of the snapshot. */
+    void saveSnapshot(std::ostream& out, const InterpolatedSwaptionVolatilityCube& cube);
+
+    //! loads a swaption cube from a snapshot
+    /*! The volatility spreads are stored in simple quotes owned by
+        the returned cube; the ATM structure and swap indexes
+        providing the market conventions must be passed.  Their day
+        counter, calendar and names must match those of the saved
+        cube.
+    */
+    ext::shared_ptr<InterpolatedSwaptionVolatilityCube>
+    loadSwaptionVolatilityCubeSnapshot(
+        std::istream& in,
+        const Handle<SwaptionVolatilityStructure>& atmVolStructure,
+        const ext::shared_ptr<SwapIndex>& swapIndexBase,
+        const ext::shared_ptr<SwapIndex>& shortSwapIndexBase);
+
+    //@}
+
+}
+
+
+#endif
@@ -34,6 +34,7 @@
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/timegrid.hpp>
 #include <ql/utilities/null.hpp>
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <utility>
@@ -77,47 +78,19 @@ namespace QuantLib {
 
         Array solveFor(Time dT, const Array& sig, const Array& b) const {
 
-            Array x(lnMarketStrikes_.size());
-            Interpolation sigInterpl;
+            // the local volatilities on the grid only depend on sig;
+            // they are kept for the repeated steps with the same
+            // calibrated sigmas (e.g., when slicing the surface)
+            if (sig.size() != cachedSig_.size()
+                || !std::equal(sig.begin(), sig.end(), cachedSig_.begin())) {
+                cachedVols_ = gridVols(sig);
+                cachedSig_ = sig;
 
-            switch (interpolationType_) {
-              case AndreasenHugeVolatilityInterpl::CubicSpline:
-                sigInterpl = CubicNaturalSpline(
-                    lnMarketStrikes_.begin(), lnMarketStrikes_.end(),
-                    sig.begin());
-                break;
-              case AndreasenHugeVolatilityInterpl::Linear:
-                sigInterpl = LinearInterpolation(
-                    lnMarketStrikes_.begin(), lnMarketStrikes_.end(),
-                    sig.begin());
-                break;
-              case AndreasenHugeVolatilityInterpl::PiecewiseConstant:
-                for (Size i=0; i < x.size()-1; ++i)
-                    x[i] = 0.5*(lnMarketStrikes_[i] + lnMarketStrikes_[i+1]);
-                x.back() = lnMarketStrikes_.back();
-
-                sigInterpl = BackwardFlatInterpolation(
-                    x.begin(), x.end(), sig.begin());
-                break;
-              default:
-                QL_FAIL("unknown interpolation type");
+                const Array z = 0.5*cachedVols_*cachedVols_;
+                mapT_.axpyb(z, dxMap_, dxxMap_.mult(-z), Array());
             }
 
-            Array z(mesher_->layout()->size());
-            for (const auto& iter : *mesher_->layout()) {
-                const Size i = iter.index();
-                const Real lnStrike = mesher_->location(iter, 0);
-
-                const Real vol = sigInterpl(
-                    std::min(std::max(lnStrike, lnMarketStrikes_.front()),
-                            lnMarketStrikes_.back()), true);
-
-                z[i] = 0.5*vol*vol;
-            }
-
-            mapT_.axpyb(z, dxMap_, dxxMap_.mult(-z), Array());
-            return mapT_.mult(Array(z.size(), dT)).solve_splitting(b, 1.0);
-
+            return mapT_.mult(Array(nGridPoints_, dT)).solve_splitting(b, 1.0);
         }
 
         Array apply(const Array& c) const {
@@ -141,6 +114,69 @@ namespace QuantLib {
             return retVal;
         }
 
+        /* The one-step solution c solves (1 + dT*z*K) c = b, with
+           K = d/dx - d^2/dx^2 and z = sigma^2/2 on the grid, hence
+
+             dc/dsig_k = -(1 + dT*z*K)^{-1} (dT * Kc * sigma * w_k),
+
+           w_k being the (linear) interpolation weights of sig_k on the
+           grid.  Where the monotonicity filter of the spline used in
+           values() leaves the nodes around a market strike untouched,
+           the spline is locally a natural cubic spline and the
+           derivatives are interpolated with the latter.  The rows of
+           the strikes next to adjusted nodes are obtained by finite
+           differences instead.
+        */
+        void jacobian(Matrix& jac, const Array& sig) const override {
+            const Array c = solveFor(dT_, sig, previousNPVs_);
+            const TripleBandLinearOp stepOp =
+                mapT_.mult(Array(nGridPoints_, dT_));
+            const Array kc = -d2CdK2_.apply(c);
+
+            const std::vector<Real>& gridPoints =
+                mesher_->getFdm1dMeshers().front()->locations();
+
+            Array unit(sig.size(), 0.0), rhs(nGridPoints_);
+            for (Size k=0; k < sig.size(); ++k) {
+                unit[k] = 1.0;
+                const Array w = gridVols(unit);
+                unit[k] = 0.0;
+
+                for (Size i=0; i < nGridPoints_; ++i)
+                    rhs[i] = -dT_*kc[i]*cachedVols_[i]*w[i];
+
+                const Array dc = stepOp.solve_splitting(rhs, 1.0);
+                const CubicNaturalSpline interpl(
+                    gridPoints.begin(), gridPoints.end(), dc.begin());
+
+                for (Size j=0; j < lnMarketStrikes_.size(); ++j)
+                    jac[j][k] = interpl(lnMarketStrikes_[j]);
+            }
+
+            const MonotonicCubicNaturalSpline interpl(
+                gridPoints.begin(), gridPoints.end(), c.begin());
+            const std::vector<bool>& adjusted =
+                interpl.monotonicityAdjustments();
+
+            std::vector<Size> filtered;
+            for (Size j=0; j < lnMarketStrikes_.size(); ++j) {
+                // nodes at the ends of the spline segment of the strike
+                const Size i = std::max<Size>(
+                    std::upper_bound(gridPoints.begin(), gridPoints.end()-1,
+                                     lnMarketStrikes_[j]) - gridPoints.begin(),
+                    1);
+                if (adjusted[i-1] || adjusted[i])
+                    filtered.push_back(j);
+            }
+
+            if (!filtered.empty()) {
+                Matrix fd(lnMarketStrikes_.size(), sig.size());
+                CostFunction::jacobian(fd, sig);
+                for (Size j : filtered)
+                    std::copy(fd.row_begin(j), fd.row_end(j), jac.row_begin(j));
+            }
+        }
+
         Array vegaCalibrationError(const Array& sig) const {
             return values(sig)/marketVegas_;
         }
@@ -151,6 +187,44 @@ namespace QuantLib {
 
 
       private:
+        Array gridVols(const Array& sig) const {
+            Array x(lnMarketStrikes_.size());
+            Interpolation sigInterpl;
+
+            switch (interpolationType_) {
+              case AndreasenHugeVolatilityInterpl::CubicSpline:
+                sigInterpl = CubicNaturalSpline(
+                    lnMarketStrikes_.begin(), lnMarketStrikes_.end(),
+                    sig.begin());
+                break;
+              case AndreasenHugeVolatilityInterpl::Linear:
+                sigInterpl = LinearInterpolation(
+                    lnMarketStrikes_.begin(), lnMarketStrikes_.end(),
+                    sig.begin());
+                break;
+              case AndreasenHugeVolatilityInterpl::PiecewiseConstant:
+                for (Size i=0; i < x.size()-1; ++i)
+                    x[i] = 0.5*(lnMarketStrikes_[i] + lnMarketStrikes_[i+1]);
+                x.back() = lnMarketStrikes_.back();
+
+                sigInterpl = BackwardFlatInterpolation(
+                    x.begin(), x.end(), sig.begin());
+                break;
+              default:
+                QL_FAIL("unknown interpolation type");
+            }
+
+            Array vols(nGridPoints_);
+            for (const auto& iter : *mesher_->layout()) {
+                const Real lnStrike = mesher_->location(iter, 0);
+
+                vols[iter.index()] = sigInterpl(
+                    std::min(std::max(lnStrike, lnMarketStrikes_.front()),
+                            lnMarketStrikes_.back()), true);
+            }
+            return vols;
+        }
+
         const Array marketNPVs_, marketVegas_;
         const Array lnMarketStrikes_, previousNPVs_;
         const ext::shared_ptr<FdmMesherComposite> mesher_;
@@ -163,6 +237,7 @@ namespace QuantLib {
         const TripleBandLinearOp dxxMap_;
         const TripleBandLinearOp d2CdK2_;
         mutable TripleBandLinearOp mapT_;
+        mutable Array cachedSig_, cachedVols_;
     };
 
     class CombinedCostFunction : public CostFunction {
@@ -189,6 +264,23 @@ namespace QuantLib {
                 QL_FAIL("internal error: cost function not set");
         }
 
+        void jacobian(Matrix& jac, const Array& sig) const override {
+            if ((putCostFct_ != nullptr) && (callCostFct_ != nullptr)) {
+                const Size n = sig.size();
+                Matrix pj(n, n), cj(n, n);
+                putCostFct_->jacobian(pj, sig);
+                callCostFct_->jacobian(cj, sig);
+
+                std::copy(pj.begin(), pj.end(), jac.begin());
+                std::copy(cj.begin(), cj.end(), jac.begin() + pj.rows()*n);
+            } else if (putCostFct_ != nullptr)
+                putCostFct_->jacobian(jac, sig);
+            else if (callCostFct_ != nullptr)
+                callCostFct_->jacobian(jac, sig);
+            else
+                QL_FAIL("internal error: cost function not set");
+        }
+
         Array initialValues() const {
             if ((putCostFct_ != nullptr) && (callCostFct_ != nullptr))
                 return 0.5*(  putCostFct_->initialValues()
@@ -362,6 +454,7 @@ namespace QuantLib {
         gridInFwd_ = Exp(gridPoints_)*spot_->value();
 
         localVolCache_.clear();
+        priceCache_.clear();
         calibrationResults_.clear();
 
         avgError_ = 0.0;
@@ -508,6 +601,8 @@ namespace QuantLib {
     Real AndreasenHugeVolatilityInterpl::optionPrice(
         Time t, Real strike, Option::Type optionType) const {
 
+        calculate();
+
         auto f = priceCache_.find(t);
 
         const DiscountFactor df = rTS_->discount(t);
@@ -526,8 +621,6 @@ namespace QuantLib {
             return price*df*fwd;
         }
 
-        calculate();
-
 
         ext::shared_ptr<Array> prices(
             ext::make_shared<Array>(gridPoints_));
@@ -573,9 +666,7 @@ namespace QuantLib {
         const Array cAtJ = costFunction->solveFor(dt, sig, previousNPVs);
 
         const Array dCdT =
-            costFunction->solveFor(dt, sig,
-                    costFunction->apply(
-                        costFunction->solveFor(dt, sig, previousNPVs)));
+            costFunction->solveFor(dt, sig, costFunction->apply(cAtJ));
 
         const Array d2CdK2 = costFunction->d2CdK2(cAtJ);
 
@@ -590,13 +681,13 @@ namespace QuantLib {
 
     Volatility AndreasenHugeVolatilityInterpl::localVol(Time t, Real strike)
     const {
+        calculate();
+
         auto f = localVolCache_.find(t);
 
         if (f != localVolCache_.end())
             return getCacheValue(strike, f);
 
-        calculate();
-
         ext::shared_ptr<Array> localVol(
             ext::make_shared<Array>(gridPoints_.size()));
 
@@ -33,7 +33,8 @@ namespace QuantLib {
                                                BlackVarianceSurface::Extrapolation lowerEx,
                                                BlackVarianceSurface::Extrapolation upperEx)
     : BlackVarianceTermStructure(referenceDate, cal), dayCounter_(std::move(dayCounter)),
-      maxDate_(dates.back()), strikes_(std::move(strikes)), lowerExtrapolation_(lowerEx),
+      maxDate_(dates.back()), dates_(dates), strikes_(std::move(strikes)),
+      volatilities_(blackVolMatrix), lowerExtrapolation_(lowerEx),
       upperExtrapolation_(upperEx) {
 
         QL_REQUIRE(dates.size()==blackVolMatrix.columns(),
@@ -66,6 +66,15 @@ namespace QuantLib {
         Real minStrike() const override { return strikes_.front(); }
         Real maxStrike() const override { return strikes_.back(); }
         //@}
+        //! \name Inspectors
+        //@{
+        const std::vector<Date>& dates() const { return dates_; }
+        const std::vector<Real>& strikes() const { return strikes_; }
+        //! the Black volatilities passed to the constructor
+        const Matrix& volatilities() const { return volatilities_; }
+        Extrapolation lowerExtrapolation() const { return lowerExtrapolation_; }
+        Extrapolation upperExtrapolation() const { return upperExtrapolation_; }
+        //@}
         //! \name Modifiers
         //@{
         template <class Interpolator>
@@ -87,7 +96,9 @@ namespace QuantLib {
       private:
         DayCounter dayCounter_;
         Date maxDate_;
+        std::vector<Date> dates_;
         std::vector<Real> strikes_;
+        Matrix volatilities_;
         std::vector<Time> times_;
         Matrix variances_;
         Interpolation2D varianceSurface_;
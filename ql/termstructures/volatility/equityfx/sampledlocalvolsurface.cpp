@@ -0,0 +1,140 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/termstructures/volatility/equityfx/sampledlocalvolsurface.hpp>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace QuantLib {
+
+    SampledLocalVolSurface::SampledLocalVolSurface(
+        Handle<LocalVolTermStructure> localVol,
+        Handle<Quote> underlying,
+        std::vector<Time> times,
+        Size strikeGridPoints,
+        Real numberOfStdDevs)
+    : LocalVolTermStructure(localVol->businessDayConvention(), localVol->dayCounter()),
+      localVol_(std::move(localVol)), underlying_(std::move(underlying)),
+      times_(std::move(times)), nx_(strikeGridPoints),
+      numberOfStdDevs_(numberOfStdDevs) {
+
+        QL_REQUIRE(!times_.empty(), "no times given");
+        QL_REQUIRE(times_.front() >= 0.0, "cannot have times[0] < 0");
+        for (Size i=1; i<times_.size(); ++i)
+            QL_REQUIRE(times_[i] > times_[i-1], "times must be sorted unique");
+        QL_REQUIRE(times_.back() > 0.0, "at least one positive time required");
+        QL_REQUIRE(nx_ >= 2, "at least two strike grid points required");
+        QL_REQUIRE(numberOfStdDevs_ > 0.0,
+                   "positive number of standard deviations required");
+
+        registerWith(localVol_);
+        registerWith(underlying_);
+    }
+
+    const Date& SampledLocalVolSurface::referenceDate() const {
+        return localVol_->referenceDate();
+    }
+
+    DayCounter SampledLocalVolSurface::dayCounter() const {
+        return localVol_->dayCounter();
+    }
+
+    Date SampledLocalVolSurface::maxDate() const {
+        return localVol_->maxDate();
+    }
+
+    Real SampledLocalVolSurface::minStrike() const {
+        return localVol_->minStrike();
+    }
+
+    Real SampledLocalVolSurface::maxStrike() const {
+        return localVol_->maxStrike();
+    }
+
+    void SampledLocalVolSurface::update() {
+        // notifies observers only if the grid was already built
+        LazyObject::update();
+    }
+
+    std::vector<Real> SampledLocalVolSurface::strikes(Size i) const {
+        QL_REQUIRE(i < times_.size(), "time index out of range");
+        calculate();
+        std::vector<Real> result(nx_);
+        for (Size j=0; j<nx_; ++j)
+            result[j] = std::exp(logSpot_ + xMin_[i] + j*dx_[i]);
+        return result;
+    }
+
+    void SampledLocalVolSurface::performCalculations() const {
+        const Real spot = underlying_->value();
+        QL_REQUIRE(spot > 0.0, "positive underlying value required");
+        logSpot_ = std::log(spot);
+
+        const Size nt = times_.size();
+        vols_.resize(nt*nx_);
+        xMin_.resize(nt);
+        dx_.resize(nt);
+
+        // the first positive time sets the width of the grid at t=0
+        const Time tMin = *std::upper_bound(times_.begin(), times_.end(), 0.0);
+
+        for (Size i=0; i<nt; ++i) {
+            const Time t = times_[i];
+            const Volatility atmVol = localVol_->localVol(t, spot, true);
+            const Real halfWidth =
+                numberOfStdDevs_*atmVol*std::sqrt(std::max(t, tMin));
+            QL_REQUIRE(halfWidth > 0.0,
+                       "zero at-the-money local volatility at time " << t);
+
+            xMin_[i] = -halfWidth;
+            dx_[i] = 2.0*halfWidth/(nx_-1);
+
+            Volatility* v = &vols_[i*nx_];
+            for (Size j=0; j<nx_; ++j)
+                v[j] = localVol_->localVol(
+                    t, std::exp(logSpot_ + xMin_[i] + j*dx_[i]), true);
+        }
+    }
+
+    Volatility SampledLocalVolSurface::interpolate(Size i, Real x) const {
+        const Real u = std::min(std::max((x - xMin_[i])/dx_[i], 0.0),
+                                Real(nx_-1));
+        const Size j = std::min(static_cast<Size>(u), nx_-2);
+        const Real w = u - j;
+        const Volatility* v = &vols_[i*nx_];
+        return v[j] + w*(v[j+1] - v[j]);
+    }
+
+    Volatility SampledLocalVolSurface::localVolImpl(Time t, Real strike) const {
+        calculate();
+
+        // non-positive strikes fall back on the lowest sampled strike
+        const Real x = (strike > 0.0) ? Real(std::log(strike) - logSpot_)
+                                      : Real(-QL_MAX_REAL);
+        if (t <= times_.front())
+            return interpolate(0, x);
+        if (t >= times_.back())
+            return interpolate(times_.size()-1, x);
+
+        const Size i = std::upper_bound(times_.begin(), times_.end(), t)
+                     - times_.begin();
+        const Real w = (t - times_[i-1])/(times_[i] - times_[i-1]);
+        return (1.0-w)*interpolate(i-1, x) + w*interpolate(i, x);
+    }
+
+}
@@ -0,0 +1,100 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file sampledlocalvolsurface.hpp
+    \brief Local volatility surface sampled once on a grid
+*/
+
+#ifndef quantlib_sampled_local_vol_surface_hpp
+#define quantlib_sampled_local_vol_surface_hpp
+
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/quote.hpp>
+#include <ql/termstructures/volatility/equityfx/localvoltermstructure.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Local volatility surface sampled on a (time, log-moneyness) grid
+    /*! The underlying local volatility (e.g., a LocalVolSurface,
+        whose Dupire formula needs several Black-variance lookups
+        per call) is evaluated once on the given times and, for each
+        time, on a uniform grid in log-moneyness whose width is
+        \f$ \pm n \sigma \sqrt{t} \f$ around the current spot, with
+        \f$ \sigma \f$ being the at-the-money local volatility.
+        The samples are stored contiguously; lookups use a constant
+        time index in the strike direction and linear interpolation
+        in both strike and time, with constant extrapolation as in
+        FixedLocalVolSurface.
+
+        The grid is built lazily on first use and is rebuilt after
+        any notification from the underlying surface or the spot.
+
+        \warning the sampled surface is only as accurate as the grid;
+                 the time grid should contain the simulation or
+                 finite-difference times it will be queried at.
+    */
+    class SampledLocalVolSurface : public LocalVolTermStructure,
+                                   public LazyObject {
+      public:
+        SampledLocalVolSurface(Handle<LocalVolTermStructure> localVol,
+                               Handle<Quote> underlying,
+                               std::vector<Time> times,
+                               Size strikeGridPoints = 101,
+                               Real numberOfStdDevs = 5.0);
+        //! \name TermStructure interface
+        //@{
+        const Date& referenceDate() const override;
+        DayCounter dayCounter() const override;
+        Date maxDate() const override;
+        //@}
+        //! \name VolatilityTermStructure interface
+        //@{
+        Real minStrike() const override;
+        Real maxStrike() const override;
+        //@}
+        //! \name Observer interface
+        //@{
+        void update() override;
+        //@}
+        //! \name Inspectors
+        //@{
+        const std::vector<Time>& times() const { return times_; }
+        //! strikes at which the local volatility was sampled at the i-th time
+        std::vector<Real> strikes(Size i) const;
+        //@}
+      protected:
+        void performCalculations() const override;
+        Volatility localVolImpl(Time t, Real strike) const override;
+
+      private:
+        Volatility interpolate(Size i, Real x) const;
+
+        Handle<LocalVolTermStructure> localVol_;
+        Handle<Quote> underlying_;
+        std::vector<Time> times_;
+        Size nx_;
+        Real numberOfStdDevs_;
+        // nx_ samples per time, stored time after time
+        mutable std::vector<Volatility> vols_;
+        mutable std::vector<Real> xMin_, dx_;
+        mutable Real logSpot_ = 0.0;
+    };
+
+}
+
+#endif
@@ -38,6 +38,7 @@
 #include <ql/quote.hpp>
 #include <ql/termstructures/volatility/sabrsmilesection.hpp>
 #include <ql/termstructures/volatility/swaption/swaptionvolcube.hpp>
+#include <exception>
 #include <utility>
 
 
@@ -133,7 +134,8 @@ namespace QuantLib {
             bool useMaxError = false,
             Size maxGuesses = 50,
             bool backwardFlat = false,
-            Real cutoffStrike = 0.0001);
+            Real cutoffStrike = 0.0001,
+            bool warmStart = false);
         //! \name LazyObject interface
         //@{
         void performCalculations() const override;
@@ -152,6 +154,10 @@ namespace QuantLib {
         Matrix denseSabrParameters() const;
         Matrix marketVolCube() const;
         Matrix volCubeAtmCalibrated() const;
+        /*! number of smile fits run so far; nodes whose inputs did
+            not change since the previous calibration are not fitted
+            again and are not counted. */
+        Size smileFits() const { return smileFits_; }
         //@}
         void sabrCalibrationSection(const Cube& marketVolCube,
                                     Cube& parametersCube,
@@ -177,6 +183,26 @@ namespace QuantLib {
         std::vector<Real> spreadVolInterpolation(const Date& atmOptionDate,
                                                  const Period& atmSwapTenor) const;
       private:
+        /* inputs and results of the smile fit at a single node; they
+           are kept between calibrations so that nodes whose inputs did
+           not change are not fitted again, and so that nodes whose
+           inputs did change can start from the previous solution. */
+        struct NodeCalibration {
+            Time optionTime = Null<Time>();
+            Rate forward = Null<Rate>();
+            Real shift = Null<Real>();
+            std::vector<Real> strikes, volatilities, guess;
+            std::vector<Real> result;
+            bool sameInputsAs(const NodeCalibration& o) const {
+                return optionTime == o.optionTime && forward == o.forward &&
+                       shift == o.shift && strikes == o.strikes &&
+                       volatilities == o.volatilities && guess == o.guess;
+            }
+        };
+        Cube sabrCalibration(const Cube& marketVolCube,
+                             std::vector<NodeCalibration>& nodes) const;
+        std::vector<Real> calibrateNode(const NodeCalibration& node,
+                                        const std::vector<Real>& guess) const;
         Size requiredNumberOfStrikes() const override { return 1; }
         mutable Cube marketVolCube_;
         mutable Cube volCubeAtmCalibrated_;
@@ -197,6 +223,9 @@ namespace QuantLib {
         const bool backwardFlat_;
         const Real cutoffStrike_;
         VolatilityType volatilityType_;
+        const bool warmStart_;
+        mutable std::vector<NodeCalibration> sparseNodes_, denseNodes_;
+        mutable Size smileFits_ = 0;
 
         class PrivateObserver : public Observer {
           public:
@@ -239,7 +268,8 @@ namespace QuantLib {
         const bool useMaxError,
         const Size maxGuesses,
         const bool backwardFlat,
-        const Real cutoffStrike)
+        const Real cutoffStrike,
+        const bool warmStart)
     : SwaptionVolatilityCube(atmVolStructure,
                              optionTenors,
                              swapTenors,
@@ -252,7 +282,8 @@ namespace QuantLib {
       isParameterFixed_(std::move(isParameterFixed)), isAtmCalibrated_(isAtmCalibrated),
       endCriteria_(std::move(endCriteria)), optMethod_(std::move(optMethod)),
       useMaxError_(useMaxError), maxGuesses_(maxGuesses), backwardFlat_(backwardFlat),
-      cutoffStrike_(cutoffStrike), volatilityType_(atmVolStructure->volatilityType()) {
+      cutoffStrike_(cutoffStrike), volatilityType_(atmVolStructure->volatilityType()),
+      warmStart_(warmStart) {
 
         if (maxErrorTolerance != Null<Rate>()) {
             maxErrorTolerance_ = maxErrorTolerance;
@@ -318,7 +349,7 @@ namespace QuantLib {
         }
         marketVolCube_.updateInterpolators();
 
-        sparseParameters_ = sabrCalibration(marketVolCube_);
+        sparseParameters_ = sabrCalibration(marketVolCube_, sparseNodes_);
         //parametersGuess_ = sparseParameters_;
         sparseParameters_.updateInterpolators();
         //parametersGuess_.updateInterpolators();
@@ -326,7 +357,7 @@ namespace QuantLib {
 
         if(isAtmCalibrated_){
             fillVolatilityCube();
-            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_);
+            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_, denseNodes_);
             denseParameters_.updateInterpolators();
         }
     }
@@ -335,7 +366,7 @@ namespace QuantLib {
         volCubeAtmCalibrated_ = marketVolCube_;
         if(isAtmCalibrated_){
             fillVolatilityCube();
-            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_);
+            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_, denseNodes_);
             denseParameters_.updateInterpolators();
         }
         notifyObservers();
@@ -344,73 +375,148 @@ namespace QuantLib {
     template <class Model>
     typename XabrSwaptionVolatilityCube<Model>::Cube
     XabrSwaptionVolatilityCube<Model>::sabrCalibration(const Cube &marketVolCube) const {
+        std::vector<NodeCalibration> nodes;
+        return sabrCalibration(marketVolCube, nodes);
+    }
+
+    template <class Model>
+    std::vector<Real> XabrSwaptionVolatilityCube<Model>::calibrateNode(
+                                    const NodeCalibration& node,
+                                    const std::vector<Real>& guess) const {
+        const ext::shared_ptr<typename Model::Interpolation> sabrInterpolation =
+            ext::shared_ptr<typename Model::Interpolation>(new
+                                  (typename Model::Interpolation)(node.strikes.begin(),
+                                  node.strikes.end(),
+                                  node.volatilities.begin(),
+                                  node.optionTime, node.forward,
+                                  guess[0], guess[1],
+                                  guess[2], guess[3],
+                                  isParameterFixed_[0],
+                                  isParameterFixed_[1],
+                                  isParameterFixed_[2],
+                                  isParameterFixed_[3],
+                                  vegaWeightedSmileFit_,
+                                  endCriteria_,
+                                  optMethod_,
+                                  errorAccept_,
+                                  useMaxError_,
+                                  maxGuesses_,
+                                  node.shift,
+                                  volatilityType_));
+        sabrInterpolation->update();
+
+        std::vector<Real> result(8);
+        result[0] = sabrInterpolation->alpha();
+        result[1] = sabrInterpolation->beta();
+        result[2] = sabrInterpolation->nu();
+        result[3] = sabrInterpolation->rho();
+        result[4] = node.forward;
+        result[5] = sabrInterpolation->rmsError();
+        result[6] = sabrInterpolation->maxError();
+        result[7] = sabrInterpolation->endCriteria();
+        return result;
+    }
+
+    template <class Model>
+    typename XabrSwaptionVolatilityCube<Model>::Cube
+    XabrSwaptionVolatilityCube<Model>::sabrCalibration(
+                                    const Cube &marketVolCube,
+                                    std::vector<NodeCalibration>& nodes) const {
 
         const std::vector<Time>& optionTimes = marketVolCube.optionTimes();
         const std::vector<Time>& swapLengths = marketVolCube.swapLengths();
         const std::vector<Date>& optionDates = marketVolCube.optionDates();
         const std::vector<Period>& swapTenors = marketVolCube.swapTenors();
-        Matrix alphas(optionTimes.size(), swapLengths.size(),0.);
-        Matrix betas(alphas);
-        Matrix nus(alphas);
-        Matrix rhos(alphas);
-        Matrix forwards(alphas);
-        Matrix errors(alphas);
-        Matrix maxErrors(alphas);
-        Matrix endCriteria(alphas);
+        const Size nOptions = optionTimes.size(), nSwaps = swapLengths.size();
 
         const std::vector<Matrix>& tmpMarketVolCube = marketVolCube.points();
 
-        std::vector<Real> strikes(strikeSpreads_.size());
-        std::vector<Real> volatilities(strikeSpreads_.size());
-
-        for (Size j=0; j<optionTimes.size(); j++) {
-            for (Size k=0; k<swapLengths.size(); k++) {
-                Rate atmForward = atmStrike(optionDates[j], swapTenors[k]);
-                Real shiftTmp = atmVol_->shift(optionTimes[j], swapLengths[k]);
-                strikes.clear();
-                volatilities.clear();
+        // the previous results can only be reused on the same grid
+        if (nodes.size() != nOptions*nSwaps)
+            nodes = std::vector<NodeCalibration>(nOptions*nSwaps);
+
+        // Collect the inputs of each node.  This touches the
+        // term-structure machinery (lazy objects, observers) and is
+        // therefore done serially; nodes whose inputs did not change
+        // since the last calibration keep their previous results.
+        std::vector<Size> toBeCalibrated;
+        std::vector<std::vector<Real> > guesses;
+        for (Size j=0; j<nOptions; j++) {
+            for (Size k=0; k<nSwaps; k++) {
+                NodeCalibration node;
+                node.optionTime = optionTimes[j];
+                node.forward = atmStrike(optionDates[j], swapTenors[k]);
+                node.shift = atmVol_->shift(optionTimes[j], swapLengths[k]);
                 for (Size i=0; i<nStrikes_; i++){
-                    Real strike = atmForward+strikeSpreads_[i];
-                    if(strike + shiftTmp >=cutoffStrike_) {
-                        strikes.push_back(strike);
-                        volatilities.push_back(tmpMarketVolCube[i][j][k]);
+                    Real strike = node.forward+strikeSpreads_[i];
+                    if(strike + node.shift >=cutoffStrike_) {
+                        node.strikes.push_back(strike);
+                        node.volatilities.push_back(tmpMarketVolCube[i][j][k]);
                     }
                 }
+                node.guess = parametersGuess_(optionTimes[j], swapLengths[k]);
+
+                NodeCalibration& previous = nodes[j*nSwaps+k];
+                if (!previous.result.empty() && previous.sameInputsAs(node))
+                    continue;
+
+                // when warm-starting, free parameters start from the
+                // previous solution; fixed ones keep the given guess.
+                std::vector<Real> guess = node.guess;
+                if (warmStart_ && !previous.result.empty()) {
+                    for (Size i=0; i<4; ++i)
+                        if (!isParameterFixed_[i])
+                            guess[i] = previous.result[i];
+                }
+                previous = node;
+                toBeCalibrated.push_back(j*nSwaps+k);
+                guesses.push_back(guess);
+            }
+        }
 
-                const std::vector<Real>& guess =
-                    parametersGuess_(optionTimes[j], swapLengths[k]);
+        // The node fits are independent.  Each interpolation creates
+        // its own optimizer unless one was passed to the cube, in which
+        // case the shared (stateful) method forces a serial run.
+        const auto nCalibrations = static_cast<long>(toBeCalibrated.size());
+        smileFits_ += toBeCalibrated.size();
+        std::vector<std::exception_ptr> failures(toBeCalibrated.size());
+        #pragma omp parallel for schedule(dynamic) if(!optMethod_ && nCalibrations > 1)
+        for (long n=0; n<nCalibrations; ++n) {
+            NodeCalibration& node = nodes[toBeCalibrated[n]];
+            try {
+                node.result = calibrateNode(node, guesses[n]);
+            } catch (...) {
+                node.result.clear();
+                failures[n] = std::current_exception();
+            }
+        }
+        for (auto& failure : failures) {
+            if (failure)
+                std::rethrow_exception(failure);
+        }
 
-                const ext::shared_ptr<typename Model::Interpolation> sabrInterpolation =
-                    ext::shared_ptr<typename Model::Interpolation>(new
-                                          (typename Model::Interpolation)(strikes.begin(), strikes.end(),
-                                          volatilities.begin(),
-                                          optionTimes[j], atmForward,
-                                          guess[0], guess[1],
-                                          guess[2], guess[3],
-                                          isParameterFixed_[0],
-                                          isParameterFixed_[1],
-                                          isParameterFixed_[2],
-                                          isParameterFixed_[3],
-                                          vegaWeightedSmileFit_,
-                                          endCriteria_,
-                                          optMethod_,
-                                          errorAccept_,
-                                          useMaxError_,
-                                          maxGuesses_,
-                                          shiftTmp,
-                                          volatilityType_));
-                sabrInterpolation->update();
-
-                Real rmsError = sabrInterpolation->rmsError();
-                Real maxError = sabrInterpolation->maxError();
-                alphas     [j][k] = sabrInterpolation->alpha();
-                betas      [j][k] = sabrInterpolation->beta();
-                nus        [j][k] = sabrInterpolation->nu();
-                rhos       [j][k] = sabrInterpolation->rho();
-                forwards   [j][k] = atmForward;
-                errors     [j][k] = rmsError;
-                maxErrors  [j][k] = maxError;
-                endCriteria[j][k] = sabrInterpolation->endCriteria();
+        Matrix alphas(nOptions, nSwaps, 0.);
+        Matrix betas(alphas);
+        Matrix nus(alphas);
+        Matrix rhos(alphas);
+        Matrix forwards(alphas);
+        Matrix errors(alphas);
+        Matrix maxErrors(alphas);
+        Matrix endCriteria(alphas);
+
+        for (Size j=0; j<nOptions; j++) {
+            for (Size k=0; k<nSwaps; k++) {
+                const std::vector<Real>& result = nodes[j*nSwaps+k].result;
+                alphas     [j][k] = result[0];
+                betas      [j][k] = result[1];
+                nus        [j][k] = result[2];
+                rhos       [j][k] = result[3];
+                forwards   [j][k] = result[4];
+                errors     [j][k] = result[5];
+                maxErrors  [j][k] = result[6];
+                endCriteria[j][k] = result[7];
+                Real rmsError = errors[j][k];
+                Real maxError = maxErrors[j][k];
 
                 QL_ENSURE(endCriteria[j][k] != Integer(EndCriteria::MaxIterations),
                           "global swaptions calibration failed: "
@@ -31,6 +31,7 @@
 #include <ql/termstructures/interpolatedcurve.hpp>
 #include <ql/math/interpolations/loginterpolation.hpp>
 #include <ql/math/comparison.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -95,6 +96,9 @@ namespace QuantLib {
         //! \name YieldTermStructure implementation
         //@{
         DiscountFactor discountImpl(Time) const override;
+        void discountsImpl(const Time* t,
+                           DiscountFactor* out,
+                           Size n) const override;
         //@}
         mutable std::vector<Date> dates_;
       private:
@@ -168,6 +172,24 @@ namespace QuantLib {
         return dMax * std::exp(- instFwdMax * (t-tMax));
     }
 
+    template <class T>
+    void InterpolatedDiscountCurve<T>::discountsImpl(const Time* t,
+                                                     DiscountFactor* out,
+                                                     Size n) const {
+        // times are sorted, so the ones past the last node are at the end
+        Time tMax = this->times_.back();
+        Size m = std::upper_bound(t, t+n, tMax) - t;
+        this->interpolation_(t, out, m, true);
+        if (m == n)
+            return;
+
+        // flat fwd extrapolation
+        DiscountFactor dMax = this->data_.back();
+        Rate instFwdMax = - this->interpolation_.derivative(tMax) / dMax;
+        for (Size i=m; i<n; ++i)
+            out[i] = dMax * std::exp(- instFwdMax * (t[i]-tMax));
+    }
+
     template <class T>
     InterpolatedDiscountCurve<T>::InterpolatedDiscountCurve(
                                     const DayCounter& dayCounter,
@@ -84,6 +84,9 @@ namespace QuantLib {
         //! \name YieldTermStructure implementation
         //@{
         DiscountFactor discountImpl(Time) const override;
+        void discountsImpl(const Time* t,
+                           DiscountFactor* out,
+                           Size n) const override;
         //@}
 
         Handle<Quote> forward_;
@@ -103,6 +106,14 @@ namespace QuantLib {
         calculate();
         return rate_.discountFactor(t);
     }
+
+    inline void FlatForward::discountsImpl(const Time* t,
+                                           DiscountFactor* out,
+                                           Size n) const {
+        calculate();
+        for (Size i=0; i<n; ++i)
+            out[i] = rate_.discountFactor(t[i]);
+    }
   
     inline void FlatForward::performCalculations() const {
         rate_ = InterestRate(forward_->value(), dayCounter(),
@@ -30,6 +30,7 @@
 #include <ql/termstructures/interpolatedcurve.hpp>
 #include <ql/math/interpolations/backwardflatinterpolation.hpp>
 #include <ql/math/comparison.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -95,6 +96,9 @@ namespace QuantLib {
         //@{
         Rate forwardImpl(Time t) const override;
         Rate zeroYieldImpl(Time t) const override;
+        void discountsImpl(const Time* t,
+                           DiscountFactor* out,
+                           Size n) const override;
         //@}
         mutable std::vector<Date> dates_;
       private:
@@ -178,6 +182,34 @@ namespace QuantLib {
         return integral/t;
     }
 
+    template <class T>
+    void InterpolatedForwardCurve<T>::discountsImpl(const Time* t,
+                                                    DiscountFactor* out,
+                                                    Size n) const {
+        // times are sorted, so the ones past the last node are at the end
+        Time tMax = this->times_.back();
+        Size m = std::upper_bound(t, t+n, tMax) - t;
+        Size hint = 0;
+        for (Size i=0; i<m; ++i) {
+            if (t[i] == 0.0) {
+                out[i] = 1.0;
+            } else {
+                Rate r = this->interpolation_.primitive(t[i], hint, true)/t[i];
+                out[i] = DiscountFactor(std::exp(-r*t[i]));
+            }
+        }
+        if (m == n)
+            return;
+
+        // flat fwd extrapolation
+        Real integralMax = this->interpolation_.primitive(tMax, true);
+        for (Size i=m; i<n; ++i) {
+            Real integral = integralMax + this->data_.back()*(t[i] - tMax);
+            Rate r = integral/t[i];
+            out[i] = DiscountFactor(std::exp(-r*t[i]));
+        }
+    }
+
     template <class T>
     InterpolatedForwardCurve<T>::InterpolatedForwardCurve(
                                     const DayCounter& dayCounter,
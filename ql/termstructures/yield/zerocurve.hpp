@@ -32,6 +32,7 @@
 #include <ql/interestrate.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -102,6 +103,9 @@ namespace QuantLib {
         //! \name ZeroYieldStructure implementation
         //@{
         Rate zeroYieldImpl(Time t) const override;
+        void discountsImpl(const Time* t,
+                           DiscountFactor* out,
+                           Size n) const override;
         //@}
         mutable std::vector<Date> dates_;
       private:
@@ -169,6 +173,33 @@ namespace QuantLib {
         return (zMax * tMax + instFwdMax * (t-tMax)) / t;
     }
 
+    template <class T>
+    void InterpolatedZeroCurve<T>::discountsImpl(const Time* t,
+                                                 DiscountFactor* out,
+                                                 Size n) const {
+        // times are sorted, so the ones past the last node are at the end
+        Time tMax = this->times_.back();
+        Size m = std::upper_bound(t, t+n, tMax) - t;
+        // interpolate the zero rates in place, then convert them
+        this->interpolation_(t, out, m, true);
+        for (Size i=0; i<m; ++i) {
+            if (t[i] == 0.0)
+                out[i] = 1.0;
+            else
+                out[i] = DiscountFactor(std::exp(-out[i]*t[i]));
+        }
+        if (m == n)
+            return;
+
+        // flat fwd extrapolation
+        Rate zMax = this->data_.back();
+        Rate instFwdMax = zMax + tMax * this->interpolation_.derivative(tMax);
+        for (Size i=m; i<n; ++i) {
+            Rate r = (zMax * tMax + instFwdMax * (t[i]-tMax)) / t[i];
+            out[i] = DiscountFactor(std::exp(-r*t[i]));
+        }
+    }
+
     template <class T>
     InterpolatedZeroCurve<T>::InterpolatedZeroCurve(
                                     const DayCounter& dayCounter,
@@ -27,6 +27,7 @@
 
 #include <ql/quote.hpp>
 #include <ql/termstructures/yield/zeroyieldstructure.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -67,6 +68,9 @@ namespace QuantLib {
       protected:
         //! returns the spreaded zero yield rate
         Rate zeroYieldImpl(Time) const override;
+        void discountsImpl(const Time* t,
+                           DiscountFactor* out,
+                           Size n) const override;
         //! returns the spreaded forward rate
         /* This method must disappear should the spread become a curve */
         Rate forwardImpl(Time) const;
@@ -140,6 +144,31 @@ namespace QuantLib {
         return spreadedRate.equivalentRate(Continuous, NoFrequency, t);
     }
 
+    inline void ZeroSpreadedTermStructure::discountsImpl(const Time* t,
+                                                         DiscountFactor* out,
+                                                         Size n) const {
+        // times are sorted, so null times are at the beginning
+        Size m = std::upper_bound(t, t+n, 0.0) - t;
+        std::fill(out, out+m, 1.0);
+        if (m == n)
+            return;
+
+        // same as zeroYieldImpl, with a single query to the original curve
+        originalCurve_->discounts(t+m, out+m, n-m, true);
+        DayCounter dc = originalCurve_->dayCounter();
+        Spread spread = spread_->value();
+        for (Size i=m; i<n; ++i) {
+            InterestRate zeroRate =
+                InterestRate::impliedRate(1.0/out[i], dc, comp_, freq_, t[i]);
+            InterestRate spreadedRate(zeroRate + spread,
+                                      zeroRate.dayCounter(),
+                                      zeroRate.compounding(),
+                                      zeroRate.frequency());
+            Rate r = spreadedRate.equivalentRate(Continuous, NoFrequency, t[i]);
+            out[i] = DiscountFactor(std::exp(-r*t[i]));
+        }
+    }
+
     inline Rate ZeroSpreadedTermStructure::forwardImpl(Time t) const {
         return originalCurve_->forwardRate(t, t, comp_, freq_, true)
             + spread_->value();
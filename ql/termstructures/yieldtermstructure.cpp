@@ -21,6 +21,7 @@
 
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -95,6 +96,46 @@ namespace QuantLib {
         return jumpEffect * discountImpl(t);
     }
 
+    void YieldTermStructure::discounts(const Time* t,
+                                       DiscountFactor* out,
+                                       Size n,
+                                       bool extrapolate) const {
+        if (n == 0)
+            return;
+
+        for (Size k=1; k<n; ++k)
+            QL_REQUIRE(t[k] >= t[k-1],
+                       "unsorted times: " << t[k] << " after " << t[k-1]);
+        // the times are sorted, so checking the extremes is enough
+        checkRange(t[0], extrapolate);
+        checkRange(t[n-1], extrapolate);
+
+        discountsImpl(t, out, n);
+
+        for (Size i=0; i<nJumps_; ++i) {
+            if (jumpTimes_[i] <= 0)
+                continue;
+            Size first = std::upper_bound(t, t+n, jumpTimes_[i]) - t;
+            if (first == n)
+                continue;
+            QL_REQUIRE(jumps_[i]->isValid(),
+                       "invalid " << io::ordinal(i+1) << " jump quote");
+            DiscountFactor thisJump = jumps_[i]->value();
+            QL_REQUIRE(thisJump > 0.0,
+                       "invalid " << io::ordinal(i+1) << " jump value: " <<
+                       thisJump);
+            for (Size k=first; k<n; ++k)
+                out[k] *= thisJump;
+        }
+    }
+
+    void YieldTermStructure::discountsImpl(const Time* t,
+                                           DiscountFactor* out,
+                                           Size n) const {
+        for (Size k=0; k<n; ++k)
+            out[k] = discountImpl(t[k]);
+    }
+
     InterestRate YieldTermStructure::zeroRate(const Date& d,
                                               const DayCounter& dayCounter,
                                               Compounding comp,
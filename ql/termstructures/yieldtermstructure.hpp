@@ -75,6 +75,15 @@ namespace QuantLib {
         */
         DiscountFactor discount(Time t,
                                 bool extrapolate = false) const;
+        /*! Fills out[i] with the discount factor at t[i] for i in
+            [0,n).  The times must be sorted in increasing order;
+            derived classes can take advantage of this to avoid
+            repeated searches over their nodes.
+        */
+        void discounts(const Time* t,
+                       DiscountFactor* out,
+                       Size n,
+                       bool extrapolate = false) const;
         //@}
 
         /*! \name Zero-yield rates
@@ -165,6 +174,12 @@ namespace QuantLib {
         //@{
         //! discount factor calculation
         virtual DiscountFactor discountImpl(Time) const = 0;
+        /*! discount factor calculation for sorted times; the default
+            implementation calls discountImpl for each of them.
+        */
+        virtual void discountsImpl(const Time* t,
+                                   DiscountFactor* out,
+                                   Size n) const;
         //@}
       private:
         // methods
@@ -52,6 +52,28 @@ namespace QuantLib {
                 && tenor >= 1*Months;
         }
 
+        // upper bound for the number of dates generated by a tenor
+        Size estimatedSize(const Date& start, const Date& end, const Period& tenor) {
+            Date::serial_type days;
+            switch (tenor.units()) {
+              case Days:
+                days = tenor.length();
+                break;
+              case Weeks:
+                days = 7 * tenor.length();
+                break;
+              case Months:
+                days = 28 * tenor.length();
+                break;
+              case Years:
+                days = 365 * tenor.length();
+                break;
+              default:
+                days = 1;
+            }
+            return Size((end - start) / std::max<Date::serial_type>(days, 1)) + 3;
+        }
+
     }
 
 
@@ -188,6 +210,14 @@ namespace QuantLib {
         Calendar nullCalendar = NullCalendar();
         Integer periods = 1;
         Date seed, exitDate;
+        // the adjusted last date is kept to avoid adjusting it again
+        // at each step of the generation loops
+        Date lastAdjusted;
+        if (*rule_ != DateGeneration::Zero) {
+            Size n = estimatedSize(effectiveDate, terminationDate, *tenor_);
+            dates_.reserve(n);
+            isRegular_.reserve(n);
+        }
         switch (*rule_) {
 
           case DateGeneration::Zero:
@@ -214,31 +244,34 @@ namespace QuantLib {
             if (firstDate_ != Date())
                 exitDate = firstDate_;
 
+            lastAdjusted = calendar_.adjust(dates_.back(), convention);
             for (;;) {
                 Date temp = nullCalendar.advance(seed,
                     -periods*(*tenor_), convention, *endOfMonth_);
                 if (temp < exitDate) {
-                    if (firstDate_ != Date() &&
-                        (calendar_.adjust(dates_.back(),convention)!=
-                         calendar_.adjust(firstDate_,convention))) {
-                        dates_.push_back(firstDate_);
-                        isRegular_.push_back(false);
+                    if (firstDate_ != Date()) {
+                        Date firstAdjusted = calendar_.adjust(firstDate_, convention);
+                        if (lastAdjusted != firstAdjusted) {
+                            dates_.push_back(firstDate_);
+                            isRegular_.push_back(false);
+                            lastAdjusted = firstAdjusted;
+                        }
                     }
                     break;
                 } else {
                     // skip dates that would result in duplicates
                     // after adjustment
-                    if (calendar_.adjust(dates_.back(),convention)!=
-                        calendar_.adjust(temp,convention)) {
+                    Date tempAdjusted = calendar_.adjust(temp, convention);
+                    if (lastAdjusted != tempAdjusted) {
                         dates_.push_back(temp);
                         isRegular_.push_back(true);
+                        lastAdjusted = tempAdjusted;
                     }
                     ++periods;
                 }
             }
 
-            if (calendar_.adjust(dates_.back(),convention)!=
-                calendar_.adjust(effectiveDate,convention)) {
+            if (lastAdjusted != calendar_.adjust(effectiveDate,convention)) {
                 dates_.push_back(effectiveDate);
                 isRegular_.push_back(false);
             }
@@ -305,13 +338,13 @@ namespace QuantLib {
             exitDate = terminationDate;
             if (nextToLastDate_ != Date())
                 exitDate = nextToLastDate_;
+            lastAdjusted = calendar_.adjust(dates_.back(), convention);
             for (;;) {
                 Date temp = nullCalendar.advance(seed, periods*(*tenor_),
                                                  convention, *endOfMonth_);
                 if (temp > exitDate) {
                     if (nextToLastDate_ != Date() &&
-                        (calendar_.adjust(dates_.back(),convention)!=
-                         calendar_.adjust(nextToLastDate_,convention))) {
+                        (lastAdjusted != calendar_.adjust(nextToLastDate_,convention))) {
                         dates_.push_back(nextToLastDate_);
                         isRegular_.push_back(false);
                     }
@@ -319,10 +352,11 @@ namespace QuantLib {
                 } else {
                     // skip dates that would result in duplicates
                     // after adjustment
-                    if (calendar_.adjust(dates_.back(),convention)!=
-                        calendar_.adjust(temp,convention)) {
+                    Date tempAdjusted = calendar_.adjust(temp, convention);
+                    if (lastAdjusted != tempAdjusted) {
                         dates_.push_back(temp);
                         isRegular_.push_back(true);
+                        lastAdjusted = tempAdjusted;
                     }
                     ++periods;
                 }
@@ -0,0 +1,52 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/time/schedulecache.hpp>
+
+namespace QuantLib {
+
+    ext::shared_ptr<const Schedule>
+    ScheduleCache::schedule(const Date& effectiveDate,
+                            const Date& terminationDate,
+                            const Period& tenor,
+                            const Calendar& calendar,
+                            BusinessDayConvention convention,
+                            BusinessDayConvention terminationDateConvention,
+                            DateGeneration::Rule rule,
+                            bool endOfMonth,
+                            const Date& firstDate,
+                            const Date& nextToLastDate) {
+        if (effectiveDate == Date())
+            return ext::make_shared<const Schedule>(
+                effectiveDate, terminationDate, tenor, calendar, convention,
+                terminationDateConvention, rule, endOfMonth, firstDate, nextToLastDate);
+
+        key_type key(effectiveDate, terminationDate, tenor.length(), tenor.units(),
+                     calendar.empty() ? std::string() : calendar.name(),
+                     convention, terminationDateConvention, rule, endOfMonth,
+                     firstDate, nextToLastDate);
+        auto i = schedules_.lower_bound(key);
+        if (i == schedules_.end() || schedules_.key_comp()(key, i->first)) {
+            auto s = ext::make_shared<const Schedule>(
+                effectiveDate, terminationDate, tenor, calendar, convention,
+                terminationDateConvention, rule, endOfMonth, firstDate, nextToLastDate);
+            i = schedules_.emplace_hint(i, std::move(key), std::move(s));
+        }
+        return i->second;
+    }
+
+}
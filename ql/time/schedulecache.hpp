@@ -0,0 +1,83 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file schedulecache.hpp
+    \brief global repository of rule-based schedules
+*/
+
+#ifndef quantlib_schedule_cache_hpp
+#define quantlib_schedule_cache_hpp
+
+#include <ql/patterns/singleton.hpp>
+#include <ql/time/schedule.hpp>
+#include <map>
+#include <tuple>
+
+namespace QuantLib {
+
+    //! global repository of rule-based schedules
+    /*! Portfolios often contain many instruments with the same
+        schedules; this class generates each schedule on first
+        request and returns the same immutable instance afterwards.
+
+        \warning calendars are identified by name.  The cache must be
+                 cleared after holidays are added to or removed from
+                 a calendar used by cached schedules, and calendars
+                 with the same name but different holidays (e.g.,
+                 bespoke calendars) must not be mixed.
+
+        \ingroup datetime
+    */
+    class ScheduleCache : public Singleton<ScheduleCache> {
+        friend class Singleton<ScheduleCache>;
+
+      private:
+        ScheduleCache() = default;
+
+      public:
+        //! returns the schedule generated by the given rule
+        /*! The arguments have the same meaning as in the rule-based
+            Schedule constructor.  Schedules with a null effective
+            date depend on the evaluation date and are generated
+            without being stored.
+        */
+        ext::shared_ptr<const Schedule> schedule(const Date& effectiveDate,
+                                                 const Date& terminationDate,
+                                                 const Period& tenor,
+                                                 const Calendar& calendar,
+                                                 BusinessDayConvention convention,
+                                                 BusinessDayConvention terminationDateConvention,
+                                                 DateGeneration::Rule rule,
+                                                 bool endOfMonth,
+                                                 const Date& firstDate = Date(),
+                                                 const Date& nextToLastDate = Date());
+        //! returns the number of stored schedules
+        Size size() const { return schedules_.size(); }
+        //! removes all stored schedules
+        void clear() { schedules_.clear(); }
+
+      private:
+        typedef std::tuple<Date, Date, Integer, TimeUnit, std::string,
+                           BusinessDayConvention, BusinessDayConvention,
+                           DateGeneration::Rule, bool, Date, Date> key_type;
+        std::map<key_type, ext::shared_ptr<const Schedule> > schedules_;
+    };
+
+}
+
+
+#endif
@@ -47,6 +47,13 @@
 //#   define QL_ENABLE_TRACING
 #endif
 
+/* Define this if hot paths should be instrumented with timers and
+   counters (whether data are actually collected will depend on
+   run-time settings.) */
+#ifndef QL_ENABLE_INSTRUMENTATION
+//#   define QL_ENABLE_INSTRUMENTATION
+#endif
+
 /* Define this if extra safety checks should be performed. This can degrade
    performance. */
 #ifndef QL_EXTRA_SAFETY_CHECKS
@@ -96,6 +103,12 @@
 #    define QL_FASTER_LAZY_OBJECTS
 #endif
 
+/* Define this to delegate matrix products to a CBLAS library, which
+   must then be linked to the library; Real must be double. */
+#ifndef QL_USE_CBLAS
+//#    define QL_USE_CBLAS
+#endif
+
 /* Define this to use std::any instead of boost::any. */
 #ifndef QL_USE_STD_ANY
 //#    define QL_USE_STD_ANY
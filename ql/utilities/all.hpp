@@ -1,9 +1,13 @@
 /* This file is automatically generated; do not edit.     */
 /* Add the files to be included into Makefile.am instead. */
 
+#include <ql/utilities/binaryio.hpp>
 #include <ql/utilities/clone.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/utilities/dataparsers.hpp>
+#include <ql/utilities/densedatemap.hpp>
+#include <ql/utilities/instrumentation.hpp>
+#include <ql/utilities/instrumentationmacros.hpp>
 #include <ql/utilities/null.hpp>
 #include <ql/utilities/null_deleter.hpp>
 #include <ql/utilities/observablevalue.hpp>
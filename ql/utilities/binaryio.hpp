@@ -0,0 +1,168 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file binaryio.hpp
+    \brief raw binary input and output of flat data
+*/
+
+#ifndef quantlib_binary_io_hpp
+#define quantlib_binary_io_hpp
+
+#include <ql/errors.hpp>
+#include <ql/types.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        /* Binary files written by the library start with an 8-byte
+           tag, a version number, the size of Real and a byte-order
+           mark; they are not meant to be portable across platforms
+           with different representations of Real.  Arrays follow as
+           a 64-bit size and their contiguous elements, so that they
+           can be read with a single call each.
+        */
+
+        template <class T>
+        void writeBinary(std::ostream& out, const T& x) {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "only trivially copyable types can be written");
+            out.write(reinterpret_cast<const char*>(&x), sizeof(T));
+        }
+
+        template <class T>
+        T readBinary(std::istream& in) {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "only trivially copyable types can be read");
+            T x;
+            in.read(reinterpret_cast<char*>(&x), sizeof(T));
+            QL_REQUIRE(in, "unexpected end of binary data");
+            return x;
+        }
+
+        template <class T>
+        void writeBinaryVector(std::ostream& out, const std::vector<T>& v) {
+            writeBinary(out, std::uint64_t(v.size()));
+            out.write(reinterpret_cast<const char*>(v.data()),
+                      std::streamsize(v.size() * sizeof(T)));
+        }
+
+        /* Reads the size of an array and checks it against the data
+           left in the stream, so that corrupted data don't cause huge
+           allocations.  Streams that can't seek don't allow the
+           check; the caller must then read the elements in chunks. */
+        inline std::uint64_t readBinarySize(std::istream& in,
+                                            std::size_t elementSize,
+                                            bool& checked) {
+            auto n = readBinary<std::uint64_t>(in);
+            std::istream::pos_type here = in.tellg();
+            checked = here != std::istream::pos_type(-1) &&
+                      in.seekg(0, std::ios_base::end);
+            if (checked) {
+                std::istream::pos_type end = in.tellg();
+                in.seekg(here);
+                QL_REQUIRE(in && end != std::istream::pos_type(-1),
+                           "could not determine size of binary data");
+                auto left = std::uint64_t(end - here);
+                QL_REQUIRE(n <= left / elementSize,
+                           "invalid binary data: " << n << " elements of "
+                           << elementSize << " bytes expected, only "
+                           << left << " bytes left");
+            } else {
+                in.clear();
+            }
+            return n;
+        }
+
+        // reads n elements into c, growing it as the data come in
+        // when their number could not be checked in advance
+        template <class C>
+        void readBinaryElements(std::istream& in, C& c, std::uint64_t n, bool checked) {
+            typedef typename C::value_type T;
+            const std::uint64_t chunk = checked ? n : (std::uint64_t(1) << 20) / sizeof(T);
+            for (std::uint64_t read = 0; read < n; ) {
+                std::uint64_t m = std::min(chunk, n - read);
+                c.resize(std::size_t(read + m));
+                in.read(reinterpret_cast<char*>(&c[0] + read),
+                        std::streamsize(m * sizeof(T)));
+                QL_REQUIRE(in, "unexpected end of binary data");
+                read += m;
+            }
+        }
+
+        template <class T>
+        std::vector<T> readBinaryVector(std::istream& in) {
+            bool checked;
+            std::uint64_t n = readBinarySize(in, sizeof(T), checked);
+            std::vector<T> v;
+            readBinaryElements(in, v, n, checked);
+            return v;
+        }
+
+        inline void writeBinaryString(std::ostream& out, const std::string& s) {
+            writeBinary(out, std::uint64_t(s.size()));
+            out.write(s.data(), std::streamsize(s.size()));
+        }
+
+        inline std::string readBinaryString(std::istream& in) {
+            bool checked;
+            std::uint64_t n = readBinarySize(in, 1, checked);
+            std::string s;
+            readBinaryElements(in, s, n, checked);
+            return s;
+        }
+
+        inline void writeBinaryHeader(std::ostream& out,
+                                      const char (&tag)[9],
+                                      std::uint32_t version) {
+            out.write(tag, 8);
+            writeBinary(out, version);
+            writeBinary(out, std::uint32_t(sizeof(Real)));
+            writeBinary(out, std::uint32_t(0x01020304));
+        }
+
+        //! returns the version read from the header
+        inline std::uint32_t readBinaryHeader(std::istream& in,
+                                              const char (&tag)[9],
+                                              std::uint32_t maxVersion) {
+            char buffer[8];
+            in.read(buffer, 8);
+            QL_REQUIRE(in && std::memcmp(buffer, tag, 8) == 0,
+                       "invalid binary data: " << tag << " tag not found");
+            auto version = readBinary<std::uint32_t>(in);
+            QL_REQUIRE(version >= 1 && version <= maxVersion,
+                       "unsupported " << tag << " version (" << version << ")");
+            QL_REQUIRE(readBinary<std::uint32_t>(in) == sizeof(Real) &&
+                       readBinary<std::uint32_t>(in) == 0x01020304,
+                       tag << " data written on an incompatible platform");
+            return version;
+        }
+
+    }
+
+}
+
+
+#endif
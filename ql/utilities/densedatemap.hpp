@@ -0,0 +1,271 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file densedatemap.hpp
+    \brief contiguous date-indexed storage
+*/
+
+#ifndef quantlib_dense_date_map_hpp
+#define quantlib_dense_date_map_hpp
+
+#include <ql/time/date.hpp>
+#include <ql/utilities/null.hpp>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    //! contiguous date-indexed storage
+    /*! Values are stored in a vector indexed by the serial number of
+        their date relative to the earliest stored one, so that
+        lookups take constant time and iteration runs over contiguous
+        memory.  This suits data observed on most days of a range,
+        such as index fixings; sparse data spanning long periods are
+        better kept in a std::map.
+
+        The class provides the subset of the associative-container
+        interface required by TimeSeries, so that
+        <tt>TimeSeries<Real, DenseDateMap<Real> ></tt> can be used in
+        place of <tt>TimeSeries<Real></tt>.  Its iterators are
+        bidirectional and return proxy pairs holding the date and a
+        reference to the stored value.
+
+        \warning dates are stored by serial number; the intraday part
+                 of high-resolution dates is discarded.
+    */
+    template <class T>
+    class DenseDateMap {
+      public:
+        typedef Date key_type;
+        typedef T mapped_type;
+        typedef std::pair<const Date, T> value_type;
+        typedef Size size_type;
+
+        template <bool IsConst>
+        class iterator_base {
+            friend class DenseDateMap<T>;
+            friend class iterator_base<!IsConst>;
+            typedef std::conditional_t<IsConst, const DenseDateMap<T>, DenseDateMap<T> > map_type;
+            typedef std::conditional_t<IsConst, const T&, T&> value_reference;
+          public:
+            typedef std::bidirectional_iterator_tag iterator_category;
+            typedef typename DenseDateMap<T>::value_type value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef std::pair<const Date, value_reference> reference;
+            class pointer {
+              public:
+                explicit pointer(reference r) : r_(std::move(r)) {}
+                const reference* operator->() const { return &r_; }
+              private:
+                reference r_;
+            };
+
+            iterator_base() = default;
+            // allows conversion from mutable to const iterators
+            template <bool C, class = std::enable_if_t<IsConst && !C> >
+            iterator_base(const iterator_base<C>& i) : map_(i.map_), i_(i.i_) {}
+
+            reference operator*() const {
+                return reference(Date(map_->first_ + Date::serial_type(i_)),
+                                 map_->values_[i_]);
+            }
+            pointer operator->() const { return pointer(**this); }
+
+            iterator_base& operator++() {
+                do {
+                    ++i_;
+                } while (i_ < map_->present_.size() && !map_->present_[i_]);
+                return *this;
+            }
+            iterator_base operator++(int) {
+                iterator_base tmp = *this;
+                ++*this;
+                return tmp;
+            }
+            iterator_base& operator--() {
+                do {
+                    --i_;
+                } while (!map_->present_[i_]);
+                return *this;
+            }
+            iterator_base operator--(int) {
+                iterator_base tmp = *this;
+                --*this;
+                return tmp;
+            }
+
+            template <bool C>
+            bool operator==(const iterator_base<C>& other) const {
+                return i_ == other.i_ && map_ == other.map_;
+            }
+            template <bool C>
+            bool operator!=(const iterator_base<C>& other) const {
+                return !(*this == other);
+            }
+
+          private:
+            iterator_base(map_type* map, Size i) : map_(map), i_(i) {}
+            map_type* map_ = nullptr;
+            Size i_ = 0;
+        };
+
+        typedef iterator_base<false> iterator;
+        typedef iterator_base<true> const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        DenseDateMap() = default;
+        //! stores values for consecutive dates starting from \c firstDate
+        /*! Null values are not stored; this allows to load a history
+            with gaps from a flat array in a single pass.
+        */
+        DenseDateMap(const Date& firstDate, std::vector<T> values)
+        : first_(firstDate.serialNumber()), values_(std::move(values)),
+          present_(values_.size(), false) {
+            for (Size i=0; i<values_.size(); ++i) {
+                if (values_[i] != Null<T>()) {
+                    present_[i] = true;
+                    ++size_;
+                }
+            }
+            trim();
+        }
+
+        //! \name Inspectors
+        //@{
+        Size size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        //! first date of the stored range
+        Date firstDate() const { return Date(first_); }
+        //! values on consecutive dates from firstDate(), possibly null
+        /*! Slots without a stored value hold Null<T>(). */
+        const std::vector<T>& data() const { return values_; }
+        //@}
+
+        //! \name Iterators
+        //@{
+        iterator begin() { return iterator(this, firstPresent()); }
+        iterator end() { return iterator(this, values_.size()); }
+        const_iterator begin() const { return const_iterator(this, firstPresent()); }
+        const_iterator end() const { return const_iterator(this, values_.size()); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+        //@}
+
+        //! \name Lookup and modifiers
+        //@{
+        iterator find(const Date& d) {
+            Size i = index(d);
+            return iterator(this, i < values_.size() && present_[i] ? i : values_.size());
+        }
+        const_iterator find(const Date& d) const {
+            Size i = index(d);
+            return const_iterator(this, i < values_.size() && present_[i] ? i : values_.size());
+        }
+        //! returns the stored value, or Null<T>() if none was stored
+        T value(const Date& d) const {
+            Size i = index(d);
+            return i < values_.size() && present_[i] ? values_[i] : Null<T>();
+        }
+        std::pair<iterator, bool> insert(const value_type& v) {
+            Size i = slot(v.first);
+            if (present_[i])
+                return std::make_pair(iterator(this, i), false);
+            values_[i] = v.second;
+            present_[i] = true;
+            ++size_;
+            return std::make_pair(iterator(this, i), true);
+        }
+        T& operator[](const Date& d) {
+            return insert(value_type(d, T())).first->second;
+        }
+        void clear() {
+            values_.clear();
+            present_.clear();
+            size_ = 0;
+        }
+        //@}
+
+      private:
+        // returns values_.size() for dates outside the stored range
+        Size index(const Date& d) const {
+            Date::serial_type s = d.serialNumber();
+            if (s < first_)
+                return values_.size();
+            Size i = Size(s - first_);
+            return i < values_.size() ? i : values_.size();
+        }
+        // returns the slot for the date, extending the range if needed
+        Size slot(const Date& d) {
+            Date::serial_type s = d.serialNumber();
+            if (values_.empty()) {
+                first_ = s;
+                values_.resize(1, Null<T>());
+                present_.resize(1, false);
+                return 0;
+            }
+            if (s < first_) {
+                Size shift = Size(first_ - s);
+                values_.insert(values_.begin(), shift, Null<T>());
+                present_.insert(present_.begin(), shift, false);
+                first_ = s;
+                return 0;
+            }
+            Size i = Size(s - first_);
+            if (i >= values_.size()) {
+                values_.resize(i+1, Null<T>());
+                present_.resize(i+1, false);
+            }
+            return i;
+        }
+        Size firstPresent() const {
+            Size i = 0;
+            while (i < present_.size() && !present_[i])
+                ++i;
+            return i;
+        }
+        // drops leading and trailing empty slots
+        void trim() {
+            Size n = values_.size();
+            while (n > 0 && !present_[n-1])
+                --n;
+            values_.resize(n);
+            present_.resize(n);
+            Size i = firstPresent();
+            if (i > 0) {
+                values_.erase(values_.begin(), values_.begin() + i);
+                present_.erase(present_.begin(), present_.begin() + i);
+                first_ += Date::serial_type(i);
+            }
+        }
+
+        Date::serial_type first_ = 0;
+        std::vector<T> values_;
+        std::vector<bool> present_;
+        Size size_ = 0;
+    };
+
+}
+
+
+#endif
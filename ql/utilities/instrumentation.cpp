@@ -0,0 +1,376 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/errors.hpp>
+#include <ql/utilities/instrumentation.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <ostream>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        namespace {
+
+            long long now() {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count();
+            }
+
+            bool sameName(const char* n1, const char* n2) {
+                return n1 == n2 || std::strcmp(n1, n2) == 0;
+            }
+
+            void writeJsonString(std::ostream& out, const char* s) {
+                out << '"';
+                for (; *s != '\0'; ++s) {
+                    switch (*s) {
+                      case '"':  out << "\\\""; break;
+                      case '\\': out << "\\\\"; break;
+                      default:
+                        if (static_cast<unsigned char>(*s) >= 0x20)
+                            out << *s;
+                    }
+                }
+                out << '"';
+            }
+
+        }
+
+        struct InstrumentationNode {
+            InstrumentationNode(const char* name, InstrumentationNode* parent)
+            : name(name), parent(parent) {}
+
+            InstrumentationNode* child(const char* childName) {
+                for (auto& c : children) {
+                    if (sameName(c->name, childName))
+                        return c.get();
+                }
+                children.push_back(std::make_unique<InstrumentationNode>(childName, this));
+                return children.back().get();
+            }
+
+            void reset() {
+                calls = 0;
+                total = 0;
+                minimum = std::numeric_limits<long long>::max();
+                maximum = 0;
+                for (auto& c : children)
+                    c->reset();
+            }
+
+            const char* name;
+            InstrumentationNode* parent;
+            std::vector<std::unique_ptr<InstrumentationNode> > children;
+            Size calls = 0;
+            long long total = 0;
+            long long minimum = std::numeric_limits<long long>::max();
+            long long maximum = 0;
+        };
+
+        struct InstrumentationEvent {
+            const char* name;
+            long long start, duration;
+        };
+
+        struct InstrumentationCounter {
+            const char* name;
+            Size updates;
+            Real total;
+        };
+
+        // the mutex is only contended while the results are read
+        class InstrumentationThreadData {
+          public:
+            InstrumentationThreadData(const Instrumentation* owner, Size id, Size maxEvents)
+            : owner(owner), id(id), maxEvents(maxEvents), root(nullptr, nullptr),
+              current(&root) {}
+            const Instrumentation* owner;
+            Size id, maxEvents;
+            std::mutex mutex;
+            InstrumentationNode root;
+            InstrumentationNode* current;
+            std::vector<InstrumentationEvent> events;
+            std::vector<InstrumentationCounter> counters;
+        };
+
+        ScopedTimer::ScopedTimer(const char* name)
+        : data_(Instrumentation::instance().threadData()) {
+            if (data_ != nullptr) {
+                std::lock_guard<std::mutex> lock(data_->mutex);
+                data_->current = data_->current->child(name);
+                start_ = now();
+            }
+        }
+
+        ScopedTimer::~ScopedTimer() {
+            if (data_ != nullptr) {
+                long long elapsed = now() - start_;
+                std::lock_guard<std::mutex> lock(data_->mutex);
+                InstrumentationNode* node = data_->current;
+                node->calls += 1;
+                node->total += elapsed;
+                node->minimum = std::min(node->minimum, elapsed);
+                node->maximum = std::max(node->maximum, elapsed);
+                if (data_->events.size() < data_->maxEvents)
+                    data_->events.push_back({node->name, start_, elapsed});
+                data_->current = node->parent;
+            }
+        }
+
+        void addToCounter(const char* name, Real value) {
+            InstrumentationThreadData* data = Instrumentation::instance().threadData();
+            if (data == nullptr)
+                return;
+            std::lock_guard<std::mutex> lock(data->mutex);
+            for (auto& c : data->counters) {
+                if (sameName(c.name, name)) {
+                    c.updates += 1;
+                    c.total += value;
+                    return;
+                }
+            }
+            data->counters.push_back({name, 1, value});
+        }
+
+    }
+
+    namespace {
+
+        // nested executions of a scope with the same name, such as
+        // recursive lazy-object recalculations, are already included in
+        // the outermost one; their time is not added again to the total
+        void collectTimers(const detail::InstrumentationNode& node,
+                           std::vector<const char*>& path,
+                           std::map<std::string, Instrumentation::Timer>& timers) {
+            for (const auto& c : node.children) {
+                bool nested = std::any_of(path.begin(), path.end(), [&](const char* n) {
+                    return detail::sameName(n, c->name);
+                });
+                if (c->calls > 0) {
+                    long long childrenTotal = 0;
+                    for (const auto& cc : c->children)
+                        childrenTotal += cc->total;
+                    auto i = timers.find(c->name);
+                    if (i == timers.end()) {
+                        i = timers.insert(std::make_pair(
+                            std::string(c->name),
+                            Instrumentation::Timer{c->name, 0, 0.0, 0.0,
+                                                   QL_MAX_REAL, 0.0})).first;
+                    }
+                    Instrumentation::Timer& t = i->second;
+                    t.calls += c->calls;
+                    if (!nested)
+                        t.totalTime += Real(c->total) * 1.0e-9;
+                    t.selfTime += Real(c->total - childrenTotal) * 1.0e-9;
+                    t.minTime = std::min(t.minTime, Real(c->minimum) * 1.0e-9);
+                    t.maxTime = std::max(t.maxTime, Real(c->maximum) * 1.0e-9);
+                }
+                path.push_back(c->name);
+                collectTimers(*c, path, timers);
+                path.pop_back();
+            }
+        }
+
+        void collectStacks(const detail::InstrumentationNode& node,
+                           const std::string& path,
+                           std::map<std::string, long long>& stacks) {
+            for (const auto& c : node.children) {
+                std::string childPath = path.empty() ? std::string(c->name)
+                                                     : path + ";" + c->name;
+                if (c->calls > 0) {
+                    long long self = c->total;
+                    for (const auto& cc : c->children)
+                        self -= cc->total;
+                    stacks[childPath] += self;
+                }
+                collectStacks(*c, childPath, stacks);
+            }
+        }
+
+    }
+
+    #if defined(QL_ENABLE_INSTRUMENTATION)
+
+    void Instrumentation::enable(Size maxEventsPerThread) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        maxEvents_ = maxEventsPerThread;
+        for (auto& t : threads_) {
+            std::lock_guard<std::mutex> threadLock(t->mutex);
+            t->maxEvents = maxEventsPerThread;
+        }
+        enabled_ = true;
+    }
+
+    #else
+
+    void Instrumentation::enable(Size) {
+        QL_FAIL("instrumentation support not available");
+    }
+
+    #endif
+
+    void Instrumentation::disable() {
+        enabled_ = false;
+    }
+
+    bool Instrumentation::enabled() const {
+        return enabled_;
+    }
+
+    void Instrumentation::reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // the call trees are kept since open scopes point to them
+        for (auto& t : threads_) {
+            std::lock_guard<std::mutex> threadLock(t->mutex);
+            t->root.reset();
+            t->events.clear();
+            t->counters.clear();
+        }
+    }
+
+    detail::InstrumentationThreadData* Instrumentation::threadData() {
+        if (!enabled_.load(std::memory_order_relaxed))
+            return nullptr;
+        thread_local std::shared_ptr<detail::InstrumentationThreadData> data;
+        // with sessions enabled, a thread might use different instances
+        if (data == nullptr || data->owner != this) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // the data of an exited thread, only owned by the registry,
+            // are taken over so that the registry doesn't grow with
+            // each new thread; the collected data are kept
+            auto exited = std::find_if(threads_.begin(), threads_.end(),
+                                       [](const auto& t) { return t.use_count() == 1; });
+            if (exited != threads_.end()) {
+                data = *exited;
+            } else {
+                data = std::make_shared<detail::InstrumentationThreadData>(
+                    this, threads_.size(), maxEvents_);
+                threads_.push_back(data);
+            }
+        }
+        return data.get();
+    }
+
+    std::vector<Instrumentation::Timer> Instrumentation::timers() const {
+        std::map<std::string, Timer> collected;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& t : threads_) {
+            std::lock_guard<std::mutex> threadLock(t->mutex);
+            std::vector<const char*> path;
+            collectTimers(t->root, path, collected);
+        }
+        std::vector<Timer> result;
+        result.reserve(collected.size());
+        for (auto& i : collected)
+            result.push_back(i.second);
+        std::stable_sort(result.begin(), result.end(),
+                         [](const Timer& t1, const Timer& t2) {
+                             return t1.totalTime > t2.totalTime;
+                         });
+        return result;
+    }
+
+    std::vector<Instrumentation::Counter> Instrumentation::counters() const {
+        std::map<std::string, Counter> collected;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& t : threads_) {
+            std::lock_guard<std::mutex> threadLock(t->mutex);
+            for (const auto& c : t->counters) {
+                auto i = collected.find(c.name);
+                if (i == collected.end())
+                    i = collected.insert(std::make_pair(std::string(c.name),
+                                                        Counter{c.name, 0, 0.0})).first;
+                i->second.updates += c.updates;
+                i->second.total += c.total;
+            }
+        }
+        std::vector<Counter> result;
+        result.reserve(collected.size());
+        for (auto& i : collected)
+            result.push_back(i.second);
+        return result;
+    }
+
+    void Instrumentation::writeCollapsedStacks(std::ostream& out) const {
+        std::map<std::string, long long> stacks;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& t : threads_) {
+                std::lock_guard<std::mutex> threadLock(t->mutex);
+                collectStacks(t->root, std::string(), stacks);
+            }
+        }
+        for (const auto& s : stacks)
+            out << s.first << " " << s.second << "\n";
+    }
+
+    void Instrumentation::writeChromeTrace(std::ostream& out) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        long long origin = std::numeric_limits<long long>::max(), end = 0;
+        for (const auto& t : threads_) {
+            std::lock_guard<std::mutex> threadLock(t->mutex);
+            for (const auto& e : t->events) {
+                origin = std::min(origin, e.start);
+                end = std::max(end, e.start + e.duration);
+            }
+        }
+        if (origin > end)
+            origin = end = 0;
+
+        // times are in microseconds
+        std::ios_base::fmtflags flags = out.flags();
+        out << std::fixed << std::setprecision(3);
+        out << "{\"traceEvents\":[";
+        bool first = true;
+        auto separator = [&]() {
+            out << (first ? "\n" : ",\n");
+            first = false;
+        };
+        for (const auto& t : threads_) {
+            std::lock_guard<std::mutex> threadLock(t->mutex);
+            separator();
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << t->id
+                << ",\"args\":{\"name\":\"thread " << t->id << "\"}}";
+            for (const auto& e : t->events) {
+                separator();
+                out << "{\"name\":";
+                detail::writeJsonString(out, e.name);
+                out << ",\"cat\":\"QuantLib\",\"ph\":\"X\",\"pid\":0,\"tid\":" << t->id
+                    << ",\"ts\":" << Real(e.start - origin) * 1.0e-3
+                    << ",\"dur\":" << Real(e.duration) * 1.0e-3 << "}";
+            }
+            for (const auto& c : t->counters) {
+                separator();
+                out << "{\"name\":";
+                detail::writeJsonString(out, c.name);
+                out << ",\"ph\":\"C\",\"pid\":0,\"tid\":" << t->id
+                    << ",\"ts\":" << Real(end - origin) * 1.0e-3
+                    << ",\"args\":{\"value\":" << c.total << "}}";
+            }
+        }
+        out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+        out.flags(flags);
+    }
+
+}
@@ -0,0 +1,121 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file instrumentation.hpp
+    \brief timing and counting of hot paths
+*/
+
+#ifndef quantlib_instrumentation_hpp
+#define quantlib_instrumentation_hpp
+
+#include <ql/patterns/singleton.hpp>
+#include <ql/utilities/instrumentationmacros.hpp>
+#include <atomic>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Timings and counters collected by instrumented code
+    /*! Parts of the library (lazy-object calculations, pricing
+        engines, bootstraps, finite-difference steps and Monte Carlo
+        sampling) are instrumented with the QL_INSTRUMENT_SCOPE and
+        QL_INSTRUMENT_COUNTER macros.  The macros expand to nothing
+        unless the library is compiled with QL_ENABLE_INSTRUMENTATION
+        defined; when it is, data are only collected after enable()
+        is called.
+
+        Each thread records its timings in its own call tree, so that
+        the time spent in each scope is attributed to the scopes that
+        contain it.  The collected data can be read as aggregated
+        timings, written in the collapsed-stack format used by
+        flame-graph tools, or written as a Chrome trace (viewable in
+        chrome://tracing or Perfetto) if individual events were
+        recorded.
+
+        The data recorded by a thread are kept after it exits and
+        are taken over by the next thread starting to record, so
+        that thread pools being recreated don't use more memory.
+
+        \warning the names passed to the macros must be string
+                 literals, or anyway strings outliving the collected
+                 data; they're stored as pointers.
+    */
+    class Instrumentation : public Singleton<Instrumentation> {
+        friend class Singleton<Instrumentation>;
+      private:
+        Instrumentation() = default;
+      public:
+        //! aggregated timings of a scope over all threads and callers
+        struct Timer {
+            std::string name;
+            Size calls;
+            /*! times in seconds; the total time of a scope executed
+                within another execution of itself (e.g., recursive
+                recalculations) is only counted once, in the
+                outermost one.
+            */
+            Real totalTime, selfTime, minTime, maxTime;
+        };
+        struct Counter {
+            std::string name;
+            Size updates;
+            Real total;
+        };
+        /*! Starts collecting data.  If \c maxEventsPerThread is
+            positive, individual scope executions are also recorded
+            (up to the given number per thread) for Chrome traces.
+        */
+        void enable(Size maxEventsPerThread = 0);
+        void disable();
+        bool enabled() const;
+        //! discards the data collected so far
+        void reset();
+
+        //! \name Results
+        //@{
+        //! sorted by decreasing total time
+        std::vector<Timer> timers() const;
+        //! sorted by name
+        std::vector<Counter> counters() const;
+        /*! Writes a line "outer;...;inner self-time" for each
+            recorded call path, with self times in nanoseconds.
+        */
+        void writeCollapsedStacks(std::ostream&) const;
+        //! writes the recorded events and counters in Chrome trace format
+        void writeChromeTrace(std::ostream&) const;
+        //@}
+
+        //! \name Internals
+        //@{
+        //! data of the calling thread, or null if disabled
+        detail::InstrumentationThreadData* threadData();
+        //@}
+      private:
+        std::atomic<bool> enabled_{false};
+        Size maxEvents_ = 0;
+        mutable std::mutex mutex_;
+        std::vector<std::shared_ptr<detail::InstrumentationThreadData> > threads_;
+    };
+
+}
+
+
+#endif
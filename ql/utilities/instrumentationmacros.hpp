@@ -0,0 +1,111 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file instrumentationmacros.hpp
+    \brief macros for timing and counting hot paths
+
+    This header is light enough to be included by widely used headers;
+    the Instrumentation singleton reading the collected data is
+    declared in <ql/utilities/instrumentation.hpp>.
+*/
+
+#ifndef quantlib_instrumentation_macros_hpp
+#define quantlib_instrumentation_macros_hpp
+
+#include <ql/types.hpp>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        class InstrumentationThreadData;
+
+        class ScopedTimer {
+          public:
+            explicit ScopedTimer(const char* name);
+            ~ScopedTimer();
+            ScopedTimer(const ScopedTimer&) = delete;
+            ScopedTimer(ScopedTimer&&) = delete;
+            ScopedTimer& operator=(const ScopedTimer&) = delete;
+            ScopedTimer& operator=(ScopedTimer&&) = delete;
+          private:
+            InstrumentationThreadData* data_;
+            long long start_ = 0;
+        };
+
+        void addToCounter(const char* name, Real value);
+
+    }
+
+}
+
+/*! \addtogroup macros
+    @{
+*/
+
+/*! \defgroup instrumentationMacros Instrumentation macros
+
+    Hot paths can be instrumented as in:
+    \code
+    void Foo::performCalculations() const {
+        QL_INSTRUMENT_SCOPE("Foo::performCalculations");
+        for (...) {
+            QL_INSTRUMENT_COUNTER("Foo::iterations", 1);
+            ...
+        }
+    }
+    \endcode
+    The time spent until the end of the enclosing scope is recorded
+    under the given name, and counters accumulate the given values.
+    The macros expand to nothing unless QL_ENABLE_INSTRUMENTATION is
+    defined; the collected data are available through the
+    Instrumentation singleton.
+    @{
+*/
+
+/*! \def QL_INSTRUMENT_SCOPE
+    \brief times the enclosing scope under the given name
+*/
+
+/*! \def QL_INSTRUMENT_COUNTER
+    \brief adds the given value to the named counter
+*/
+
+/*! @} */
+
+/*! @} */
+
+#if defined(QL_ENABLE_INSTRUMENTATION)
+
+#define QL_INSTRUMENT_JOIN_(x, y) x##y
+#define QL_INSTRUMENT_JOIN(x, y) QL_INSTRUMENT_JOIN_(x, y)
+
+#define QL_INSTRUMENT_SCOPE(name) \
+QuantLib::detail::ScopedTimer QL_INSTRUMENT_JOIN(ql_scoped_timer_, __LINE__)(name)
+
+#define QL_INSTRUMENT_COUNTER(name, value) \
+QuantLib::detail::addToCounter(name, value)
+
+#else
+
+#define QL_INSTRUMENT_SCOPE(name)
+#define QL_INSTRUMENT_COUNTER(name, value)
+
+#endif
+
+
+#endif
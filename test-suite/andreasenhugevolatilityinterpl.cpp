@@ -860,6 +860,7 @@ BOOST_AUTO_TEST_CASE(testDifferentOptimizers) {
 
     const ext::shared_ptr<OptimizationMethod> optimizationMethods[] = {
         ext::make_shared<LevenbergMarquardt>(),
+        ext::make_shared<LevenbergMarquardt>(1e-8, 1e-8, 1e-8, true),
         ext::make_shared<BFGS>(),
         ext::make_shared<Simplex>(0.2)
     };
@@ -880,6 +881,136 @@ BOOST_AUTO_TEST_CASE(testDifferentOptimizers) {
     }
 }
 
+class JacobianCheck : public OptimizationMethod {
+  public:
+    EndCriteria::Type minimize(Problem& P, const EndCriteria& endCriteria) override {
+        check(P.costFunction(), P.currentValue());
+        const EndCriteria::Type result =
+            LevenbergMarquardt().minimize(P, endCriteria);
+        check(P.costFunction(), P.currentValue());
+        return result;
+    }
+
+    Real maxError = 0.0;
+    Size checks = 0;
+
+  private:
+    // central differences; the default one-sided bump of 1e-8 is
+    // dominated by the round-off of the finite-difference solver
+    void check(const CostFunction& costFunction, const Array& x) {
+        const Size m = costFunction.values(x).size();
+        Matrix jacobian(m, x.size());
+        costFunction.jacobian(jacobian, x);
+
+        const Real h = 1e-5;
+        for (Size j=0; j < x.size(); ++j) {
+            Array xUp(x), xDown(x);
+            xUp[j] += h;
+            xDown[j] -= h;
+            const Array bumped =
+                (costFunction.values(xUp) - costFunction.values(xDown))/(2*h);
+
+            for (Size i=0; i < m; ++i)
+                maxError = std::max(maxError,
+                                    std::fabs(jacobian[i][j] - bumped[i]));
+        }
+        ++checks;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(testJacobianAgainstFiniteDifferences) {
+    BOOST_TEST_MESSAGE(
+        "Testing the Andreasen-Huge calibration Jacobian "
+        "against finite differences...");
+
+    const CalibrationData data[] = {
+        sabrData().first, arbitrageData(), BorovkovaExampleData()
+    };
+
+    const AndreasenHugeVolatilityInterpl::InterpolationType
+        interpolationTypes[] = {
+            AndreasenHugeVolatilityInterpl::CubicSpline,
+            AndreasenHugeVolatilityInterpl::Linear,
+            AndreasenHugeVolatilityInterpl::PiecewiseConstant
+        };
+
+    // the monotonicity filter of the price spline is active on the
+    // coarse grid only
+    const Size gridSizes[] = { 40, 400 };
+
+    const Real tol = 1e-6;
+
+    for (const auto& d : data) {
+        for (auto interpolationType : interpolationTypes) {
+            for (auto gridSize : gridSizes) {
+                const ext::shared_ptr<JacobianCheck> jacobianCheck =
+                    ext::make_shared<JacobianCheck>();
+
+                AndreasenHugeVolatilityInterpl(
+                    d.calibrationSet, d.spot, d.rTS, d.qTS, interpolationType,
+                    AndreasenHugeVolatilityInterpl::CallPut, gridSize,
+                    Null<Real>(), Null<Real>(), jacobianCheck)
+                    .calibrationError();
+
+                if (jacobianCheck->checks == 0
+                    || jacobianCheck->maxError > tol) {
+                    BOOST_ERROR("analytic Jacobian differs from finite differences"
+                                << "\n    interpolation type: " << interpolationType
+                                << "\n    grid size:          " << gridSize
+                                << "\n    checks:             " << jacobianCheck->checks
+                                << "\n    max difference:     " << jacobianCheck->maxError
+                                << "\n    tolerance:          " << tol);
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testCachedSlicesAfterMarketChange) {
+    BOOST_TEST_MESSAGE(
+        "Testing that cached Andreasen-Huge slices are invalidated "
+        "by market changes...");
+
+    const CalibrationData& data = sabrData().first;
+
+    const ext::shared_ptr<AndreasenHugeVolatilityInterpl> ahInterpl =
+        ext::make_shared<AndreasenHugeVolatilityInterpl>(
+            data.calibrationSet, data.spot, data.rTS, data.qTS,
+            AndreasenHugeVolatilityInterpl::CubicSpline,
+            AndreasenHugeVolatilityInterpl::CallPut);
+
+    const AndreasenHugeLocalVolAdapter localVol(ahInterpl);
+
+    const Time t = 0.75;
+    const Real strike = data.spot->value();
+
+    const Real npv = ahInterpl->optionPrice(t, strike, Option::Call);
+    const Volatility vol = localVol.localVol(t, strike, true);
+
+    // repeated queries are served from the cache
+    if (ahInterpl->optionPrice(t, strike, Option::Call) != npv
+        || localVol.localVol(t, strike, true) != vol)
+        BOOST_FAIL("cached slices should reproduce previous results");
+
+    const ext::shared_ptr<SimpleQuote> quote =
+        ext::dynamic_pointer_cast<SimpleQuote>(
+            data.calibrationSet.front().second);
+    const Real quoteValue = quote->value();
+    quote->setValue(quoteValue + 0.01);
+
+    const Real modNpv = ahInterpl->optionPrice(t, strike, Option::Call);
+    const Volatility modVol = localVol.localVol(t, strike, true);
+
+    quote->setValue(quoteValue);
+
+    if (modNpv == npv || modVol == vol)
+        BOOST_FAIL("cached slices should be recalculated after a market change"
+                   << "\n    option price      : " << npv
+                   << "\n    new option price  : " << modNpv
+                   << "\n    local vol         : " << vol
+                   << "\n    new local vol     : " << modVol);
+}
+
 BOOST_AUTO_TEST_CASE(testMovingReferenceDate) {
     BOOST_TEST_MESSAGE(
         "Testing that reference date of adapter surface moves along with "
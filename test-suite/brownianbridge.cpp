@@ -24,6 +24,7 @@
 #include <ql/math/randomnumbers/sobolrsg.hpp>
 #include <ql/math/randomnumbers/inversecumulativersg.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
+#include <ql/models/marketmodels/browniangenerators/sobolbrowniangenerator.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
@@ -243,6 +244,85 @@ BOOST_AUTO_TEST_CASE(testPathGeneration) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testBatchTransform) {
+    BOOST_TEST_MESSAGE("Testing Brownian-bridge transform of batches...");
+
+    std::vector<Time> times = {0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1.0, 2.0, 5.0, 7.0, 9.0, 10.0};
+    TimeGrid grid(times.begin(), times.end());
+    Size N = times.size();
+    Real tolerance = 1.0e-14;
+
+    // single sequences vs batch
+    Size samples = 37;
+    InverseCumulativeRsg<SobolRsg,InverseCumulativeNormal> gsg(SobolRsg(N, 42));
+    BrownianBridge bridge(times);
+    Matrix variates(N, samples), output;
+    std::vector<std::vector<Real> > expected(samples, std::vector<Real>(N));
+    for (Size p=0; p<samples; ++p) {
+        const std::vector<Real>& sequence = gsg.nextSequence().value;
+        for (Size i=0; i<N; ++i)
+            variates[i][p] = sequence[i];
+        bridge.transform(sequence.begin(), sequence.end(), expected[p].begin());
+    }
+    bridge.transform(variates, output);
+
+    BOOST_REQUIRE_EQUAL(output.rows(), N);
+    BOOST_REQUIRE_EQUAL(output.columns(), samples);
+    for (Size p=0; p<samples; ++p) {
+        for (Size i=0; i<N; ++i) {
+            if (std::fabs(output[i][p] - expected[p][i]) > tolerance)
+                BOOST_FAIL("failed to reproduce single-sequence transform"
+                           << "\n    sequence:   " << p
+                           << "\n    variate:    " << i
+                           << "\n    calculated: " << output[i][p]
+                           << "\n    expected:   " << expected[p][i]);
+        }
+    }
+
+    BOOST_CHECK_THROW(bridge.transform(variates, variates), Error);
+    BOOST_CHECK_THROW(bridge.transform(Matrix(N-1, samples), output), Error);
+
+    // market-model generator bridging all paths at once
+    Size factors = 3, steps = 5;
+    SobolBrownianGenerator::Ordering orderings[] = {
+        SobolBrownianGenerator::Factors,
+        SobolBrownianGenerator::Steps,
+        SobolBrownianGenerator::Diagonal
+    };
+    for (auto ordering : orderings) {
+        SobolBrownianGenerator generator(factors, steps, ordering, 42, SobolRsg::JoeKuoD7);
+        InverseCumulativeRsg<SobolRsg,InverseCumulativeNormal> draws(
+                                SobolRsg(factors*steps, 42, SobolRsg::JoeKuoD7));
+        std::vector<std::vector<Real> > sequences(factors*steps,
+                                                  std::vector<Real>(samples));
+        for (Size p=0; p<samples; ++p) {
+            const std::vector<Real>& sequence = draws.nextSequence().value;
+            for (Size k=0; k<factors*steps; ++k)
+                sequences[k][p] = sequence[k];
+        }
+        std::vector<std::vector<Real> > bridged = generator.transform(sequences);
+
+        std::vector<Real> variates(factors);
+        for (Size p=0; p<samples; ++p) {
+            generator.nextPath();
+            for (Size j=0; j<steps; ++j) {
+                generator.nextStep(variates);
+                for (Size i=0; i<factors; ++i) {
+                    Real error = std::fabs(bridged[i][p*steps+j] - variates[i]);
+                    if (error > tolerance)
+                        BOOST_FAIL("failed to reproduce Brownian increments "
+                                   "when bridging all paths at once"
+                                   << "\n    ordering: " << Integer(ordering)
+                                   << "\n    path:     " << p
+                                   << "\n    step:     " << j
+                                   << "\n    factor:   " << i
+                                   << "\n    error:    " << error);
+                }
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
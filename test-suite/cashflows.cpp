@@ -21,6 +21,7 @@
 #include "toplevelfixture.hpp"
 #include "utilities.hpp"
 #include <ql/cashflows/cashflows.hpp>
+#include <ql/cashflows/compiledleg.hpp>
 #include <ql/cashflows/simplecashflow.hpp>
 #include <ql/cashflows/fixedratecoupon.hpp>
 #include <ql/cashflows/floatingratecoupon.hpp>
@@ -31,12 +32,20 @@
 #include <ql/quotes/simplequote.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/actualactual.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
 #include <ql/time/schedule.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/indexes/ibor/usdlibor.hpp>
 #include <ql/indexes/ibor/sofr.hpp>
+#include <ql/instruments/bonds/fixedratebond.hpp>
+#include <ql/instruments/swap.hpp>
 #include <ql/optional.hpp>
+#include <ql/pricingengines/bond/bondfunctions.hpp>
+#include <ql/pricingengines/bond/discountingbondengine.hpp>
+#include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/settings.hpp>
+#include <ql/termstructures/yield/discountcurve.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -618,6 +627,188 @@ BOOST_AUTO_TEST_CASE(testIborCouponKnowsWhenitHasFixed) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testCompiledLeg) {
+    BOOST_TEST_MESSAGE("Testing compiled legs against cash-flow functions...");
+
+    Date today = Settings::instance().evaluationDate();
+
+    auto forecastRate = ext::make_shared<SimpleQuote>(0.03);
+    RelinkableHandle<YieldTermStructure> forecastCurve(
+        ext::make_shared<FlatForward>(today, Handle<Quote>(forecastRate), Actual360()));
+    FlatForward discountCurve(today, 0.025, Actual365Fixed());
+
+    auto index = ext::make_shared<Euribor6M>(forecastCurve);
+    Schedule schedule = MakeSchedule()
+                            .from(today - 1 * Years)
+                            .to(today + 10 * Years)
+                            .withFrequency(Semiannual)
+                            .withCalendar(TARGET())
+                            .withConvention(ModifiedFollowing);
+    index->addFixing(index->fixingDate(schedule[0]), 0.02);
+    index->addFixing(index->fixingDate(schedule[1]), 0.021);
+    index->addFixing(index->fixingDate(schedule[2]), 0.022);
+
+    Leg fixedLeg = FixedRateLeg(schedule)
+        .withNotionals(100.0)
+        .withCouponRates(0.03, Actual360())
+        .withExCouponPeriod(Period(5, Days), TARGET(), Preceding, false);
+    fixedLeg.push_back(ext::make_shared<SimpleCashFlow>(100.0, schedule.endDate()));
+    Leg floatingLeg = IborLeg(schedule, index).withNotionals(100.0);
+
+    Real tolerance = 1.0e-10;
+
+    for (const auto& leg : { fixedLeg, floatingLeg }) {
+        CompiledLeg compiled(leg);
+
+        for (Real rate : { 0.03, 0.01, 0.05 }) {
+            forecastRate->setValue(rate);
+
+            for (Integer days : { 0, 1, 180, 400 }) {
+                Date settlementDate = today + days;
+                Date npvDate = settlementDate + 2;
+                for (bool include : { true, false }) {
+                    Real npv = CashFlows::npv(leg, discountCurve, include,
+                                              settlementDate, npvDate);
+                    Real bps = CashFlows::bps(leg, discountCurve, include,
+                                              settlementDate, npvDate);
+                    std::pair<Real, Real> result =
+                        compiled.npvbps(discountCurve, include,
+                                        settlementDate, npvDate);
+                    if (std::fabs(result.first - npv) > tolerance ||
+                        std::fabs(result.second - bps) > tolerance) {
+                        BOOST_ERROR("compiled leg results differ from cash-flow functions:"
+                                    << "\n    settlement:        " << settlementDate
+                                    << "\n    forecast rate:     " << rate
+                                    << "\n    NPV:               " << result.first
+                                    << "\n    expected:          " << npv
+                                    << "\n    BPS:               " << result.second
+                                    << "\n    expected:          " << bps);
+                    }
+
+                    Rate atm = CashFlows::atmRate(leg, discountCurve, include,
+                                                  settlementDate, npvDate, 120.0);
+                    Rate compiledAtm = compiled.atmRate(discountCurve, include,
+                                                        settlementDate, npvDate, 120.0);
+                    if (std::fabs(atm - compiledAtm) > tolerance) {
+                        BOOST_ERROR("compiled leg ATM rate differs from cash-flow functions:"
+                                    << "\n    settlement:        " << settlementDate
+                                    << "\n    calculated:        " << compiledAtm
+                                    << "\n    expected:          " << atm);
+                    }
+
+                    for (Rate yield : { 0.02, 0.04 }) {
+                        InterestRate y(yield, ActualActual(ActualActual::ISDA),
+                                       Compounded, Semiannual);
+                        for (Duration::Type type :
+                                 { Duration::Simple, Duration::Modified, Duration::Macaulay }) {
+                            Time duration = CashFlows::duration(leg, y, type, include,
+                                                                settlementDate);
+                            Time compiledDuration = compiled.duration(y, type, include,
+                                                                      settlementDate);
+                            if (std::fabs(duration - compiledDuration) > tolerance) {
+                                BOOST_ERROR("compiled leg duration differs from cash-flow functions:"
+                                            << "\n    settlement:        " << settlementDate
+                                            << "\n    yield:             " << y
+                                            << "\n    type:              " << type
+                                            << "\n    calculated:        " << compiledDuration
+                                            << "\n    expected:          " << duration);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testCompiledLegsInEngines) {
+    BOOST_TEST_MESSAGE("Testing discounting engines using compiled legs...");
+
+    Date today = Settings::instance().evaluationDate();
+
+    auto forecastRate = ext::make_shared<SimpleQuote>(0.03);
+    Handle<YieldTermStructure> forecastCurve(
+        ext::make_shared<FlatForward>(today, Handle<Quote>(forecastRate), Actual360()));
+    // an interpolated curve, so that batched discounting is exercised
+    auto discountCurve = ext::make_shared<DiscountCurve>(
+        std::vector<Date>{ today, today + 1*Years, today + 5*Years, today + 15*Years },
+        std::vector<DiscountFactor>{ 1.0, 0.975, 0.88, 0.68 },
+        Actual365Fixed());
+    Handle<YieldTermStructure> discountHandle(discountCurve);
+
+    auto index = ext::make_shared<Euribor6M>(forecastCurve);
+    Schedule schedule = MakeSchedule()
+                            .from(today - 1 * Years)
+                            .to(today + 10 * Years)
+                            .withFrequency(Semiannual)
+                            .withCalendar(TARGET())
+                            .withConvention(ModifiedFollowing);
+    index->addFixing(index->fixingDate(schedule[0]), 0.02);
+    index->addFixing(index->fixingDate(schedule[1]), 0.021);
+    index->addFixing(index->fixingDate(schedule[2]), 0.022);
+
+    Leg fixedLeg = FixedRateLeg(schedule)
+        .withNotionals(100.0)
+        .withCouponRates(0.03, Actual360());
+    Leg floatingLeg = IborLeg(schedule, index).withNotionals(100.0);
+
+    Swap swap(fixedLeg, floatingLeg);
+    swap.setPricingEngine(ext::make_shared<DiscountingSwapEngine>(discountHandle));
+
+    FixedRateBond bond(3, 100.0, schedule, { 0.04 }, Thirty360(Thirty360::BondBasis));
+    bond.setPricingEngine(ext::make_shared<DiscountingBondEngine>(discountHandle));
+
+    Real tolerance = 1.0e-10;
+
+    for (Real rate : { 0.03, 0.01, 0.05 }) {
+        forecastRate->setValue(rate);
+
+        for (Size j=0; j<2; ++j) {
+            const Leg& leg = swap.leg(j);
+            Real sign = swap.payer(j) ? -1.0 : 1.0;
+            Real npv = sign * CashFlows::npv(leg, *discountCurve, false, today, today);
+            Real bps = sign * CashFlows::bps(leg, *discountCurve, false, today, today);
+            DiscountFactor end = discountCurve->discount(CashFlows::maturityDate(leg));
+            if (std::fabs(swap.legNPV(j) - npv) > tolerance ||
+                std::fabs(swap.legBPS(j) - bps) > tolerance ||
+                std::fabs(swap.endDiscounts(j) - end) > tolerance) {
+                BOOST_ERROR("swap results differ from cash-flow functions:"
+                            << "\n    forecast rate:     " << rate
+                            << "\n    leg:               " << j
+                            << "\n    NPV:               " << swap.legNPV(j)
+                            << "\n    expected:          " << npv
+                            << "\n    BPS:               " << swap.legBPS(j)
+                            << "\n    expected:          " << bps
+                            << "\n    end discount:      " << swap.endDiscounts(j)
+                            << "\n    expected:          " << end);
+            }
+        }
+
+        Date settlement = bond.settlementDate();
+        Real npv = CashFlows::npv(bond.cashflows(), *discountCurve, false, today, today);
+        Real settlementValue = CashFlows::npv(bond.cashflows(), *discountCurve, false,
+                                              settlement, settlement);
+        if (std::fabs(bond.NPV() - npv) > tolerance ||
+            std::fabs(bond.settlementValue() - settlementValue) > tolerance) {
+            BOOST_ERROR("bond results differ from cash-flow functions:"
+                        << "\n    NPV:               " << bond.NPV()
+                        << "\n    expected:          " << npv
+                        << "\n    settlement value:  " << bond.settlementValue()
+                        << "\n    expected:          " << settlementValue);
+        }
+
+        InterestRate y(rate, Thirty360(Thirty360::BondBasis), Compounded, Annual);
+        Time duration = CashFlows::duration(bond.cashflows(), y, Duration::Modified,
+                                            false, settlement);
+        Time bondDuration = BondFunctions::duration(bond, y, Duration::Modified);
+        if (std::fabs(bondDuration - duration) > tolerance) {
+            BOOST_ERROR("bond duration differs from cash-flow functions:"
+                        << "\n    calculated:        " << bondDuration
+                        << "\n    expected:          " << duration);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -21,6 +21,7 @@
 #include "toplevelfixture.hpp"
 #include "utilities.hpp"
 #include <ql/currencies/europe.hpp>
+#include <ql/experimental/credit/binomiallossmodel.hpp>
 #include <ql/experimental/credit/cdo.hpp>
 #include <ql/experimental/credit/gaussianlhplossmodel.hpp>
 #include <ql/experimental/credit/homogeneouspooldef.hpp>
@@ -29,6 +30,8 @@
 #include <ql/experimental/credit/midpointcdoengine.hpp>
 #include <ql/experimental/credit/pool.hpp>
 #include <ql/experimental/credit/randomdefaultlatentmodel.hpp>
+#include <ql/experimental/credit/recursivelossmodel.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/termstructures/credit/flathazardrate.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
@@ -38,6 +41,7 @@
 #include <boost/mpl/vector.hpp>
 #include <iomanip>
 #include <iostream>
+#include <numeric>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -345,6 +349,209 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(testHW, T, dataSets) {
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE(testBatchedTrancheLosses) {
+
+    BOOST_TEST_MESSAGE("Testing tranche losses computed in a single pass...");
+
+    Date asofDate(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    Size poolSize = 20;
+    Real recovery = 0.4;
+    std::vector<Real> nominals;
+    for (Size i = 0; i < poolSize; ++i)
+        nominals.push_back(100.0 * (1 + i % 3));
+
+    Handle<DefaultProbabilityTermStructure> defaultCurve(ext::make_shared<FlatHazardRate>(
+        asofDate, 0.02, ActualActual(ActualActual::ISDA)));
+    std::vector<std::pair<DefaultProbKey, Handle<DefaultProbabilityTermStructure>>>
+        probabilities;
+    probabilities.emplace_back(
+        NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec, Period(0, Weeks), 10.),
+        defaultCurve);
+    ext::shared_ptr<Pool> pool(new Pool());
+    std::vector<std::string> names;
+    for (Size i = 0; i < poolSize; ++i) {
+        std::ostringstream o;
+        o << "issuer-" << i;
+        names.push_back(o.str());
+        pool->add(names.back(), Issuer(probabilities),
+                  NorthAmericaCorpDefaultKey(EURCurrency(), QuantLib::SeniorSec, Period(), 1.));
+    }
+
+    Handle<Quote> correlation(ext::make_shared<SimpleQuote>(0.3));
+    ext::shared_ptr<GaussianConstantLossLM> lossLM(
+        new GaussianConstantLossLM(correlation, std::vector<Real>(poolSize, recovery),
+                                   LatentModelIntegrationType::GaussianQuadrature, poolSize,
+                                   GaussianCopulaPolicy::initTraits()));
+
+    std::vector<std::string> modelNames = {"recursive", "binomial"};
+    std::vector<ext::shared_ptr<DefaultLossModel>> models = {
+        ext::make_shared<RecursiveGaussLossModel>(lossLM),
+        ext::make_shared<GaussianBinomialLossModel>(lossLM)};
+
+    std::vector<Real> attachments(hwAttachment, hwAttachment + LENGTH(hwAttachment));
+    std::vector<Real> detachments(hwDetachment, hwDetachment + LENGTH(hwDetachment));
+    Date d = asofDate + 5 * Years;
+
+    for (Size im = 0; im < models.size(); ++im) {
+        ext::shared_ptr<Basket> basket(
+            new Basket(asofDate, names, nominals, pool, attachments[1], detachments[1]));
+        basket->setLossModel(models[im]);
+        std::vector<Real> losses = basket->expectedTrancheLosses(d, attachments, detachments);
+
+        for (Size j = 0; j < attachments.size(); ++j) {
+            ext::shared_ptr<Basket> tranche(
+                new Basket(asofDate, names, nominals, pool, attachments[j], detachments[j]));
+            tranche->setLossModel(models[im]);
+            Real expected = tranche->expectedTrancheLoss(d);
+            if (std::fabs(losses[j] - expected) > 1.0e-10 * std::max(1.0, expected))
+                BOOST_ERROR("failed to reproduce expected tranche loss with "
+                            << modelNames[im] << " model on tranche ["
+                            << attachments[j] << ", " << detachments[j] << "]:"
+                            << std::setprecision(12)
+                            << "\n    batched:    " << losses[j]
+                            << "\n    single:     " << expected);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testConditionalLossIntegration) {
+
+    BOOST_TEST_MESSAGE("Testing integration of conditional loss distributions...");
+
+    Date asofDate(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    Size poolSize = 10;
+    Real recovery = 0.4;
+    Real nominal = 100.0;
+    std::vector<Real> nominals(poolSize, nominal);
+
+    ext::shared_ptr<DefaultProbabilityTermStructure> defaultCurve(
+        new FlatHazardRate(asofDate, 0.02, ActualActual(ActualActual::ISDA)));
+    std::vector<std::pair<DefaultProbKey, Handle<DefaultProbabilityTermStructure>>>
+        probabilities;
+    probabilities.emplace_back(
+        NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec, Period(0, Weeks), 10.),
+        Handle<DefaultProbabilityTermStructure>(defaultCurve));
+    ext::shared_ptr<Pool> pool(new Pool());
+    std::vector<std::string> names;
+    for (Size i = 0; i < poolSize; ++i) {
+        std::ostringstream o;
+        o << "issuer-" << i;
+        names.push_back(o.str());
+        pool->add(names.back(), Issuer(probabilities),
+                  NorthAmericaCorpDefaultKey(EURCurrency(), QuantLib::SeniorSec, Period(), 1.));
+    }
+
+    Handle<Quote> correlation(ext::make_shared<SimpleQuote>(0.3));
+    ext::shared_ptr<GaussianConstantLossLM> lossLM(
+        new GaussianConstantLossLM(correlation, std::vector<Real>(poolSize, recovery),
+                                   LatentModelIntegrationType::GaussianQuadrature, poolSize,
+                                   GaussianCopulaPolicy::initTraits()));
+
+    std::vector<std::string> modelNames = {"recursive", "binomial"};
+    std::vector<ext::shared_ptr<DefaultLossModel>> models = {
+        ext::make_shared<RecursiveGaussLossModel>(lossLM),
+        ext::make_shared<GaussianBinomialLossModel>(lossLM)};
+
+    // the expected loss of the whole pool doesn't depend on the
+    // correlation; all the quadrature nodes, including the first one,
+    // must be weighted to reproduce it
+    Date d = asofDate + 5 * Years;
+    Real poolLoss = poolSize * nominal * (1.0 - recovery) * defaultCurve->defaultProbability(d);
+    // value of the equity tranche obtained once the first node was weighted
+    Real equityLoss = 14.3976863982;
+
+    for (Size im = 0; im < models.size(); ++im) {
+        ext::shared_ptr<Basket> pooled(
+            new Basket(asofDate, names, nominals, pool, 0.0, 1.0));
+        pooled->setLossModel(models[im]);
+        Real calculated = pooled->expectedTrancheLoss(d);
+        if (std::fabs(calculated - poolLoss) > 1.0e-6 * poolLoss)
+            BOOST_ERROR("failed to reproduce expected pool loss with "
+                        << modelNames[im] << " model:"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << poolLoss);
+
+        ext::shared_ptr<Basket> equity(
+            new Basket(asofDate, names, nominals, pool, 0.0, 0.03));
+        equity->setLossModel(models[im]);
+        calculated = equity->expectedTrancheLoss(d);
+        if (std::fabs(calculated - equityLoss) > 1.0e-8)
+            BOOST_ERROR("failed to reproduce expected equity tranche loss with "
+                        << modelNames[im] << " model:"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << equityLoss);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testParallelNodeIntegration) {
+
+    BOOST_TEST_MESSAGE("Testing parallel integration over latent factor nodes...");
+
+    // conditional default probabilities and expected losses of a
+    // small inhomogeneous pool
+    Size poolSize = 8;
+    std::vector<Real> invProbs, lgds;
+    for (Size i = 0; i < poolSize; ++i) {
+        invProbs.push_back(InverseCumulativeNormal()(0.01 + 0.02 * i));
+        lgds.push_back(50.0 + 10.0 * i);
+    }
+
+    for (Size nFactors = 1; nFactors <= 2; ++nFactors) {
+        std::vector<std::vector<Real> > factorWeights(
+            poolSize, std::vector<Real>(nFactors, std::sqrt(0.3 / nFactors)));
+        GaussianConstantLossLM model(factorWeights, std::vector<Real>(poolSize, 0.4),
+                                     LatentModelIntegrationType::GaussianQuadrature,
+                                     GaussianCopulaPolicy::initTraits());
+
+        auto probabilities = [&](const std::vector<Real>& m) {
+            std::vector<Real> p(poolSize);
+            for (Size i = 0; i < poolSize; ++i)
+                p[i] = model.conditionalDefaultProbabilityInvP(invProbs[i], i, m);
+            return p;
+        };
+        auto expectedLoss = [&](const std::vector<Real>& m) {
+            std::vector<Real> p = probabilities(m);
+            return std::inner_product(p.begin(), p.end(), lgds.begin(), Real(0.0));
+        };
+
+        // the parallel integration must give exactly the serial results
+        Real serial = model.integratedExpectedValue(expectedLoss);
+        Real parallel = model.integratedExpectedValue(expectedLoss, true);
+        if (serial != parallel)
+            BOOST_ERROR("parallel integration of conditional loss with "
+                        << nFactors << " factor(s) differs from serial one:"
+                        << std::setprecision(16)
+                        << "\n    serial:   " << serial
+                        << "\n    parallel: " << parallel);
+
+        std::vector<Real> serialV = model.integratedExpectedValueV(probabilities);
+        std::vector<Real> parallelV = model.integratedExpectedValueV(probabilities, true);
+        BOOST_REQUIRE(serialV.size() == poolSize && parallelV.size() == poolSize);
+        for (Size i = 0; i < poolSize; ++i) {
+            if (serialV[i] != parallelV[i])
+                BOOST_ERROR("parallel integration of default probability #"
+                            << i << " with " << nFactors
+                            << " factor(s) differs from serial one:"
+                            << std::setprecision(16)
+                            << "\n    serial:   " << serialV[i]
+                            << "\n    parallel: " << parallelV[i]);
+        }
+
+        // errors in the integrand are reported after the loop
+        auto failing = [&](const std::vector<Real>& m) -> Real {
+            QL_REQUIRE(m[0] < 1.0, "integrand failure");
+            return expectedLoss(m);
+        };
+        BOOST_CHECK_THROW(model.integratedExpectedValue(failing, true), Error);
+    }
+}
 #endif
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -25,8 +25,10 @@
 #include <ql/pricingengines/credit/midpointcdsengine.hpp>
 #include <ql/pricingengines/credit/integralcdsengine.hpp>
 #include <ql/pricingengines/credit/isdacdsengine.hpp>
+#include <ql/termstructures/credit/defaultprobabilityhelpers.hpp>
 #include <ql/termstructures/credit/flathazardrate.hpp>
 #include <ql/termstructures/credit/interpolatedhazardratecurve.hpp>
+#include <ql/termstructures/credit/piecewisedefaultcurve.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/yield/discountcurve.hpp>
 #include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
@@ -955,6 +957,216 @@ BOOST_AUTO_TEST_CASE(testIsdaCalculatorReconcileSingleWithIssueDateInThePast) {
     QL_CHECK_CLOSE(calculated_accrual, expected_accrual, tolerance);
 }
 
+BOOST_AUTO_TEST_CASE(testIsdaEngineBatchPricing) {
+
+    BOOST_TEST_MESSAGE(
+        "Testing batch pricing of credit-default swaps with the ISDA engine...");
+
+    Date today(21, May, 2009);
+    Settings::instance().evaluationDate() = today;
+
+    Handle<YieldTermStructure> discountCurve(
+        ext::make_shared<FlatForward>(today, 0.02, Actual365Fixed()));
+
+    std::vector<Date> dates = {today,
+                               today + 1 * Years,
+                               today + 3 * Years,
+                               today + 5 * Years,
+                               today + 10 * Years,
+                               today + 15 * Years};
+    std::vector<Rate> hazardRates = {0.010, 0.010, 0.012, 0.015, 0.018, 0.020};
+    Handle<DefaultProbabilityTermStructure> probabilityCurve(
+        ext::make_shared<InterpolatedHazardRateCurve<BackwardFlat> >(
+            dates, hazardRates, Actual365Fixed()));
+
+    Real recovery = 0.4;
+    ext::shared_ptr<IsdaCdsEngine> engine = ext::make_shared<IsdaCdsEngine>(
+        probabilityCurve, recovery, discountCurve, ext::nullopt, IsdaCdsEngine::Taylor,
+        IsdaCdsEngine::HalfDayBias, IsdaCdsEngine::Piecewise);
+
+    Integer tenors[] = {1, 2, 3, 5, 7, 10};
+    std::vector<ext::shared_ptr<CreditDefaultSwap> > swaps;
+    for (Integer tenor : tenors) {
+        swaps.push_back(MakeCreditDefaultSwap(tenor * Years, 0.01)
+                            .withNominal(10000000.)
+                            .withUpfrontRate(0.02)
+                            .withSide(tenor % 2 == 0 ? Protection::Buyer
+                                                     : Protection::Seller)
+                            .withPricingEngine(engine));
+    }
+
+    std::vector<CreditDefaultSwap::results> results = engine->calculate(swaps);
+    BOOST_REQUIRE(results.size() == swaps.size());
+
+    Real tolerance = 1.0e-10;
+    for (Size i=0; i<swaps.size(); ++i) {
+        Real npv = swaps[i]->NPV();
+        if (std::fabs(results[i].value - npv) > tolerance * std::fabs(npv))
+            BOOST_ERROR("batch NPV differs from single-swap NPV for "
+                        << tenors[i] << "Y swap:"
+                        << std::setprecision(12)
+                        << "\n    batch:  " << results[i].value
+                        << "\n    single: " << npv);
+        if (std::fabs(results[i].fairSpread - swaps[i]->fairSpread()) >
+            tolerance * swaps[i]->fairSpread())
+            BOOST_ERROR("batch fair spread differs from single-swap fair spread for "
+                        << tenors[i] << "Y swap:"
+                        << std::setprecision(12)
+                        << "\n    batch:  " << results[i].fairSpread
+                        << "\n    single: " << swaps[i]->fairSpread());
+        if (std::fabs(results[i].fairUpfront - swaps[i]->fairUpfront()) > tolerance)
+            BOOST_ERROR("batch fair upfront differs from single-swap fair upfront for "
+                        << tenors[i] << "Y swap:"
+                        << std::setprecision(12)
+                        << "\n    batch:  " << results[i].fairUpfront
+                        << "\n    single: " << swaps[i]->fairUpfront());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testMidPointEngineBatchPricing) {
+
+    BOOST_TEST_MESSAGE(
+        "Testing batch pricing of credit-default swaps with the mid-point engine...");
+
+    Date today(21, May, 2009);
+    Settings::instance().evaluationDate() = today;
+
+    Handle<YieldTermStructure> discountCurve(
+        ext::make_shared<FlatForward>(today, 0.02, Actual365Fixed()));
+
+    std::vector<Date> dates = {today,
+                               today + 1 * Years,
+                               today + 3 * Years,
+                               today + 5 * Years,
+                               today + 10 * Years,
+                               today + 15 * Years};
+    Handle<DefaultProbabilityTermStructure> probabilityCurve(
+        ext::make_shared<InterpolatedHazardRateCurve<BackwardFlat> >(
+            dates, std::vector<Rate>{0.010, 0.010, 0.012, 0.015, 0.018, 0.020},
+            Actual365Fixed()));
+
+    ext::shared_ptr<MidPointCdsEngine> engine =
+        ext::make_shared<MidPointCdsEngine>(probabilityCurve, 0.4, discountCurve);
+
+    Integer tenors[] = {1, 2, 3, 5, 7, 10};
+    std::vector<ext::shared_ptr<CreditDefaultSwap> > swaps;
+    for (Integer tenor : tenors) {
+        swaps.push_back(MakeCreditDefaultSwap(tenor * Years, 0.01)
+                            .withNominal(10000000.)
+                            .withUpfrontRate(0.02)
+                            .withSide(tenor % 2 == 0 ? Protection::Buyer
+                                                     : Protection::Seller)
+                            .withPricingEngine(engine));
+    }
+
+    std::vector<CreditDefaultSwap::results> results = engine->calculate(swaps);
+    BOOST_REQUIRE(results.size() == swaps.size());
+
+    for (Size i=0; i<swaps.size(); ++i) {
+        if (results[i].value != swaps[i]->NPV() ||
+            results[i].fairSpread != swaps[i]->fairSpread() ||
+            results[i].fairUpfront != swaps[i]->fairUpfront())
+            BOOST_ERROR("batch results differ from single-swap ones for "
+                        << tenors[i] << "Y swap:"
+                        << std::setprecision(12)
+                        << "\n    batch NPV:          " << results[i].value
+                        << "\n    single NPV:         " << swaps[i]->NPV()
+                        << "\n    batch fair spread:  " << results[i].fairSpread
+                        << "\n    single fair spread: " << swaps[i]->fairSpread());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testIsdaEngineCurveChanges) {
+
+    BOOST_TEST_MESSAGE(
+        "Testing the ISDA engine after changes in its curves...");
+
+    Date today(21, May, 2009);
+    Settings::instance().evaluationDate() = today;
+
+    Handle<YieldTermStructure> discountCurve(
+        ext::make_shared<FlatForward>(today, 0.02, Actual365Fixed()));
+
+    std::vector<Date> dates = {today,
+                               today + 1 * Years,
+                               today + 3 * Years,
+                               today + 5 * Years,
+                               today + 10 * Years,
+                               today + 15 * Years};
+    RelinkableHandle<DefaultProbabilityTermStructure> probabilityCurve(
+        ext::make_shared<InterpolatedHazardRateCurve<BackwardFlat> >(
+            dates, std::vector<Rate>{0.010, 0.010, 0.012, 0.015, 0.018, 0.020},
+            Actual365Fixed()));
+
+    Real recovery = 0.4;
+    ext::shared_ptr<PricingEngine> engine =
+        ext::make_shared<IsdaCdsEngine>(probabilityCurve, recovery, discountCurve);
+
+    Integer tenors[] = {1, 2, 3, 5, 7, 10};
+    std::vector<ext::shared_ptr<CreditDefaultSwap> > swaps;
+    for (Integer tenor : tenors) {
+        swaps.push_back(MakeCreditDefaultSwap(tenor * Years, 0.01)
+                            .withNominal(10000000.)
+                            .withPricingEngine(engine));
+        swaps.back()->NPV();
+    }
+
+    // the engine is notified of the change and must not use the
+    // curve values cached during the previous calculations
+    probabilityCurve.linkTo(
+        ext::make_shared<InterpolatedHazardRateCurve<BackwardFlat> >(
+            dates, std::vector<Rate>{0.020, 0.020, 0.018, 0.016, 0.015, 0.015},
+            Actual365Fixed()));
+    std::vector<CreditDefaultSwap::results> results =
+        IsdaCdsEngine(probabilityCurve, recovery, discountCurve).calculate(swaps);
+
+    for (Size i=0; i<swaps.size(); ++i) {
+        if (swaps[i]->NPV() != results[i].value)
+            BOOST_ERROR("NPV after curve change differs from the one given "
+                        "by a new engine for " << tenors[i] << "Y swap:"
+                        << std::setprecision(12)
+                        << "\n    reused engine: " << swaps[i]->NPV()
+                        << "\n    new engine:    " << results[i].value);
+    }
+
+    // curves being bootstrapped change without notifying the engines
+    // of their helpers; the bootstrapped curve must still reprice the
+    // quotes with a new engine
+    std::vector<ext::shared_ptr<SimpleQuote> > quotes;
+    std::vector<ext::shared_ptr<DefaultProbabilityHelper> > helpers;
+    for (Integer tenor : tenors) {
+        quotes.push_back(ext::make_shared<SimpleQuote>(0.008 + 0.001 * tenor));
+        helpers.push_back(ext::make_shared<SpreadCdsHelper>(
+            Handle<Quote>(quotes.back()), tenor * Years, 1, WeekendsOnly(), Quarterly,
+            Following, DateGeneration::CDS2015, Actual360(), recovery, discountCurve,
+            true, true, Date(), Actual360(true), true, CreditDefaultSwap::ISDA));
+    }
+    auto curve = ext::make_shared<PiecewiseDefaultCurve<SurvivalProbability, LogLinear> >(
+        today, helpers, Actual365Fixed());
+    probabilityCurve.linkTo(curve);
+
+    Real tolerance = 1.0e-10;
+    for (Size k=0; k<2; ++k) {
+        // bootstrap first, so that the helpers have set up their swaps
+        curve->recalculate();
+        std::vector<ext::shared_ptr<CreditDefaultSwap> > helperSwaps;
+        for (const auto& helper : helpers)
+            helperSwaps.push_back(ext::dynamic_pointer_cast<CdsHelper>(helper)->swap());
+        results = IsdaCdsEngine(probabilityCurve, recovery, discountCurve, false)
+                      .calculate(helperSwaps);
+        for (Size i=0; i<helpers.size(); ++i) {
+            if (std::fabs(results[i].fairSpread - quotes[i]->value()) > tolerance)
+                BOOST_ERROR("bootstrapped curve doesn't reprice " << tenors[i]
+                            << "Y quote:"
+                            << std::setprecision(12)
+                            << "\n    fair spread: " << results[i].fairSpread
+                            << "\n    quote:       " << quotes[i]->value());
+        }
+        // bootstrap again with the engines already used
+        quotes[2]->setValue(quotes[2]->value() + 0.002);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -83,6 +83,7 @@
 #include <ql/termstructures/volatility/equityfx/localconstantvol.hpp>
 #include <ql/termstructures/volatility/equityfx/localvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/noexceptlocalvolsurface.hpp>
+#include <ql/termstructures/volatility/equityfx/sampledlocalvolsurface.hpp>
 #include <ql/termstructures/yield/zerocurve.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/actualactual.hpp>
@@ -2681,6 +2682,85 @@ BOOST_AUTO_TEST_CASE(testDiffusionAndDriftSlvProcess) {
 //    }
 //}
 
+BOOST_AUTO_TEST_CASE(testSampledLocalVolSurface) {
+    BOOST_TEST_MESSAGE("Testing local volatility surface sampled on a grid...");
+
+    const DayCounter dc = Actual365Fixed();
+    const Date todaysDate(5, Nov, 2015);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const ext::shared_ptr<SimpleQuote> s0 = ext::make_shared<SimpleQuote>(100.0);
+    const Handle<Quote> spot(s0);
+    const Handle<YieldTermStructure> rTS(flatRate(0.05, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(0.02, dc));
+
+    const Handle<HestonModel> hestonModel(
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                rTS, qTS, spot, 0.09, 1.0, 0.06, 0.4, -0.75)));
+
+    const Handle<LocalVolTermStructure> localVol(
+        ext::make_shared<NoExceptLocalVolSurface>(
+            Handle<BlackVolTermStructure>(
+                ext::make_shared<HestonBlackVolSurface>(hestonModel)),
+            rTS, qTS, spot, 0.3));
+
+    std::vector<Time> times(20);
+    for (Size i=0; i < times.size(); ++i)
+        times[i] = 0.1*(i+1);
+
+    const ext::shared_ptr<SampledLocalVolSurface> sampled =
+        ext::make_shared<SampledLocalVolSurface>(localVol, spot, times, 41);
+
+    Flag flag;
+    flag.registerWith(sampled);
+
+    for (Size k=0; k < 2; ++k) {
+        // grid nodes are reproduced exactly...
+        for (Size i=0; i < times.size(); i+=3) {
+            const std::vector<Real> strikes = sampled->strikes(i);
+            for (Size j=0; j < strikes.size(); j+=5) {
+                const Volatility expected =
+                    localVol->localVol(times[i], strikes[j], true);
+                const Volatility calculated =
+                    sampled->localVol(times[i], strikes[j], true);
+                if (std::fabs(expected - calculated) > 1e-8)
+                    BOOST_ERROR("failed to reproduce sampled local volatility"
+                                << "\n    spot:       " << s0->value()
+                                << "\n    time:       " << times[i]
+                                << "\n    strike:     " << strikes[j]
+                                << "\n    expected:   " << expected
+                                << "\n    calculated: " << calculated);
+            }
+        }
+
+        // ...and off-grid values are close to the original surface
+        const Real tol = 5e-3;
+        for (Real t=0.15; t < 1.9; t+=0.2) {
+            for (Real m=0.8; m < 1.25; m+=0.05) {
+                const Real strike = m*s0->value();
+                const Volatility expected = localVol->localVol(t, strike, true);
+                const Volatility calculated = sampled->localVol(t, strike, true);
+                if (std::fabs(expected - calculated) > tol)
+                    BOOST_ERROR("failed to interpolate sampled local volatility"
+                                << "\n    spot:       " << s0->value()
+                                << "\n    time:       " << t
+                                << "\n    strike:     " << strike
+                                << "\n    expected:   " << expected
+                                << "\n    calculated: " << calculated
+                                << "\n    tolerance:  " << tol);
+            }
+        }
+
+        // a change in the spot invalidates the grid
+        flag.lower();
+        s0->setValue(s0->value() + 10.0);
+        if (!flag.isUp())
+            BOOST_FAIL("sampled local volatility surface "
+                       "did not notify observers on spot change");
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -25,6 +25,7 @@
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <boost/algorithm/string/case_conv.hpp>
+#include <sstream>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -159,6 +160,79 @@ BOOST_AUTO_TEST_CASE(testTenorNormalization) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testBulkFixingsAndPersistence) {
+    BOOST_TEST_MESSAGE("Testing bulk loading and persistence of index fixings...");
+
+    Settings::instance().evaluationDate() = Date(1, June, 2022);
+
+    auto euribor = ext::make_shared<Euribor6M>();
+    auto bma = ext::make_shared<BMAIndex>();
+
+    Date first(1, March, 2021);
+    std::vector<Real> values;
+    std::vector<Date> fixingDates;
+    for (Date d = first; d < Date(1, March, 2022); ++d) {
+        if (euribor->isValidFixingDate(d)) {
+            values.push_back(0.0001 * (d - first));
+            fixingDates.push_back(d);
+        } else {
+            values.push_back(Null<Real>());
+        }
+    }
+
+    IndexManager::instance().setHistory(euribor->name(), first, values);
+
+    Flag flag;
+    flag.registerWith(euribor);
+    flag.lower();
+
+    const TimeSeries<Real>& history = euribor->timeSeries();
+    BOOST_TEST(history.size() == fixingDates.size());
+    BOOST_TEST(history.dates() == fixingDates);
+    for (const auto& d : fixingDates) {
+        BOOST_TEST(euribor->fixing(d) == 0.0001 * (d - first));
+        BOOST_TEST(IndexManager::instance().historicalFixing(euribor->name(), d) ==
+                   history[d]);
+    }
+
+    euribor->addFixing(fixingDates.back(), 0.05, true);
+    if (!flag.isUp())
+        BOOST_FAIL("Observer was not notified of added fixing");
+    BOOST_TEST(euribor->fixing(fixingDates.back()) == 0.05);
+
+    bma->addFixing(Date(3, March, 2021), 0.01);
+
+    std::stringstream buffer;
+    IndexManager::instance().save(buffer);
+    const std::string saved = buffer.str();
+
+    euribor->addFixing(fixingDates.front(), 0.07, true);
+    flag.lower();
+    IndexManager::instance().load(buffer);
+    if (!flag.isUp())
+        BOOST_FAIL("Observer was not notified of loaded fixings");
+    BOOST_TEST(euribor->fixing(fixingDates.front()) == 0.0);
+
+    // clearing the histories also drops the registered notifiers,
+    // so only the restored values are checked here
+    IndexManager::instance().clearHistories();
+    BOOST_TEST(!euribor->hasHistoricalFixing(fixingDates.front()));
+
+    std::stringstream restored(saved);
+    IndexManager::instance().load(restored);
+
+    BOOST_TEST(euribor->timeSeries().dates() == fixingDates);
+    BOOST_TEST(euribor->fixing(fixingDates.front()) == 0.0);
+    BOOST_TEST(euribor->fixing(fixingDates.back()) == 0.05);
+    BOOST_TEST(bma->fixing(Date(3, March, 2021)) == 0.01);
+    BOOST_TEST(bma->timeSeries().size() == 1);
+
+    std::stringstream invalid("not fixing data");
+    BOOST_CHECK_THROW(IndexManager::instance().load(invalid), Error);
+
+    IndexManager::instance().clearHistories();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
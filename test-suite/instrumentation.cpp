@@ -0,0 +1,224 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "toplevelfixture.hpp"
+#include "utilities.hpp"
+#include <ql/utilities/instrumentation.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <sstream>
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+
+BOOST_FIXTURE_TEST_SUITE(QuantLibTests, TopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(InstrumentationTests)
+
+#if defined(QL_ENABLE_INSTRUMENTATION)
+
+class InstrumentationCleaner { // NOLINT(cppcoreguidelines-special-member-functions)
+  public:
+    InstrumentationCleaner() {
+        Instrumentation::instance().disable();
+        Instrumentation::instance().reset();
+    }
+    ~InstrumentationCleaner() {
+        Instrumentation::instance().disable();
+        Instrumentation::instance().reset();
+    }
+};
+
+void inner() {
+    QL_INSTRUMENT_SCOPE("inner");
+    QL_INSTRUMENT_COUNTER("items", 2.0);
+}
+
+void outer(Size n) {
+    QL_INSTRUMENT_SCOPE("outer");
+    for (Size i=0; i<n; ++i)
+        inner();
+}
+
+void recursive(Size depth) {
+    QL_INSTRUMENT_SCOPE("recursive");
+    if (depth > 0)
+        recursive(depth-1);
+}
+
+const Instrumentation::Timer* findTimer(const std::vector<Instrumentation::Timer>& timers,
+                                        const std::string& name) {
+    for (const auto& t : timers) {
+        if (t.name == name)
+            return &t;
+    }
+    return nullptr;
+}
+
+#endif
+
+BOOST_AUTO_TEST_CASE(testScopesAndCounters) {
+
+    BOOST_TEST_MESSAGE("Testing instrumentation scopes and counters...");
+
+    #if defined(QL_ENABLE_INSTRUMENTATION)
+
+    InstrumentationCleaner cleaner;
+
+    // nothing is collected until enabled
+    outer(3);
+    BOOST_CHECK(Instrumentation::instance().timers().empty());
+    BOOST_CHECK(Instrumentation::instance().counters().empty());
+
+    Instrumentation::instance().enable(100);
+    outer(3);
+    outer(2);
+    Instrumentation::instance().disable();
+    outer(4);
+
+    std::vector<Instrumentation::Timer> timers = Instrumentation::instance().timers();
+    BOOST_REQUIRE_EQUAL(timers.size(), 2U);
+    BOOST_CHECK_EQUAL(timers[0].name, "outer");
+
+    const Instrumentation::Timer* o = findTimer(timers, "outer");
+    const Instrumentation::Timer* i = findTimer(timers, "inner");
+    BOOST_REQUIRE(o != nullptr);
+    BOOST_REQUIRE(i != nullptr);
+    BOOST_CHECK_EQUAL(o->calls, 2U);
+    BOOST_CHECK_EQUAL(i->calls, 5U);
+    BOOST_CHECK(o->totalTime >= i->totalTime);
+    BOOST_CHECK(o->selfTime >= 0.0);
+    BOOST_CHECK(o->minTime <= o->maxTime);
+    BOOST_CHECK_CLOSE(i->selfTime, i->totalTime, 1.0e-8);
+
+    std::vector<Instrumentation::Counter> counters =
+        Instrumentation::instance().counters();
+    BOOST_REQUIRE_EQUAL(counters.size(), 1U);
+    BOOST_CHECK_EQUAL(counters[0].name, "items");
+    BOOST_CHECK_EQUAL(counters[0].updates, 5U);
+    BOOST_CHECK_EQUAL(counters[0].total, 10.0);
+
+    std::ostringstream stacks;
+    Instrumentation::instance().writeCollapsedStacks(stacks);
+    std::string s = stacks.str();
+    BOOST_CHECK(s.find("outer ") == 0);
+    BOOST_CHECK(s.find("\nouter;inner ") != std::string::npos);
+
+    std::ostringstream trace;
+    Instrumentation::instance().writeChromeTrace(trace);
+    std::string t = trace.str();
+    BOOST_CHECK(t.find("{\"traceEvents\":[") == 0);
+    BOOST_CHECK(t.find("\"name\":\"inner\",\"cat\":\"QuantLib\",\"ph\":\"X\"")
+                != std::string::npos);
+    BOOST_CHECK(t.find("\"name\":\"items\",\"ph\":\"C\"") != std::string::npos);
+
+    Instrumentation::instance().reset();
+    BOOST_CHECK(Instrumentation::instance().timers().empty());
+    BOOST_CHECK(Instrumentation::instance().counters().empty());
+
+    #else
+
+    BOOST_CHECK_THROW(Instrumentation::instance().enable(), Error);
+    BOOST_CHECK(!Instrumentation::instance().enabled());
+
+    #endif
+}
+
+BOOST_AUTO_TEST_CASE(testNestedScopes) {
+
+    BOOST_TEST_MESSAGE("Testing instrumentation of nested scopes with the same name...");
+
+    #if defined(QL_ENABLE_INSTRUMENTATION)
+
+    InstrumentationCleaner cleaner;
+
+    Instrumentation::instance().enable();
+    recursive(3);
+    Instrumentation::instance().disable();
+
+    std::vector<Instrumentation::Timer> timers = Instrumentation::instance().timers();
+    BOOST_REQUIRE_EQUAL(timers.size(), 1U);
+    const Instrumentation::Timer& r = timers[0];
+    BOOST_CHECK_EQUAL(r.calls, 4U);
+    // only the outermost execution, which is also the longest, is
+    // counted in the total time
+    BOOST_CHECK_CLOSE(r.totalTime, r.maxTime, 1.0e-8);
+    BOOST_CHECK(r.selfTime <= r.totalTime * (1.0 + 1.0e-8));
+
+    std::ostringstream stacks;
+    Instrumentation::instance().writeCollapsedStacks(stacks);
+    BOOST_CHECK(stacks.str().find("recursive;recursive;recursive;recursive ")
+                != std::string::npos);
+
+    #endif
+}
+
+BOOST_AUTO_TEST_CASE(testInstrumentedPricing) {
+
+    BOOST_TEST_MESSAGE("Testing instrumentation of instrument pricing...");
+
+    #if defined(QL_ENABLE_INSTRUMENTATION)
+
+    InstrumentationCleaner cleaner;
+
+    Date today = Settings::instance().evaluationDate();
+    DayCounter dc = Actual365Fixed();
+    auto process = ext::make_shared<BlackScholesMertonProcess>(
+        Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+        Handle<YieldTermStructure>(ext::make_shared<FlatForward>(today, 0.01, dc)),
+        Handle<YieldTermStructure>(ext::make_shared<FlatForward>(today, 0.03, dc)),
+        Handle<BlackVolTermStructure>(
+            ext::make_shared<BlackConstantVol>(today, TARGET(), 0.2, dc)));
+
+    VanillaOption option(ext::make_shared<PlainVanillaPayoff>(Option::Call, 100.0),
+                         ext::make_shared<EuropeanExercise>(today + Period(1, Years)));
+    option.setPricingEngine(ext::make_shared<AnalyticEuropeanEngine>(process));
+
+    Instrumentation::instance().enable();
+    option.NPV();
+    option.NPV();
+    Instrumentation::instance().disable();
+
+    std::vector<Instrumentation::Timer> timers = Instrumentation::instance().timers();
+    const Instrumentation::Timer* calculation =
+        findTimer(timers, "LazyObject::performCalculations");
+    const Instrumentation::Timer* engine = findTimer(timers, "PricingEngine::calculate");
+    BOOST_REQUIRE(calculation != nullptr);
+    BOOST_REQUIRE(engine != nullptr);
+    // the term structures are lazy objects too
+    BOOST_CHECK(calculation->calls >= 1U);
+    // the second call uses the cached results
+    BOOST_CHECK_EQUAL(engine->calls, 1U);
+
+    std::ostringstream stacks;
+    Instrumentation::instance().writeCollapsedStacks(stacks);
+    BOOST_CHECK(stacks.str().find(
+        "LazyObject::performCalculations;PricingEngine::calculate ")
+                != std::string::npos);
+
+    #endif
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -39,6 +39,7 @@
 #include <ql/math/interpolations/kernelinterpolation2d.hpp>
 #include <ql/math/interpolations/lagrangeinterpolation.hpp>
 #include <ql/math/interpolations/linearinterpolation.hpp>
+#include <ql/math/interpolations/loginterpolation.hpp>
 #include <ql/math/interpolations/multicubicspline.hpp>
 #include <ql/math/interpolations/sabrinterpolation.hpp>
 #include <ql/math/kernelfunctions.hpp>
@@ -2785,6 +2786,76 @@ BOOST_AUTO_TEST_CASE(testLaplaceInterpolation) {
 
 }
 
+BOOST_AUTO_TEST_CASE(testHintedAndBatchedInterpolation) {
+    BOOST_TEST_MESSAGE("Testing hinted and batched interpolation queries...");
+
+    const std::vector<Real> x = { 0.0, 0.25, 0.5, 1.0, 2.0, 3.0, 5.0, 7.0, 10.0 };
+    const std::vector<Real> y = { 1.0, 0.99, 0.98, 0.96, 0.92, 0.88, 0.8, 0.73, 0.62 };
+
+    const std::vector<std::pair<std::string, Interpolation> > interpolations = {
+        { "linear", LinearInterpolation(x.begin(), x.end(), y.begin()) },
+        { "log-linear", LogLinearInterpolation(x.begin(), x.end(), y.begin()) },
+        { "backward-flat", BackwardFlatInterpolation(x.begin(), x.end(), y.begin()) },
+        { "forward-flat", ForwardFlatInterpolation(x.begin(), x.end(), y.begin()) },
+        { "cubic", CubicNaturalSpline(x.begin(), x.end(), y.begin()) },
+        { "log-cubic", LogCubicNaturalSpline(x.begin(), x.end(), y.begin()) }
+    };
+
+    // sorted queries, including nodes and points outside the range
+    std::vector<Real> queries;
+    for (Real q = -0.5; q <= 11.0; q += 0.125)
+        queries.push_back(q);
+    const Size n = queries.size();
+
+    for (const auto& i : interpolations) {
+        const std::string& name = i.first;
+        const Interpolation& f = i.second;
+
+        std::vector<Real> batched(n);
+        f(queries.data(), batched.data(), n, true);
+
+        Size hint = 0;
+        for (Size j=0; j<n; ++j) {
+            const Real expected = f(queries[j], true);
+            const Real hinted = f(queries[j], hint, true);
+            if (hinted != expected || batched[j] != expected)
+                BOOST_ERROR("failed to reproduce " << name << " interpolation"
+                            << "\n    x:        " << queries[j]
+                            << "\n    expected: " << expected
+                            << "\n    hinted:   " << hinted
+                            << "\n    batched:  " << batched[j]);
+        }
+
+        // unsorted queries and stale hints must give the same results
+        hint = x.size();
+        for (Size j=0; j<n; ++j) {
+            const Real q = queries[(7*j) % n];
+            const Real expected = f(q, true);
+            const Real hinted = f(q, hint, true);
+            if (hinted != expected)
+                BOOST_ERROR("failed to reproduce " << name
+                            << " interpolation in random order"
+                            << "\n    x:        " << q
+                            << "\n    expected: " << expected
+                            << "\n    hinted:   " << hinted);
+        }
+
+        if (name.compare(0, 4, "log-") != 0) {
+            hint = 0;
+            for (Size j=0; j<n; ++j) {
+                const Real expected = f.primitive(queries[j], true);
+                const Real hinted = f.primitive(queries[j], hint, true);
+                if (hinted != expected)
+                    BOOST_ERROR("failed to reproduce " << name
+                                << " interpolation primitive"
+                                << "\n    x:        " << queries[j]
+                                << "\n    expected: " << expected
+                                << "\n    hinted:   " << hinted);
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
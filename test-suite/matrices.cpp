@@ -27,14 +27,17 @@
 #include <ql/math/matrixutilities/basisincompleteordered.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
 #include <ql/math/matrixutilities/choleskydecomposition.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 #include <ql/math/matrixutilities/gmres.hpp>
 #include <ql/math/matrixutilities/pseudosqrt.hpp>
 #include <ql/math/matrixutilities/qrdecomposition.hpp>
+#include <ql/math/matrixutilities/sparseilupreconditioner.hpp>
 #include <ql/math/matrixutilities/svd.hpp>
 #include <ql/math/matrixutilities/symmetricschurdecomposition.hpp>
 #include <ql/math/matrixutilities/sparsematrix.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <cmath>
+#include <iomanip>
 #include <iterator>
 #include <utility>
 #include <numeric>
@@ -775,6 +778,158 @@ BOOST_AUTO_TEST_CASE(testSparseMatrixMemory) {
 
 }
 
+BOOST_AUTO_TEST_CASE(testCsrMatrix) {
+
+    BOOST_TEST_MESSAGE("Testing compressed sparse row matrices...");
+
+    // the trailing rows are left empty on purpose
+    SparseMatrix m(6, 5);
+    m(0, 0) = 1.0;
+    m(0, 3) = -2.0;
+    m(2, 1) = 3.5;
+    m(2, 4) = 0.25;
+    m(3, 2) = -1.5;
+
+    const CsrMatrix c(m);
+    BOOST_CHECK_EQUAL(c.rows(), 6);
+    BOOST_CHECK_EQUAL(c.columns(), 5);
+    BOOST_CHECK_EQUAL(c.nonZeros(), 5);
+    BOOST_CHECK_EQUAL(c.rowOffsets().size(), 7);
+    BOOST_CHECK_EQUAL(c.rowOffsets().back(), 5);
+
+    for (Size i=0; i<m.size1(); ++i) {
+        for (Size j=0; j<m.size2(); ++j) {
+            if (c(i, j) != m(i, j))
+                BOOST_FAIL("wrong element (" << i << ", " << j << ")"
+                           << "\n    stored:   " << c(i, j)
+                           << "\n    expected: " << Real(m(i, j)));
+        }
+    }
+
+    const Array x = {1.0, 2.0, 3.0, 4.0, 5.0};
+    const Array y = prod(c, x);
+    BOOST_CHECK_EQUAL(y, Array({-7.0, 0.0, 8.25, -4.5, 0.0, 0.0}));
+
+    const SparseMatrix back = c.toSparseMatrix();
+    BOOST_CHECK_EQUAL(back.nnz(), 5);
+    BOOST_CHECK_EQUAL(back(2, 4), 0.25);
+
+    // the ILU preconditioner gives the same factors from both types
+    const Size n = 11, k = 7;
+    SparseMatrix a(n*k, n*k);
+    for (Size i=0; i<n*k; ++i) {
+        a(i, i) = 4.0;
+        if (i % k != 0)
+            a(i, i-1) = -1.0;
+        if (i % k != k-1)
+            a(i, i+1) = -1.0;
+        if (i >= k)
+            a(i, i-k) = -1.0;
+        if (i+k < n*k)
+            a(i, i+k) = -1.0;
+    }
+    const SparseILUPreconditioner ilu1(a, 2), ilu2(CsrMatrix(a), 2);
+    const Array b(a.size1(), 1.0);
+    BOOST_CHECK_EQUAL(ilu1.apply(b), ilu2.apply(b));
+
+    BOOST_CHECK_THROW(prod(c, Array(4, 1.0)), Error);
+    BOOST_CHECK_THROW(c(6, 0), Error);
+    BOOST_CHECK_THROW(CsrMatrix(2, 2, {0, 1}, {0}, {1.0}), Error);
+    BOOST_CHECK_THROW(CsrMatrix(2, 2, {0, 2, 2}, {1, 0}, {1.0, 2.0}), Error);
+    BOOST_CHECK_THROW(CsrMatrix(2, 2, {0, 1, 2}, {0, 2}, {1.0, 2.0}), Error);
+}
+
+BOOST_AUTO_TEST_CASE(testSparseILUFactors) {
+
+    BOOST_TEST_MESSAGE("Testing sparse ILU factors against dense references...");
+
+    // non-symmetric five-point stencil on a 11x7 grid
+    const Size n = 11, k = 7, size = n*k;
+    SparseMatrix a(size, size);
+    Matrix dense(size, size, 0.0);
+    for (Size i=0; i<size; ++i) {
+        dense[i][i] = a(i, i) = 4.0;
+        if (i % k != 0)
+            dense[i][i-1] = a(i, i-1) = -1.2;
+        if (i % k != k-1)
+            dense[i][i+1] = a(i, i+1) = -0.8;
+        if (i >= k)
+            dense[i][i-k] = a(i, i-k) = -1.1;
+        if (i+k < size)
+            dense[i][i+k] = a(i, i+k) = -0.9;
+    }
+
+    const auto toDense = [size](const SparseMatrix& m) {
+        Matrix result(size, size, 0.0);
+        for (auto i1 = m.begin1(); i1 != m.end1(); ++i1)
+            for (auto i2 = i1.begin(); i2 != i1.end(); ++i2)
+                result[i2.index1()][i2.index2()] = *i2;
+        return result;
+    };
+    const Real tolerance = 1.0e-12;
+
+    // incomplete factors: L*U reproduces A on the pattern of the factors,
+    // which includes the pattern of A
+    for (Integer lfil : {0, 1, 2}) {
+        const SparseILUPreconditioner ilu(a, lfil);
+        const Matrix l = toDense(ilu.L()), u = toDense(ilu.U());
+        const Matrix lu = l * u;
+        for (Size i=0; i<size; ++i) {
+            for (Size j=0; j<size; ++j) {
+                const bool inPattern =
+                    dense[i][j] != 0.0 || (j < i ? l[i][j] != 0.0 : u[i][j] != 0.0);
+                if (inPattern && std::fabs(lu[i][j] - dense[i][j]) > tolerance)
+                    BOOST_FAIL("L*U differs from A at (" << i << ", " << j << ")"
+                               << " with fill level " << lfil << ":"
+                               << std::setprecision(12)
+                               << "\n    L*U: " << lu[i][j]
+                               << "\n    A:   " << dense[i][j]);
+            }
+        }
+    }
+
+    // without dropping any fill-in, the factors are those of a dense
+    // LU decomposition without pivoting
+    Matrix lRef(size, size, 0.0), uRef = dense;
+    for (Size j=0; j<size; ++j) {
+        lRef[j][j] = 1.0;
+        for (Size i=j+1; i<size; ++i) {
+            const Real factor = uRef[i][j] / uRef[j][j];
+            lRef[i][j] = factor;
+            for (Size m=j; m<size; ++m)
+                uRef[i][m] -= factor * uRef[j][m];
+        }
+    }
+
+    const SparseILUPreconditioner full(CsrMatrix(a), size);
+    const Matrix l = toDense(full.L()), u = toDense(full.U());
+    for (Size i=0; i<size; ++i) {
+        for (Size j=0; j<size; ++j) {
+            if (std::fabs(l[i][j] - lRef[i][j]) > tolerance ||
+                std::fabs(u[i][j] - uRef[i][j]) > tolerance)
+                BOOST_FAIL("complete factors differ from dense LU at ("
+                           << i << ", " << j << "):"
+                           << std::setprecision(12)
+                           << "\n    L: " << l[i][j] << " vs " << lRef[i][j]
+                           << "\n    U: " << u[i][j] << " vs " << uRef[i][j]);
+        }
+    }
+
+    // and the preconditioner solves the system exactly
+    Array b(size);
+    for (Size i=0; i<size; ++i)
+        b[i] = 1.0 + 0.1*i;
+    const Array x = full.apply(b);
+    const Array expected = inverse(dense) * b;
+    for (Size i=0; i<size; ++i) {
+        if (std::fabs(x[i] - expected[i]) > 1.0e-10)
+            BOOST_FAIL("wrong solution at " << i << ":"
+                       << std::setprecision(12)
+                       << "\n    ILU:   " << x[i]
+                       << "\n    dense: " << expected[i]);
+    }
+}
+
 #define QL_CHECK_CLOSE_MATRIX(actual, expected)                             \
     BOOST_REQUIRE(actual.rows() == expected.rows() &&                       \
                   actual.columns() == expected.columns());                  \
@@ -842,6 +997,83 @@ BOOST_AUTO_TEST_CASE(testOperators) {
     QL_CHECK_CLOSE_MATRIX(rvalue_real_quotient, scalar_quotient);
 }
 
+BOOST_AUTO_TEST_CASE(testProducts) {
+
+    BOOST_TEST_MESSAGE("Testing matrix products against direct loops...");
+
+    MersenneTwisterUniformRng rng(1234);
+    auto randomMatrix = [&rng](Size rows, Size columns) {
+        Matrix m(rows, columns);
+        for (auto& x : m)
+            x = rng.nextReal() - 0.5;
+        return m;
+    };
+
+    // sizes across the block boundaries of the implementation
+    const Size sizes[] = { 0, 1, 3, 4, 5, 127, 128, 129, 257 };
+    const Real tolerance = 1.0e-12;
+
+    for (Size rows : sizes) {
+        for (Size inner : { Size(0), Size(5), Size(129) }) {
+            for (Size columns : { Size(1), Size(7), Size(258) }) {
+                const Matrix a = randomMatrix(rows, inner);
+                const Matrix b = randomMatrix(inner, columns);
+                Array v(inner), w(rows);
+                for (auto& x : v)
+                    x = rng.nextReal() - 0.5;
+                for (auto& x : w)
+                    x = rng.nextReal() - 0.5;
+
+                const Matrix c = a*b;
+                const Matrix t = transpose(a);
+                const Array av = a*v;
+                const Array wa = w*a;
+
+                BOOST_REQUIRE(c.rows() == rows && c.columns() == columns);
+                BOOST_REQUIRE(t.rows() == inner && t.columns() == rows);
+                BOOST_REQUIRE(av.size() == rows && wa.size() == inner);
+
+                for (Size i=0; i<rows; ++i) {
+                    for (Size j=0; j<columns; ++j) {
+                        Real expected = 0.0;
+                        for (Size k=0; k<inner; ++k)
+                            expected += a[i][k]*b[k][j];
+                        if (std::fabs(c[i][j] - expected) > tolerance)
+                            BOOST_FAIL("wrong matrix product for "
+                                       << rows << "x" << inner << " and "
+                                       << inner << "x" << columns << " matrices"
+                                       << "\n    element:    (" << i << ", " << j << ")"
+                                       << "\n    calculated: " << c[i][j]
+                                       << "\n    expected:   " << expected);
+                    }
+                    Real expected = 0.0;
+                    for (Size k=0; k<inner; ++k) {
+                        expected += a[i][k]*v[k];
+                        if (t[k][i] != a[i][k])
+                            BOOST_FAIL("wrong transpose of "
+                                       << rows << "x" << inner << " matrix");
+                    }
+                    if (std::fabs(av[i] - expected) > tolerance)
+                        BOOST_FAIL("wrong matrix-array product for "
+                                   << rows << "x" << inner << " matrix"
+                                   << "\n    calculated: " << av[i]
+                                   << "\n    expected:   " << expected);
+                }
+                for (Size k=0; k<inner; ++k) {
+                    Real expected = 0.0;
+                    for (Size i=0; i<rows; ++i)
+                        expected += w[i]*a[i][k];
+                    if (std::fabs(wa[k] - expected) > tolerance)
+                        BOOST_FAIL("wrong array-matrix product for "
+                                   << rows << "x" << inner << " matrix"
+                                   << "\n    calculated: " << wa[k]
+                                   << "\n    expected:   " << expected);
+                }
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -24,11 +24,14 @@
 #include "preconditions.hpp"
 #include "toplevelfixture.hpp"
 #include "utilities.hpp"
+#include <ql/experimental/math/fireflyalgorithm.hpp>
+#include <ql/experimental/math/particleswarmoptimization.hpp>
 #include <ql/math/optimization/bfgs.hpp>
 #include <ql/math/optimization/conjugategradient.hpp>
 #include <ql/math/optimization/constraint.hpp>
 #include <ql/math/optimization/costfunction.hpp>
 #include <ql/math/optimization/differentialevolution.hpp>
+#include <ql/math/optimization/evaluationexecutor.hpp>
 #include <ql/math/optimization/goldstein.hpp>
 #include <ql/math/optimization/levenbergmarquardt.hpp>
 #include <ql/math/optimization/simplex.hpp>
@@ -540,6 +543,101 @@ BOOST_AUTO_TEST_CASE(testDifferentialEvolution) {
     }
 }
 
+// runs the evaluations out of order, as a parallel executor might, so
+// that the comparison doesn't depend on the library being built with
+// OpenMP
+class ShuffledEvaluationExecutor : public EvaluationExecutor {
+  public:
+    explicit ShuffledEvaluationExecutor(Size stride) : stride_(stride) {}
+    void run(Size n, const std::function<void(Size)>& task) const override {
+        for (Size start=stride_; start-- > 0;) {
+            for (Size i=start; i<n; i+=stride_) {
+                task(n-1-i);
+                ++tasks_;
+            }
+        }
+    }
+    Size tasks() const { return tasks_; }
+  private:
+    Size stride_;
+    mutable Size tasks_ = 0;
+};
+
+BOOST_AUTO_TEST_CASE(testPopulationEvaluationExecutors) {
+    BOOST_TEST_MESSAGE("Testing executors for population-based optimizers...");
+
+    Griewangk costFunction;
+    BoundaryConstraint constraint(-600.0, 600.0);
+    Array initialValue(5, 100.0);
+    EndCriteria endCriteria(50, 40, 1e-12, 1e-10, Null<Real>());
+
+    // the optimizers are built anew for each run, since they keep state
+    std::vector<std::pair<std::string,
+                          std::function<ext::shared_ptr<OptimizationMethod>()> > > optimizers = {
+        {"differential evolution",
+         []() {
+             return ext::make_shared<DifferentialEvolution>(
+                 DifferentialEvolution::Configuration()
+                 .withBounds()
+                 .withPopulationMembers(50)
+                 .withStrategy(DifferentialEvolution::Rand1SelfadaptiveWithRotation)
+                 .withAdaptiveCrossover()
+                 .withSeed(42));
+         }},
+        {"particle swarm optimization",
+         []() {
+             return ext::make_shared<ParticleSwarmOptimization>(
+                 50, ext::make_shared<KNeighbors>(2), ext::make_shared<TrivialInertia>(),
+                 2.05, 2.05, 42UL);
+         }},
+        {"firefly algorithm",
+         []() {
+             return ext::make_shared<FireflyAlgorithm>(
+                 50, ext::make_shared<ExponentialIntensity>(10.0, 1e-8, 1.0),
+                 ext::make_shared<GaussianWalk>(2.5, 0.9, 42), 20, 1.0, 0.5, 42);
+         }}
+    };
+
+    std::vector<ext::shared_ptr<EvaluationExecutor> > executors = {
+        ext::make_shared<EvaluationExecutor>(),
+        ext::make_shared<ParallelEvaluationExecutor>(),
+        ext::make_shared<ParallelEvaluationExecutor>(3),
+        ext::make_shared<ShuffledEvaluationExecutor>(1),
+        ext::make_shared<ShuffledEvaluationExecutor>(7)
+    };
+
+    for (const auto& optimizer : optimizers) {
+        Problem reference(costFunction, constraint, initialValue);
+        optimizer.second()->minimize(reference, endCriteria);
+
+        for (const auto& executor : executors) {
+            auto shuffled = ext::dynamic_pointer_cast<ShuffledEvaluationExecutor>(executor);
+            Size tasks = shuffled != nullptr ? shuffled->tasks() : 0;
+
+            Problem problem(costFunction, constraint, initialValue, executor);
+            optimizer.second()->minimize(problem, endCriteria);
+
+            if (shuffled != nullptr && shuffled->tasks() == tasks)
+                BOOST_ERROR(optimizer.first << " didn't use the executor");
+
+            if (problem.functionValue() != reference.functionValue()
+                || problem.functionEvaluation() != reference.functionEvaluation()
+                || !std::equal(problem.currentValue().begin(),
+                               problem.currentValue().end(),
+                               reference.currentValue().begin())) {
+                BOOST_ERROR("failed to reproduce " << optimizer.first
+                            << " results with executor:"
+                            << "\n    calculated: " << problem.functionValue()
+                            << " at " << problem.currentValue()
+                            << " after " << problem.functionEvaluation() << " evaluations"
+                            << "\n    expected:   " << reference.functionValue()
+                            << " at " << reference.currentValue()
+                            << " after " << reference.functionEvaluation() << " evaluations");
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
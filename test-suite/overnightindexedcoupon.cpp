@@ -534,6 +534,44 @@ BOOST_AUTO_TEST_CASE(testErrorWhenLookbackOrLockoutAppliedForSimpleAveraging) {
                       Error);
 }
 
+BOOST_AUTO_TEST_CASE(testCachedCompoundFactor) {
+    BOOST_TEST_MESSAGE("Testing cached compounded fixings of overnight index...");
+
+    CommonVars vars;
+
+    Date first(18, October, 2021), last(17, November, 2021);
+    Calendar calendar = vars.sofr->fixingCalendar();
+    DayCounter dayCounter = vars.sofr->dayCounter();
+
+    Size n = 0;
+    Real expected = 1.0;
+    for (Date d = first; d <= last; d = calendar.advance(d, 1, Days), ++n)
+        expected *= 1.0 + vars.sofr->fixing(d) *
+            dayCounter.yearFraction(d, calendar.advance(d, 1, Days));
+
+    CHECK_OIS_COUPON_RESULT("compound factor",
+                            vars.sofr->compoundFactor(first, last, n), expected, 1e-14);
+
+    // ranges which are not covered by consecutive fixings
+    BOOST_CHECK(vars.sofr->compoundFactor(first, last, n - 1) == Null<Real>());
+    BOOST_CHECK(vars.sofr->compoundFactor(Date(5, August, 2019), first, 2) == Null<Real>());
+
+    // the cache must follow changes in the stored fixings
+    auto pastCoupon = vars.makeCoupon(Date(18, October, 2021),
+                                      Date(18, November, 2021));
+    Rate rate = pastCoupon->rate();
+
+    vars.sofr->addFixing(Date(1, November, 2021), 0.0019, true);
+    pastCoupon->update();
+    Rate expectedRate =
+        ((1.0 + rate * 31.0/360) * (1.0 + 0.0019/360) / (1.0 + 0.0009/360) - 1.0) * 360/31.0;
+    CHECK_OIS_COUPON_RESULT("coupon rate after fixing change",
+                            pastCoupon->rate(), expectedRate, 1e-12);
+
+    IndexManager::instance().clearHistory(vars.sofr->name());
+    BOOST_CHECK(vars.sofr->compoundFactor(first, last, n) == Null<Real>());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -85,6 +85,16 @@ void testSingle(const ext::shared_ptr<StochasticProcess1D>& process,
 
 }
 
+class LastValuePricer : public PathPricer<MultiPath> {
+  public:
+    Real operator()(const MultiPath& multiPath) const override {
+        Real sum = 0.0;
+        for (Size j=0; j<multiPath.assetNumber(); j++)
+            sum += multiPath[j].back();
+        return sum;
+    }
+};
+
 void testMultiple(const ext::shared_ptr<StochasticProcess>& process,
                   const std::string& tag,
                   Real expected[], Real antithetic[]) {
@@ -138,6 +148,37 @@ void testMultiple(const ext::shared_ptr<StochasticProcess>& process,
                         << "    tolerance:  " << tolerance);
         }
     }
+
+    // contiguous paths must be the same as the ones above
+    TimeGrid grid(length, timeSteps);
+    MultiPathGenerator<rsg_type> reference(process, grid, rsg, false);
+    MultiPathMatrixGenerator<rsg_type> contiguous(process, grid, rsg, false);
+    LastValuePricer pricer;
+    MultiPathPricerAdapter adapter(ext::make_shared<LastValuePricer>());
+    for (i=0; i<10; i++) {
+        bool useAntithetic = (i % 2 == 1);
+        const MultiPath& path1 = useAntithetic ? reference.antithetic().value
+                                               : reference.next().value;
+        const MultiPathMatrix& path2 = useAntithetic ? contiguous.antithetic().value
+                                                     : contiguous.next().value;
+        for (j=0; j<assets; j++) {
+            for (Size k=0; k<path1.pathSize(); k++) {
+                if (path1[j][k] != path2[j][k])
+                    BOOST_ERROR("using " << tag << " process "
+                                << "(" << io::ordinal(j+1) << " asset:)\n"
+                                << "contiguous path differs at step " << k << ":\n"
+                                << std::setprecision(16)
+                                << "    calculated: " << path2[j][k] << "\n"
+                                << "    expected:   " << path1[j][k]);
+            }
+        }
+        if (adapter(path2) != pricer(path1))
+            BOOST_ERROR("using " << tag << " process:\n"
+                        << "adapted pricer differs from original:\n"
+                        << std::setprecision(16)
+                        << "    calculated: " << adapter(path2) << "\n"
+                        << "    expected:   " << pricer(path1));
+    }
 }
 
 
@@ -0,0 +1,196 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "toplevelfixture.hpp"
+#include "utilities.hpp"
+#include <ql/math/randomnumbers/philox4x32uniformrng.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
+#include <ql/math/statistics/generalstatistics.hpp>
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+
+BOOST_FIXTURE_TEST_SUITE(QuantLibTests, TopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(Philox4x32Tests)
+
+BOOST_AUTO_TEST_CASE(testKnownAnswers) {
+    BOOST_TEST_MESSAGE("Testing Philox4x32UniformRng against known-answer tests...");
+
+    // from the kat_vectors file of the Random123 reference implementation;
+    // the key is the seed, and the counter is made of the block index
+    // (first two words) and the stream (last two words).
+    struct KnownAnswer {
+        std::uint32_t counter[4];
+        std::uint32_t key[2];
+        std::uint32_t result[4];
+    };
+    KnownAnswer answers[] = {
+        {{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+         {0xffffffff, 0xffffffff},
+         {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}},
+        {{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+         {0xa4093822, 0x299f31d0},
+         {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}
+    };
+
+    for (const auto& answer : answers) {
+        std::uint64_t seed = (std::uint64_t(answer.key[1]) << 32) | answer.key[0];
+        std::uint64_t block = (std::uint64_t(answer.counter[1]) << 32) | answer.counter[0];
+        std::uint64_t stream = (std::uint64_t(answer.counter[3]) << 32) | answer.counter[2];
+
+        Philox4x32UniformRng rng(seed, stream);
+        BOOST_CHECK_EQUAL(rng.seed(), seed);
+        BOOST_CHECK_EQUAL(rng.stream(), stream);
+        // each discarded number takes half a block
+        rng.discard(block);
+        rng.discard(block);
+
+        for (std::uint32_t expected : answer.result) {
+            std::uint32_t calculated = rng.nextInt32();
+            if (calculated != expected)
+                BOOST_ERROR("failed to reproduce known answer"
+                            << std::hex
+                            << "\n    seed:       " << seed
+                            << "\n    block:      " << block
+                            << "\n    stream:     " << stream
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testStreams) {
+    BOOST_TEST_MESSAGE("Testing Philox4x32UniformRng streams and discard...");
+
+    const std::uint64_t seed = 42;
+    const Size n = 1000;
+
+    Philox4x32UniformRng rng(seed, 7);
+    std::vector<std::uint64_t> reference(n);
+    for (Size i=0; i<n; ++i)
+        reference[i] = rng.nextInt64();
+
+    // copies, splits and fresh instances give the same stream
+    Philox4x32UniformRng fresh(seed, 7);
+    Philox4x32UniformRng split = Philox4x32UniformRng(seed, 3).split(7);
+    Philox4x32UniformRng copy = fresh;
+    for (Size i=0; i<n; ++i) {
+        std::uint64_t x1 = fresh.nextInt64(), x2 = split.nextInt64(), x3 = copy.nextInt64();
+        if (x1 != reference[i] || x2 != reference[i] || x3 != reference[i])
+            BOOST_FAIL("failed to reproduce stream at index " << i);
+    }
+
+    // discard, also starting from odd positions
+    for (Size skip : {0, 1, 2, 3, 5, 8, 13, 333}) {
+        for (Size offset : {0, 1}) {
+            Philox4x32UniformRng r(seed, 7);
+            if (offset == 1)
+                r.nextInt32();
+            r.discard(skip);
+            Philox4x32UniformRng expected(seed, 7);
+            for (Size i=0; i<2*skip+offset; ++i)
+                expected.nextInt32();
+            for (Size i=0; i<10; ++i) {
+                if (r.nextInt32() != expected.nextInt32())
+                    BOOST_FAIL("failed to discard " << skip
+                               << " numbers after " << offset << " words");
+            }
+        }
+    }
+
+    // different streams and seeds are different
+    Philox4x32UniformRng other1(seed, 8), other2(seed+1, 7);
+    Size equal1 = 0, equal2 = 0;
+    for (Size i=0; i<n; ++i) {
+        if (other1.nextInt64() == reference[i])
+            ++equal1;
+        if (other2.nextInt64() == reference[i])
+            ++equal2;
+    }
+    BOOST_CHECK_EQUAL(equal1, 0U);
+    BOOST_CHECK_EQUAL(equal2, 0U);
+}
+
+BOOST_AUTO_TEST_CASE(testUniformity) {
+    BOOST_TEST_MESSAGE("Testing Philox4x32UniformRng::nextReal() for mean=0.5 and variance=1/12...");
+
+    Philox4x32UniformRng rng(1);
+    GeneralStatistics stats;
+    for (Size i=0; i<1000000; ++i) {
+        Real x = rng.nextReal();
+        BOOST_REQUIRE(x > 0.0 && x < 1.0);
+        stats.add(x);
+    }
+    BOOST_CHECK_SMALL(stats.mean() - 0.5, 1.0e-3);
+    BOOST_CHECK_SMALL(stats.variance() - 1.0/12.0, 1.0e-3);
+}
+
+BOOST_AUTO_TEST_CASE(testSequenceDiscard) {
+    BOOST_TEST_MESSAGE("Testing random access to Philox sequences...");
+
+    const Size dimension = 5, paths = 100;
+    const BigNatural seed = 1234;
+
+    PhiloxPseudoRandom::rsg_type generator =
+        PhiloxPseudoRandom::make_sequence_generator(dimension, seed);
+    std::vector<std::vector<Real> > sequences;
+    for (Size i=0; i<paths; ++i)
+        sequences.push_back(generator.nextSequence().value);
+
+    // each path can be generated from its index alone
+    for (Size i : {0, 1, 17, 99}) {
+        RandomSequenceGenerator<Philox4x32UniformRng> ursg(dimension, seed);
+        ursg.discard(i);
+        PhiloxPseudoRandom::rsg_type g(ursg);
+        const std::vector<Real>& sequence = g.nextSequence().value;
+        for (Size j=0; j<dimension; ++j) {
+            if (sequence[j] != sequences[i][j])
+                BOOST_FAIL("failed to reproduce sequence " << i
+                           << "\n    variate:    " << j
+                           << "\n    calculated: " << sequence[j]
+                           << "\n    expected:   " << sequences[i][j]);
+        }
+    }
+
+    // the same through the Gaussian sequence generator, also after
+    // drawing some sequences
+    for (Size start : {0, 3}) {
+        for (Size skip : {0, 1, 17, 50}) {
+            PhiloxPseudoRandom::rsg_type g =
+                PhiloxPseudoRandom::make_sequence_generator(dimension, seed);
+            for (Size i=0; i<start; ++i)
+                g.nextSequence();
+            g.discard(skip);
+            const std::vector<Real>& sequence = g.nextSequence().value;
+            Size i = start + skip;
+            for (Size j=0; j<dimension; ++j) {
+                if (sequence[j] != sequences[i][j])
+                    BOOST_FAIL("failed to reproduce sequence " << i
+                               << " after drawing " << start
+                               << " and discarding " << skip
+                               << "\n    variate:    " << j
+                               << "\n    calculated: " << sequence[j]
+                               << "\n    expected:   " << sequences[i][j]);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,152 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "toplevelfixture.hpp"
+#include "utilities.hpp"
+#include <ql/experimental/risk/scenarioengine.hpp>
+#include <ql/exercise.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <iomanip>
+#include <mutex>
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+
+BOOST_FIXTURE_TEST_SUITE(QuantLibTests, TopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(ScenarioEngineTests)
+
+// quotes: spot, dividend yield, risk-free rate, volatility
+ScenarioPortfolio optionPortfolio(const Date& today) {
+    Settings::instance().evaluationDate() = today;
+    DayCounter dc = Actual365Fixed();
+
+    auto spot = ext::make_shared<SimpleQuote>(100.0);
+    auto qRate = ext::make_shared<SimpleQuote>(0.01);
+    auto rRate = ext::make_shared<SimpleQuote>(0.03);
+    auto vol = ext::make_shared<SimpleQuote>(0.20);
+
+    auto process = ext::make_shared<BlackScholesMertonProcess>(
+        Handle<Quote>(spot),
+        Handle<YieldTermStructure>(flatRate(today, qRate, dc)),
+        Handle<YieldTermStructure>(flatRate(today, rRate, dc)),
+        Handle<BlackVolTermStructure>(flatVol(today, vol, dc)));
+    auto engine = ext::make_shared<AnalyticEuropeanEngine>(process);
+
+    ScenarioPortfolio portfolio;
+    portfolio.quotes = {Handle<SimpleQuote>(spot), Handle<SimpleQuote>(qRate),
+                        Handle<SimpleQuote>(rRate), Handle<SimpleQuote>(vol)};
+    for (Size i=0; i<6; ++i) {
+        auto option = ext::make_shared<VanillaOption>(
+            ext::make_shared<PlainVanillaPayoff>(i % 2 == 0 ? Option::Call : Option::Put,
+                                                 80.0 + 8.0*i),
+            ext::make_shared<EuropeanExercise>(today + Integer(3*(i+1)) * Months));
+        option->setPricingEngine(engine);
+        portfolio.instruments.push_back(option);
+    }
+    return portfolio;
+}
+
+std::vector<std::vector<Real> > testScenarios(Size n) {
+    std::vector<std::vector<Real> > scenarios;
+    for (Size i=0; i<n; ++i) {
+        Real x = Real(i) / n;
+        scenarios.push_back({20.0*(x-0.5), 0.001*(i % 3), -0.01*x, 0.05*std::sin(7.0*x)});
+    }
+    return scenarios;
+}
+
+BOOST_AUTO_TEST_CASE(testAgainstSequentialRepricing) {
+
+    BOOST_TEST_MESSAGE("Testing scenario engine against sequential repricing...");
+
+    Date today = Settings::instance().evaluationDate();
+    std::vector<std::vector<Real> > scenarios = testScenarios(50);
+
+    ScenarioEngine engine([today]() { return optionPortfolio(today); }, scenarios);
+    Matrix results = engine.calculate();
+
+    BOOST_REQUIRE(results.rows() == scenarios.size());
+
+    ScenarioPortfolio reference = optionPortfolio(today);
+    BOOST_REQUIRE(results.columns() == reference.instruments.size());
+
+    std::vector<Real> base;
+    for (const auto& q : reference.quotes)
+        base.push_back(q->value());
+
+    for (Size i=0; i<scenarios.size(); ++i) {
+        for (Size k=0; k<base.size(); ++k)
+            reference.quotes[k]->setValue(base[k] + scenarios[i][k]);
+        for (Size j=0; j<reference.instruments.size(); ++j) {
+            Real expected = reference.instruments[j]->NPV();
+            if (std::fabs(results[i][j] - expected) > 1.0e-12 * (1.0 + std::fabs(expected)))
+                BOOST_ERROR("scenario #" << i << ", instrument #" << j << ":"
+                            << std::setprecision(12)
+                            << "\n    engine:     " << results[i][j]
+                            << "\n    sequential: " << expected);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testErrors) {
+
+    BOOST_TEST_MESSAGE("Testing error handling in scenario engine...");
+
+    Date today = Settings::instance().evaluationDate();
+
+    // the factory keeps track of the quotes it builds in all threads
+    std::mutex mutex;
+    std::vector<std::pair<Handle<SimpleQuote>, Real> > built;
+    auto factory = [&]() {
+        ScenarioPortfolio portfolio = optionPortfolio(today);
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& q : portfolio.quotes)
+            built.emplace_back(q, q->value());
+        return portfolio;
+    };
+
+    // a negative spot in one of the scenarios makes pricing fail
+    std::vector<std::vector<Real> > scenarios = testScenarios(40);
+    scenarios[25][0] = -200.0;
+    ScenarioEngine failing(factory, scenarios);
+    BOOST_CHECK_THROW(failing.calculate(), Error);
+
+    for (const auto& q : built) {
+        if (q.first->value() != q.second)
+            BOOST_FAIL("quote not restored after failed scenario: "
+                       << q.first->value() << " instead of " << q.second);
+    }
+
+    std::vector<std::vector<Real> > wrongSize = testScenarios(5);
+    wrongSize[3].pop_back();
+    ScenarioEngine inconsistent(factory, wrongSize);
+    BOOST_CHECK_THROW(inconsistent.calculate(), Error);
+
+    ScenarioEngine throwing(
+        []() -> ScenarioPortfolio { QL_FAIL("market not available"); },
+        testScenarios(5));
+    BOOST_CHECK_THROW(throwing.calculate(), Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -20,6 +20,7 @@
 #include "toplevelfixture.hpp"
 #include "utilities.hpp"
 #include <ql/time/schedule.hpp>
+#include <ql/time/schedulecache.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/japan.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
@@ -1133,6 +1134,52 @@ BOOST_AUTO_TEST_CASE(testTruncation) {
     BOOST_CHECK(t.isRegular().front() == true);
 }
 
+BOOST_AUTO_TEST_CASE(testScheduleCache) {
+    BOOST_TEST_MESSAGE("Testing schedule cache...");
+
+    ScheduleCache& cache = ScheduleCache::instance();
+    cache.clear();
+
+    Date effective(30, September, 2009), termination(15, June, 2020);
+    Schedule expected(effective, termination, 6 * Months, Japan(),
+                      Following, Following, DateGeneration::Forward, true);
+
+    auto s1 = cache.schedule(effective, termination, 6 * Months, Japan(),
+                             Following, Following, DateGeneration::Forward, true);
+    check_dates(*s1, expected.dates());
+    BOOST_CHECK(s1->isRegular() == expected.isRegular());
+    BOOST_CHECK_EQUAL(cache.size(), 1U);
+
+    auto s2 = cache.schedule(effective, termination, 6 * Months, Japan(),
+                             Following, Following, DateGeneration::Forward, true);
+    BOOST_CHECK(s1 == s2);
+
+    auto s3 = cache.schedule(effective, termination, 6 * Months, TARGET(),
+                             Following, Following, DateGeneration::Forward, true);
+    BOOST_CHECK(s3 != s1);
+    BOOST_CHECK_EQUAL(cache.size(), 2U);
+
+    auto s4 = cache.schedule(effective, termination, 3 * Months, Japan(),
+                             Following, Following, DateGeneration::Forward, true);
+    BOOST_CHECK(s4 != s1);
+    BOOST_CHECK_EQUAL(cache.size(), 3U);
+
+    // schedules with a null effective date are not stored
+    Settings::instance().evaluationDate() = Date(15, March, 2012);
+    auto s5 = cache.schedule(Date(), termination, 6 * Months, Japan(),
+                             Following, Following, DateGeneration::Backward, true);
+    BOOST_CHECK_EQUAL(cache.size(), 3U);
+    BOOST_CHECK(s5->dates().back() == termination);
+
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.size(), 0U);
+    auto s6 = cache.schedule(effective, termination, 6 * Months, Japan(),
+                             Following, Following, DateGeneration::Forward, true);
+    BOOST_CHECK(s6 != s1);
+    check_dates(*s6, expected.dates());
+    cache.clear();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,305 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "toplevelfixture.hpp"
+#include "utilities.hpp"
+#include <ql/experimental/risk/sensitivityengine.hpp>
+#include <ql/exercise.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <iomanip>
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+
+BOOST_FIXTURE_TEST_SUITE(QuantLibTests, TopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(SensitivityAnalysisTests)
+
+struct OptionPortfolio {
+    std::vector<Handle<SimpleQuote> > quotes;
+    std::vector<ext::shared_ptr<Instrument> > instruments;
+    std::vector<Real> quantities;
+
+    OptionPortfolio() {
+        Date today = Settings::instance().evaluationDate();
+        DayCounter dc = Actual365Fixed();
+
+        auto spot = ext::make_shared<SimpleQuote>(100.0);
+        auto qRate = ext::make_shared<SimpleQuote>(0.01);
+        auto rRate = ext::make_shared<SimpleQuote>(0.03);
+        auto vol = ext::make_shared<SimpleQuote>(0.20);
+        quotes = {Handle<SimpleQuote>(spot), Handle<SimpleQuote>(qRate),
+                  Handle<SimpleQuote>(rRate), Handle<SimpleQuote>(vol)};
+
+        auto process = ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(spot),
+            Handle<YieldTermStructure>(flatRate(today, qRate, dc)),
+            Handle<YieldTermStructure>(flatRate(today, rRate, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, vol, dc)));
+        auto engine = ext::make_shared<AnalyticEuropeanEngine>(process);
+
+        Real strikes[] = {90.0, 100.0, 115.0};
+        Option::Type types[] = {Option::Put, Option::Call, Option::Call};
+        Integer months[] = {6, 12, 24};
+        for (Size i=0; i<3; ++i) {
+            auto option = ext::make_shared<VanillaOption>(
+                ext::make_shared<PlainVanillaPayoff>(types[i], strikes[i]),
+                ext::make_shared<EuropeanExercise>(today + months[i] * Months));
+            option->setPricingEngine(engine);
+            instruments.push_back(option);
+        }
+        quantities = {2.0, -1.0, 3.0};
+    }
+
+    std::vector<Real> quoteValues() const {
+        std::vector<Real> values;
+        for (const auto& q : quotes)
+            values.push_back(q->value());
+        return values;
+    }
+};
+
+void checkClose(Real calculated, Real expected, Real tolerance,
+                const std::string& what, Size i) {
+    if (expected == Null<Real>() || calculated == Null<Real>()) {
+        if (expected != calculated)
+            BOOST_ERROR("mismatch in " << what << " for quote #" << i
+                        << ": " << calculated << " vs " << expected);
+        return;
+    }
+    if (std::fabs(calculated - expected) > tolerance * (1.0 + std::fabs(expected)))
+        BOOST_ERROR("mismatch in " << what << " for quote #" << i
+                    << std::setprecision(12)
+                    << ":\n    engine:   " << calculated
+                    << "\n    expected: " << expected);
+}
+
+BOOST_AUTO_TEST_CASE(testBucketsAgainstBucketAnalysis) {
+
+    BOOST_TEST_MESSAGE(
+        "Testing bucketed sensitivity engine against bucket analysis...");
+
+    OptionPortfolio portfolio;
+    std::vector<Real> baseValues = portfolio.quoteValues();
+    Real shift = 1.0e-4;
+
+    for (SensitivityAnalysis type : {Centered, OneSide}) {
+        BucketSensitivityEngine engine(portfolio.quotes, portfolio.instruments,
+                                       portfolio.quantities, shift, type);
+
+        std::pair<std::vector<Real>, std::vector<Real> > expected =
+            bucketAnalysis(portfolio.quotes, portfolio.instruments,
+                           portfolio.quantities, shift, type);
+
+        std::vector<Real> deltas(engine.size(), Null<Real>());
+        std::vector<Real> gammas(engine.size(), Null<Real>());
+        engine.calculate([&](Size i, Real delta, Real gamma) {
+            deltas[i] = delta;
+            gammas[i] = gamma;
+        });
+
+        for (Size i=0; i<engine.size(); ++i) {
+            checkClose(deltas[i], expected.first[i], 1.0e-10, "delta", i);
+            checkClose(gammas[i], expected.second[i], 1.0e-10, "gamma", i);
+        }
+
+        if (portfolio.quoteValues() != baseValues)
+            BOOST_FAIL("quotes not restored after bucketed analysis");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testOneSideSecondOrder) {
+
+    BOOST_TEST_MESSAGE(
+        "Testing one-sided second derivatives of bucketed sensitivity engine...");
+
+    OptionPortfolio portfolio;
+    std::vector<Real> baseValues = portfolio.quoteValues();
+    Real shift = 1.0e-3;
+
+    BucketSensitivityEngine engine(portfolio.quotes, portfolio.instruments,
+                                   portfolio.quantities, shift, OneSide, true);
+
+    std::pair<std::vector<Real>, std::vector<Real> > oneSide =
+        bucketAnalysis(portfolio.quotes, portfolio.instruments,
+                       portfolio.quantities, shift, OneSide);
+    std::pair<std::vector<Real>, std::vector<Real> > centered =
+        bucketAnalysis(portfolio.quotes, portfolio.instruments,
+                       portfolio.quantities, shift, Centered);
+
+    std::vector<Real> deltas(engine.size()), gammas(engine.size());
+    engine.calculate([&](Size i, Real delta, Real gamma) {
+        deltas[i] = delta;
+        gammas[i] = gamma;
+    });
+
+    Real reference = aggregateNPV(portfolio.instruments, portfolio.quantities);
+    for (Size i=0; i<engine.size(); ++i) {
+        checkClose(deltas[i], oneSide.first[i], 1.0e-10, "delta", i);
+
+        // forward second difference, calculated by hand
+        const Handle<SimpleQuote>& quote = portfolio.quotes[i];
+        quote->setValue(baseValues[i] + shift);
+        Real npv1 = aggregateNPV(portfolio.instruments, portfolio.quantities);
+        quote->setValue(baseValues[i] + 2.0*shift);
+        Real npv2 = aggregateNPV(portfolio.instruments, portfolio.quantities);
+        quote->setValue(baseValues[i]);
+        Real expected = (npv2 - 2.0*npv1 + reference) / (shift*shift);
+        checkClose(gammas[i], expected, 1.0e-10, "gamma", i);
+
+        // the forward difference is only first-order accurate
+        Real scale = std::fabs(centered.second[i]) + 1.0;
+        if (std::fabs(gammas[i] - centered.second[i]) > 0.05 * scale)
+            BOOST_ERROR("one-sided gamma too far from centered one for quote #"
+                        << i << ":\n    one-sided: " << gammas[i]
+                        << "\n    centered:  " << centered.second[i]);
+    }
+
+    if (portfolio.quoteValues() != baseValues)
+        BOOST_FAIL("quotes not restored after bucketed analysis");
+}
+
+BOOST_AUTO_TEST_CASE(testQuoteRanges) {
+
+    BOOST_TEST_MESSAGE(
+        "Testing bucketed sensitivity engine on ranges of quotes...");
+
+    OptionPortfolio portfolio;
+    Real shift = 1.0e-4;
+
+    BucketSensitivityEngine engine(portfolio.quotes, portfolio.instruments,
+                                   portfolio.quantities, shift, Centered);
+    std::pair<std::vector<Real>, std::vector<Real> > expected =
+        bucketAnalysis(portfolio.quotes, portfolio.instruments,
+                       portfolio.quantities, shift, Centered);
+
+    Real referenceNpv = engine.referenceNPV();
+
+    // the union of the ranges must cover each quote once
+    std::vector<Size> calls(engine.size(), 0);
+    std::vector<Real> deltas(engine.size()), gammas(engine.size());
+    auto collect = [&](Size i, Real delta, Real gamma) {
+        ++calls[i];
+        deltas[i] = delta;
+        gammas[i] = gamma;
+    };
+    engine.calculate(0, 1, collect, referenceNpv);
+    engine.calculate(1, 1, collect, referenceNpv);
+    engine.calculate(1, engine.size(), collect, referenceNpv);
+
+    for (Size i=0; i<engine.size(); ++i) {
+        if (calls[i] != 1)
+            BOOST_ERROR("quote #" << i << " bumped " << calls[i] << " times");
+        checkClose(deltas[i], expected.first[i], 1.0e-10, "delta", i);
+        checkClose(gammas[i], expected.second[i], 1.0e-10, "gamma", i);
+    }
+
+    BOOST_CHECK_THROW(engine.calculate(2, 1, collect), Error);
+    BOOST_CHECK_THROW(engine.calculate(0, engine.size()+1, collect), Error);
+}
+
+BOOST_AUTO_TEST_CASE(testPortfolioFactory) {
+
+    BOOST_TEST_MESSAGE(
+        "Testing bucketed sensitivity engine on copies built by a factory...");
+
+    // with OpenMP and sessions, each thread bumps the quotes of its
+    // own copy of the portfolio; the results must match the serial ones
+    Date today = Settings::instance().evaluationDate();
+    auto factory = [today]() {
+        Settings::instance().evaluationDate() = today;
+        OptionPortfolio portfolio;
+        return ScenarioPortfolio{portfolio.quotes, portfolio.instruments};
+    };
+
+    OptionPortfolio portfolio;
+    Real shift = 1.0e-4;
+
+    for (SensitivityAnalysis type : {Centered, OneSide}) {
+        BucketSensitivityEngine serial(portfolio.quotes, portfolio.instruments,
+                                       portfolio.quantities, shift, type, true);
+        BucketSensitivityEngine copies(factory, portfolio.quantities,
+                                       shift, type, true);
+
+        BOOST_CHECK_EQUAL(copies.size(), serial.size());
+        BOOST_CHECK_EQUAL(copies.referenceNPV(), serial.referenceNPV());
+
+        std::vector<Real> deltas(serial.size()), gammas(serial.size());
+        serial.calculate([&](Size i, Real delta, Real gamma) {
+            deltas[i] = delta;
+            gammas[i] = gamma;
+        });
+
+        std::vector<Size> calls(copies.size(), 0);
+        copies.calculate([&](Size i, Real delta, Real gamma) {
+            ++calls[i];
+            checkClose(delta, deltas[i], 0.0, "delta", i);
+            checkClose(gamma, gammas[i], 0.0, "gamma", i);
+        });
+        for (Size i=0; i<copies.size(); ++i) {
+            if (calls[i] != 1)
+                BOOST_ERROR("quote #" << i << " bumped " << calls[i] << " times");
+        }
+
+        // errors in the callback are propagated
+        BOOST_CHECK_THROW(copies.calculate([](Size, Real, Real) {
+                              QL_FAIL("callback failure");
+                          }),
+                          Error);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testParallelShift) {
+
+    BOOST_TEST_MESSAGE(
+        "Testing parallel shift of bucketed sensitivity engine...");
+
+    OptionPortfolio portfolio;
+    std::vector<Real> baseValues = portfolio.quoteValues();
+    // only the rates are shifted together
+    std::vector<Handle<SimpleQuote> > rates = {portfolio.quotes[1],
+                                               portfolio.quotes[2]};
+    Real shift = 1.0e-4;
+
+    for (SensitivityAnalysis type : {Centered, OneSide}) {
+        BucketSensitivityEngine engine(rates, portfolio.instruments,
+                                       portfolio.quantities, shift, type);
+        std::pair<Real, Real> expected =
+            parallelAnalysis(rates, portfolio.instruments,
+                             portfolio.quantities, shift, type);
+
+        std::pair<Real, Real> calculated = engine.parallelShift();
+        checkClose(calculated.first, expected.first, 1.0e-10, "parallel delta", 0);
+        checkClose(calculated.second, expected.second, 1.0e-10, "parallel gamma", 0);
+
+        // passing the reference NPV gives the same results
+        calculated = engine.parallelShift(engine.referenceNPV());
+        checkClose(calculated.first, expected.first, 1.0e-10, "parallel delta", 0);
+        checkClose(calculated.second, expected.second, 1.0e-10, "parallel gamma", 0);
+
+        if (portfolio.quoteValues() != baseValues)
+            BOOST_FAIL("quotes not restored after parallel analysis");
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -27,6 +27,7 @@
 #include <ql/math/statistics/gaussianstatistics.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/statistics/convergencestatistics.hpp>
+#include <ql/math/statistics/tdigeststatistics.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/randomnumbers/inversecumulativerng.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
@@ -294,6 +295,7 @@ BOOST_AUTO_TEST_CASE(testStatistics) {
     check<IncrementalStatistics>(
         std::string("IncrementalStatistics"));
     check<Statistics>(std::string("Statistics"));
+    check<TDigestStatistics>(std::string("TDigestStatistics"));
 }
 
 BOOST_AUTO_TEST_CASE(testSequenceStatistics) {
@@ -377,6 +379,184 @@ BOOST_AUTO_TEST_CASE(testIncrementalStatistics) {
                                  << tol);
 }
 
+BOOST_AUTO_TEST_CASE(testTDigestStatistics) {
+
+    BOOST_TEST_MESSAGE("Testing t-digest statistics against general statistics...");
+
+    MersenneTwisterUniformRng mt(42);
+    InverseCumulativeRng<MersenneTwisterUniformRng,InverseCumulativeNormal> gen(mt);
+
+    const Size samples = 200000;
+    const Real compression = 200.0;
+
+    // samples are collected by four accumulators and then merged
+    RiskStatistics reference;
+    std::vector<GenericRiskStatistics<TDigestStatistics> > parts(4);
+    for (Size i=0; i<samples; ++i) {
+        Real x = gen.next().value;
+        if (i % 3 == 0)
+            x = std::exp(x);
+        reference.add(x);
+        parts[i % parts.size()].add(x);
+    }
+    GenericRiskStatistics<TDigestStatistics> digest = parts[0];
+    for (Size i=1; i<parts.size(); ++i)
+        digest.merge(parts[i]);
+
+    if (digest.samples() != samples)
+        BOOST_FAIL("wrong number of samples after merging"
+                   << "\n    calculated: " << digest.samples()
+                   << "\n    expected:   " << samples);
+
+    if (digest.centroids().size() > compression)
+        BOOST_FAIL("too many centroids: " << digest.centroids().size());
+
+    const Real momentTolerance = 1.0e-10;
+    const std::pair<std::string, std::pair<Real,Real> > moments[] = {
+        {"mean", {digest.mean(), reference.mean()}},
+        {"variance", {digest.variance(), reference.variance()}},
+        {"skewness", {digest.skewness(), reference.skewness()}},
+        {"kurtosis", {digest.kurtosis(), reference.kurtosis()}},
+        {"minimum", {digest.min(), reference.min()}},
+        {"maximum", {digest.max(), reference.max()}}
+    };
+    for (const auto& m : moments) {
+        if (std::fabs(m.second.first - m.second.second)
+            > momentTolerance*std::fabs(m.second.second))
+            BOOST_ERROR("wrong " << m.first
+                        << std::setprecision(12)
+                        << "\n    calculated: " << m.second.first
+                        << "\n    expected:   " << m.second.second);
+    }
+
+    // percentiles are checked in probability terms against the
+    // empirical distribution of the stored samples
+    reference.sort();
+    std::vector<Real> sorted;
+    sorted.reserve(samples);
+    for (const auto& d : reference.data())
+        sorted.push_back(d.first);
+
+    const Real probabilityTolerance = 1.0e-3;
+    for (Real p : {0.001, 0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99, 0.999}) {
+        Real x = digest.percentile(p);
+        Real empirical =
+            Real(std::lower_bound(sorted.begin(), sorted.end(), x) - sorted.begin())
+            / samples;
+        if (std::fabs(empirical - p) > probabilityTolerance)
+            BOOST_ERROR("wrong percentile at " << p
+                        << "\n    calculated: " << x
+                        << "\n    expected:   " << reference.percentile(p)
+                        << "\n    empirical probability: " << empirical);
+    }
+
+    const Real riskTolerance = 1.0e-2;
+    const std::pair<std::string, std::pair<Real,Real> > measures[] = {
+        {"value-at-risk", {digest.valueAtRisk(0.99), reference.valueAtRisk(0.99)}},
+        {"expected shortfall",
+         {digest.expectedShortfall(0.99), reference.expectedShortfall(0.99)}},
+        {"top percentile", {digest.topPercentile(0.01), reference.topPercentile(0.01)}},
+        {"semi-deviation", {digest.semiDeviation(), reference.semiDeviation()}},
+        {"shortfall", {digest.shortfall(0.0), reference.shortfall(0.0)}},
+        {"average shortfall",
+         {digest.averageShortfall(0.0), reference.averageShortfall(0.0)}}
+    };
+    for (const auto& m : measures) {
+        if (std::fabs(m.second.first - m.second.second)
+            > riskTolerance*std::fabs(m.second.second))
+            BOOST_ERROR("wrong " << m.first
+                        << "\n    calculated: " << m.second.first
+                        << "\n    expected:   " << m.second.second);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testSequenceStatisticsBatchesAndMerge) {
+
+    BOOST_TEST_MESSAGE("Testing batched and merged sequence statistics...");
+
+    MersenneTwisterUniformRng rng(42);
+
+    const Size dimension = 7, samples = 1000;
+    Matrix x(samples, dimension);
+    Array w(samples);
+    for (Size i=0; i<samples; ++i) {
+        Real common = rng.nextReal();
+        for (Size j=0; j<dimension; ++j)
+            x[i][j] = common*j + rng.nextReal();
+        w[i] = 0.5 + rng.nextReal();
+    }
+
+    SequenceStatistics reference(dimension);
+    for (Size i=0; i<samples; ++i)
+        reference.add(x.row_begin(i), x.row_end(i), w[i]);
+
+    // batches of irregular size, collected in two instances
+    SequenceStatistics batched, other;
+    SequenceStatisticsInc incremental;
+    Size begin = 0, batchSize = 1;
+    while (begin < samples) {
+        Size n = std::min(batchSize, samples-begin);
+        Matrix batch(n, dimension);
+        Array weights(n);
+        for (Size k=0; k<n; ++k) {
+            std::copy(x.row_begin(begin+k), x.row_end(begin+k), batch.row_begin(k));
+            weights[k] = w[begin+k];
+        }
+        if (begin < samples/3)
+            batched.add(batch, weights);
+        else
+            other.add(batch, weights);
+        incremental.add(batch, weights);
+        begin += n;
+        batchSize = 2*batchSize + 1;
+    }
+    batched.merge(other);
+
+    if (batched.samples() != samples)
+        BOOST_FAIL("wrong number of samples after merging"
+                   << "\n    calculated: " << batched.samples()
+                   << "\n    expected:   " << samples);
+
+    const Real tolerance = 1.0e-12;
+    auto checkVector = [&](const std::string& what,
+                           const std::vector<Real>& calculated,
+                           const std::vector<Real>& expected) {
+        for (Size j=0; j<dimension; ++j) {
+            if (std::fabs(calculated[j]-expected[j]) > tolerance*std::fabs(expected[j]))
+                BOOST_ERROR("wrong " << what << " for dimension " << j
+                            << std::setprecision(16)
+                            << "\n    calculated: " << calculated[j]
+                            << "\n    expected:   " << expected[j]);
+        }
+    };
+    checkVector("merged mean", batched.mean(), reference.mean());
+    checkVector("merged variance", batched.variance(), reference.variance());
+    checkVector("merged percentile", batched.percentile(0.9), reference.percentile(0.9));
+    checkVector("incremental mean", incremental.mean(), reference.mean());
+    checkVector("incremental error", incremental.errorEstimate(), reference.errorEstimate());
+
+    Matrix expected = reference.covariance();
+    Matrix calculated[] = { batched.covariance(), incremental.covariance() };
+    for (const auto& c : calculated) {
+        for (Size i=0; i<dimension; ++i) {
+            for (Size j=0; j<dimension; ++j) {
+                Real scale = std::sqrt(expected[i][i]*expected[j][j]);
+                if (std::fabs(c[i][j]-expected[i][j]) > tolerance*scale)
+                    BOOST_ERROR("wrong covariance at (" << i << "," << j << ")"
+                                << std::setprecision(16)
+                                << "\n    calculated: " << c[i][j]
+                                << "\n    expected:   " << expected[i][j]);
+            }
+        }
+    }
+
+    SequenceStatisticsInc noCovariance(dimension, false);
+    noCovariance.add(x, w);
+    checkVector("mean without covariance", noCovariance.mean(), reference.mean());
+    BOOST_CHECK_THROW(noCovariance.covariance(), Error);
+    BOOST_CHECK_THROW(batched.merge(SequenceStatistics(dimension, false)), Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -24,11 +24,14 @@
 #include "utilities.hpp"
 #include <ql/indexes/swap/euriborswap.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <ql/termstructures/snapshot.hpp>
 #include <ql/termstructures/volatility/swaption/interpolatedswaptionvolatilitycube.hpp>
 #include <ql/termstructures/volatility/swaption/sabrswaptionvolatilitycube.hpp>
 #include <ql/termstructures/volatility/swaption/spreadedswaptionvol.hpp>
 #include <ql/termstructures/volatility/sabrsmilesection.hpp>
+#include <ql/time/daycounters/actual360.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <sstream>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -572,6 +575,163 @@ BOOST_AUTO_TEST_CASE(testSabrParameters) {
 
 }
 
+BOOST_AUTO_TEST_CASE(testSnapshot) {
+
+    BOOST_TEST_MESSAGE("Testing binary snapshots of swaption volatility cubes...");
+
+    CommonVars vars;
+
+    InterpolatedSwaptionVolatilityCube volCube(vars.atmVolMatrix,
+                             vars.cube.tenors.options,
+                             vars.cube.tenors.swaps,
+                             vars.cube.strikeSpreads,
+                             vars.cube.volSpreadsHandle,
+                             vars.swapIndexBase,
+                             vars.shortSwapIndexBase,
+                             vars.vegaWeighedSmileFit);
+
+    std::stringstream buffer;
+    saveSnapshot(buffer, volCube);
+    const std::string saved = buffer.str();
+
+    auto loaded = loadSwaptionVolatilityCubeSnapshot(
+        buffer, vars.atmVolMatrix, vars.swapIndexBase, vars.shortSwapIndexBase);
+    vars.makeVolSpreadsTest(*loaded, 1.0e-16);
+
+    // the swap indexes must match the saved ones
+    std::stringstream swapped(saved);
+    BOOST_CHECK_THROW(loadSwaptionVolatilityCubeSnapshot(swapped, vars.atmVolMatrix,
+                                                         vars.shortSwapIndexBase,
+                                                         vars.swapIndexBase),
+                      Error);
+    std::stringstream other(saved);
+    auto otherIndex = ext::make_shared<EuriborSwapIsdaFixB>(2*Years, vars.termStructure);
+    BOOST_CHECK_THROW(loadSwaptionVolatilityCubeSnapshot(other, vars.atmVolMatrix,
+                                                         otherIndex,
+                                                         vars.shortSwapIndexBase),
+                      Error);
+
+    // as well as the conventions of the ATM structure
+    Handle<SwaptionVolatilityStructure> atmVolMatrix(ext::make_shared<SwaptionVolatilityMatrix>(
+        vars.conventions.calendar, vars.conventions.optionBdc, vars.atm.tenors.options,
+        vars.atm.tenors.swaps, vars.atm.volsHandle, Actual360()));
+    std::stringstream conventions(saved);
+    BOOST_CHECK_THROW(loadSwaptionVolatilityCubeSnapshot(conventions, atmVolMatrix,
+                                                         vars.swapIndexBase,
+                                                         vars.shortSwapIndexBase),
+                      Error);
+
+    // truncated data are detected before allocating the arrays
+    std::stringstream truncated(saved.substr(0, saved.size() / 2));
+    BOOST_CHECK_THROW(loadSwaptionVolatilityCubeSnapshot(truncated, vars.atmVolMatrix,
+                                                         vars.swapIndexBase,
+                                                         vars.shortSwapIndexBase),
+                      Error);
+}
+
+BOOST_AUTO_TEST_CASE(testSabrWarmStartCalibration) {
+    BOOST_TEST_MESSAGE("Testing warm-started recalibration of SABR cube...");
+
+    CommonVars vars;
+
+    std::vector<std::vector<Handle<Quote> > >
+        parametersGuess(vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size());
+    for (Size i=0; i<vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size(); i++) {
+        parametersGuess[i] = std::vector<Handle<Quote> >(4);
+        parametersGuess[i][0] =
+            Handle<Quote>(ext::shared_ptr<Quote>(new SimpleQuote(0.2)));
+        parametersGuess[i][1] =
+            Handle<Quote>(ext::shared_ptr<Quote>(new SimpleQuote(0.5)));
+        parametersGuess[i][2] =
+            Handle<Quote>(ext::shared_ptr<Quote>(new SimpleQuote(0.4)));
+        parametersGuess[i][3] =
+            Handle<Quote>(ext::shared_ptr<Quote>(new SimpleQuote(0.0)));
+    }
+    std::vector<bool> isParameterFixed(4, false);
+
+    SabrSwaptionVolatilityCube volCube(vars.atmVolMatrix,
+                             vars.cube.tenors.options,
+                             vars.cube.tenors.swaps,
+                             vars.cube.strikeSpreads,
+                             vars.cube.volSpreadsHandle,
+                             vars.swapIndexBase,
+                             vars.shortSwapIndexBase,
+                             vars.vegaWeighedSmileFit,
+                             parametersGuess,
+                             isParameterFixed,
+                             true,
+                             ext::shared_ptr<EndCriteria>(),
+                             Null<Real>(),
+                             ext::shared_ptr<OptimizationMethod>(),
+                             Null<Real>(),
+                             false,
+                             50,
+                             false,
+                             0.0001,
+                             true);
+
+    // unchanged inputs must give back exactly the same parameters
+    // without fitting any node again
+    Matrix parameters = volCube.sparseSabrParameters();
+    Size fullCalibration = volCube.smileFits();
+    Size sparseNodes = parameters.rows();
+    if (fullCalibration < sparseNodes)
+        BOOST_FAIL("too few smile fits in first calibration: "
+                   << fullCalibration << " for " << sparseNodes
+                   << " sparse nodes");
+    volCube.update();
+    Matrix recalculated = volCube.sparseSabrParameters();
+    if (volCube.smileFits() != fullCalibration)
+        BOOST_ERROR("nodes fitted again without market moves: "
+                    << volCube.smileFits() - fullCalibration);
+    for (Size i=0; i<parameters.rows(); ++i) {
+        for (Size j=2; j<parameters.columns(); ++j) {
+            if (parameters[i][j] != recalculated[i][j])
+                BOOST_ERROR("\nparameters changed without market moves:"
+                            "\nrow = " << i << ", column = " << j <<
+                            "\nbefore = " << parameters[i][j] <<
+                            "\nafter  = " << recalculated[i][j]);
+        }
+    }
+
+    // a move in a single smile only causes the affected nodes to be
+    // fitted again, starting from their previous solution
+    auto spread = ext::dynamic_pointer_cast<SimpleQuote>(
+        vars.cube.volSpreadsHandle[4][0].currentLink());
+    BOOST_REQUIRE(spread);
+    spread->setValue(spread->value() + 0.0010);
+    Size before = volCube.smileFits();
+    recalculated = volCube.sparseSabrParameters();
+    Size refitted = volCube.smileFits() - before;
+    if (refitted == 0 || refitted >= fullCalibration)
+        BOOST_ERROR("unexpected number of nodes fitted again after a move "
+                    "in a single smile: " << refitted << " out of "
+                    << fullCalibration);
+    for (Size i=0; i<parameters.rows(); ++i) {
+        bool changed = false;
+        for (Size j=2; j<parameters.columns(); ++j)
+            changed = changed || parameters[i][j] != recalculated[i][j];
+        if (changed != (i == 4))
+            BOOST_ERROR("\nsparse node " << i << (changed ? " " : " not ")
+                        << "fitted again after a move in node 4");
+    }
+    spread->setValue(spread->value() - 0.0010);
+
+    // after a move in the forwards all nodes are fitted again, and the
+    // warm-started fit must still reproduce the market within the
+    // usual tolerance
+    vars.termStructure.linkTo(flatRate(0.051, Actual365Fixed()));
+    before = volCube.smileFits();
+
+    vars.makeAtmVolTest(volCube, 3.0e-4);
+    vars.makeVolSpreadsTest(volCube, 12.0e-4);
+
+    if (volCube.smileFits() - before != fullCalibration)
+        BOOST_ERROR("unexpected number of nodes fitted again after a move "
+                    "in the forwards: " << volCube.smileFits() - before
+                    << " instead of " << fullCalibration);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -26,6 +26,12 @@
 #include <ql/termstructures/yield/impliedtermstructure.hpp>
 #include <ql/termstructures/yield/forwardspreadedtermstructure.hpp>
 #include <ql/termstructures/yield/zerospreadedtermstructure.hpp>
+#include <ql/termstructures/yield/zerocurve.hpp>
+#include <ql/termstructures/yield/forwardcurve.hpp>
+#include <ql/termstructures/credit/interpolatedhazardratecurve.hpp>
+#include <ql/termstructures/volatility/equityfx/blackvariancesurface.hpp>
+#include <ql/termstructures/snapshot.hpp>
+#include <ql/math/interpolations/backwardflatinterpolation.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
 #include <ql/time/daycounters/actual360.hpp>
@@ -34,6 +40,7 @@
 #include <ql/indexes/iborindex.hpp>
 #include <ql/currency.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <sstream>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -415,6 +422,134 @@ BOOST_AUTO_TEST_CASE(testNullTimeToReference) {
                     << "    expected:   " << expected);
 }
 
+BOOST_AUTO_TEST_CASE(testBatchDiscounts) {
+    BOOST_TEST_MESSAGE("Testing batched discount factors against single queries...");
+
+    CommonVars vars;
+
+    Date today = Settings::instance().evaluationDate();
+    std::vector<Date> dates = { today, today + 1*Years, today + 5*Years,
+                                today + 10*Years, today + 30*Years };
+    std::vector<Rate> rates = { 0.02, 0.025, 0.03, 0.035, 0.04 };
+    std::vector<DiscountFactor> dfs(dates.size());
+    for (Size i=0; i<dates.size(); ++i)
+        dfs[i] = std::exp(-rates[i] * Actual360().yearFraction(today, dates[i]));
+
+    Handle<YieldTermStructure> piecewise(vars.termStructure);
+    Handle<Quote> spread(ext::make_shared<SimpleQuote>(0.001));
+
+    std::vector<std::pair<std::string, ext::shared_ptr<YieldTermStructure> > > curves = {
+        { "piecewise", vars.termStructure },
+        { "discount", ext::make_shared<DiscountCurve>(dates, dfs, Actual360()) },
+        { "zero", ext::make_shared<ZeroCurve>(dates, rates, Actual360()) },
+        { "forward", ext::make_shared<ForwardCurve>(dates, rates, Actual360()) },
+        { "flat", ext::make_shared<FlatForward>(today, 0.03, Actual360()) },
+        { "zero-spreaded", ext::make_shared<ZeroSpreadedTermStructure>(
+                               piecewise, spread, Compounded, Semiannual) }
+    };
+
+    for (const auto& curve : curves) {
+        Time tMax = curve.second->maxTime();
+        if (tMax > 100.0)
+            tMax = 30.0;
+        // includes null times and extrapolation past the last node
+        std::vector<Time> times = { 0.0 };
+        for (Size i=0; i<=100; ++i)
+            times.push_back(std::max(curve.second->timeFromReference(today), 0.0)
+                            + i * 1.2 * tMax / 100);
+
+        std::vector<DiscountFactor> calculated(times.size());
+        curve.second->discounts(times.data(), calculated.data(), times.size(), true);
+
+        for (Size i=0; i<times.size(); ++i) {
+            DiscountFactor expected = curve.second->discount(times[i], true);
+            if (std::fabs(calculated[i] - expected) > 1.0e-15) {
+                BOOST_ERROR("batched discount factor differs from single query"
+                            << " for " << curve.first << " curve:\n"
+                            << std::setprecision(15)
+                            << "    time:       " << times[i] << "\n"
+                            << "    calculated: " << calculated[i] << "\n"
+                            << "    expected:   " << expected);
+            }
+        }
+    }
+
+    std::vector<Time> unsorted = { 1.0, 0.5 };
+    std::vector<DiscountFactor> out(unsorted.size());
+    BOOST_CHECK_THROW(vars.termStructure->discounts(unsorted.data(), out.data(), 2),
+                      Error);
+}
+
+BOOST_AUTO_TEST_CASE(testSnapshots) {
+    BOOST_TEST_MESSAGE("Testing binary snapshots of term structures...");
+
+    CommonVars vars;
+
+    auto curve = ext::dynamic_pointer_cast<PiecewiseYieldCurve<Discount, LogLinear> >(
+        vars.termStructure);
+
+    std::stringstream buffer;
+    saveSnapshot(buffer, *curve);
+    auto frozen = loadCurveSnapshot<InterpolatedDiscountCurve<LogLinear> >(buffer, Actual360());
+
+    BOOST_CHECK(frozen->referenceDate() == curve->referenceDate());
+    BOOST_CHECK(frozen->maxDate() == curve->maxDate());
+    for (Date d = curve->referenceDate(); d <= curve->maxDate(); d += 30) {
+        if (frozen->discount(d) != curve->discount(d))
+            BOOST_ERROR("discount mismatch on " << d << ":"
+                        << "\n    bootstrapped curve: " << curve->discount(d)
+                        << "\n    loaded snapshot:    " << frozen->discount(d));
+    }
+
+    buffer.str("");
+    saveSnapshot(buffer, *curve);
+    BOOST_CHECK_THROW(
+        loadCurveSnapshot<InterpolatedDiscountCurve<LogLinear> >(buffer, Thirty360(Thirty360::BondBasis)),
+        Error);
+
+    Date today = Settings::instance().evaluationDate();
+    std::vector<Date> dates = {today + 1*Years, today + 2*Years, today + 5*Years};
+    std::vector<Real> strikes = {90.0, 100.0, 110.0};
+    Matrix vols(3, 3);
+    for (Size i=0; i<3; ++i)
+        for (Size j=0; j<3; ++j)
+            vols[i][j] = 0.2 + 0.01*i - 0.005*j;
+    BlackVarianceSurface surface(today, TARGET(), dates, strikes, vols, Actual365Fixed(),
+                                 BlackVarianceSurface::ConstantExtrapolation,
+                                 BlackVarianceSurface::ConstantExtrapolation);
+
+    buffer.str("");
+    saveSnapshot(buffer, surface);
+    auto loadedSurface = loadBlackVarianceSurfaceSnapshot(buffer, TARGET(), Actual365Fixed());
+    // the extrapolation types are saved; test them outside the strike range
+    surface.enableExtrapolation();
+    loadedSurface->enableExtrapolation();
+    for (Real t = 0.25; t < 5.0; t += 0.5) {
+        for (Real k = 80.0; k <= 120.0; k += 5.0) {
+            if (loadedSurface->blackVol(t, k) != surface.blackVol(t, k))
+                BOOST_ERROR("volatility mismatch at t = " << t << ", strike = " << k);
+        }
+    }
+
+    std::vector<Date> hazardDates = {today, today + 1*Years, today + 3*Years, today + 10*Years};
+    std::vector<Rate> hazardRates = {0.01, 0.01, 0.015, 0.02};
+    InterpolatedHazardRateCurve<BackwardFlat> hazardCurve(hazardDates, hazardRates,
+                                                          Actual365Fixed());
+
+    buffer.str("");
+    saveSnapshot(buffer, hazardCurve);
+    BOOST_CHECK_THROW(loadBlackVarianceSurfaceSnapshot(buffer, TARGET(), Actual365Fixed()),
+                      Error);
+    buffer.clear();
+    buffer.seekg(0);
+    auto loadedHazard =
+        loadCurveSnapshot<InterpolatedHazardRateCurve<BackwardFlat> >(buffer, Actual365Fixed());
+    for (Date d = today; d <= today + 10*Years; d += 90) {
+        if (loadedHazard->survivalProbability(d) != hazardCurve.survivalProbability(d))
+            BOOST_ERROR("survival probability mismatch on " << d);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -23,6 +23,7 @@
 #include <ql/timeseries.hpp>
 #include <ql/prices.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
+#include <ql/utilities/densedatemap.hpp>
 #include <boost/unordered_map.hpp>
 
 using namespace QuantLib;
@@ -189,6 +190,56 @@ BOOST_AUTO_TEST_CASE(testUtilities) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testDenseContainer) {
+    BOOST_TEST_MESSAGE("Testing time series with a dense date-indexed container...");
+
+    typedef TimeSeries<Real, DenseDateMap<Real> > DenseTimeSeries;
+
+    const std::vector<Date> dates = {Date(25, March, 2005),
+                                     Date(29, March, 2005),
+                                     Date(15, March, 2005)};
+
+    const std::vector<Real> prices = {25, 23, 20};
+
+    DenseTimeSeries dense(dates.begin(), dates.end(), prices.begin());
+    const TimeSeries<Real> sparse(dates.begin(), dates.end(), prices.begin());
+
+    BOOST_TEST(dense.size() == sparse.size());
+    BOOST_TEST(dense.firstDate() == sparse.firstDate());
+    BOOST_TEST(dense.lastDate() == sparse.lastDate());
+    BOOST_TEST(dense.dates() == sparse.dates());
+    BOOST_TEST(dense.values() == sparse.values());
+
+    const DenseTimeSeries& constDense = dense;
+    BOOST_TEST(constDense[Date(25, March, 2005)] == 25.0);
+    BOOST_TEST(constDense[Date(26, March, 2005)] == Null<Real>());
+    BOOST_TEST(constDense[Date(1, January, 2005)] == Null<Real>());
+    BOOST_TEST(constDense[Date(1, January, 2006)] == Null<Real>());
+    BOOST_TEST(dense.size() == 3);
+
+    std::vector<Date> reversed;
+    for (auto i = dense.rbegin(); i != dense.rend(); ++i)
+        reversed.push_back(i->first);
+    const std::vector<Date> expected{dates[1], dates[0], dates[2]};
+    BOOST_TEST(reversed == expected);
+
+    // insertion before the stored range and explicit null entries
+    dense[Date(1, March, 2005)] = 19.0;
+    BOOST_TEST(dense.firstDate() == Date(1, March, 2005));
+    BOOST_TEST(dense.find(Date(2, March, 2005))->second == Null<Real>());
+    BOOST_TEST(dense.size() == 5);
+    BOOST_TEST(dense.values()[2] == 20.0);
+
+    // bulk construction from a flat array with gaps
+    std::vector<Real> flat = {Null<Real>(), 1.0, Null<Real>(), 2.0, 3.0, Null<Real>()};
+    DenseDateMap<Real> bulk(Date(1, March, 2005), flat);
+    BOOST_TEST(bulk.size() == 3);
+    BOOST_TEST(bulk.firstDate() == Date(2, March, 2005));
+    BOOST_TEST(bulk.data().size() == 4);
+    BOOST_TEST(bulk.value(Date(4, March, 2005)) == 2.0);
+    BOOST_TEST(bulk.value(Date(3, March, 2005)) == Null<Real>());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -227,6 +227,43 @@ BOOST_AUTO_TEST_CASE(testAgainstReferenceImplementationInC) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testJumpsAgainstReferenceImplementationInC) {
+    BOOST_TEST_MESSAGE(
+        "Testing Xoshiro256StarStarUniformRng jumps against reference implementation in C...");
+
+    static const auto s0 = 18274946675476036270ULL;
+    static const auto s1 = 6043068446171522962ULL;
+    static const auto s2 = 96311065249897859ULL;
+    static const auto s3 = 16504445955133574805ULL;
+
+    s[0] = s0;
+    s[1] = s1;
+    s[2] = s2;
+    s[3] = s3;
+
+    auto rng = Xoshiro256StarStarUniformRng(s0, s1, s2, s3);
+    for (auto j = 0; j < 4; j++) {
+        if (j < 2) {
+            jump();
+            rng.jump();
+        } else {
+            long_jump();
+            rng.longJump();
+        }
+        for (auto i = 0; i < 100; i++) {
+            auto nextRefImpl = next();
+            auto nextFromRng = rng.nextInt64();
+            if (nextRefImpl != nextFromRng) {
+                BOOST_FAIL("Test failed at index "
+                           << i << " after " << (j < 2 ? j + 1 : j - 1)
+                           << (j < 2 ? " jump(s)" : " long jump(s)")
+                           << " (expected from reference implementation: " << nextRefImpl
+                           << "ULL, from Xoshiro256StarStarUniformRng: " << nextFromRng << "ULL)");
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testAbsenceOfInteractionBetweenInstances) {
     BOOST_TEST_MESSAGE(
         "Testing Xoshiro256StarStarUniformRng for absence of interaction between instances...");
@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+
+"""
+Compares two result files written by quantlib-benchmark-suite --json=<file>.
+
+    compare_benchmarks.py baseline.json contender.json [--threshold=0.05]
+
+For each benchmark found in both files, the median times per call are
+compared.  A benchmark is reported as a regression (improvement) when
+the contender is slower (faster) than the baseline by more than the
+threshold and the difference is larger than the noise measured in the
+two runs, i.e., when the ranges [min, max] of the timed repetitions
+don't overlap.  Benchmarks run with different sizes are not compared,
+and changes in the checksums are reported since they signal a change in
+the results.
+
+The script exits with status 1 if any regression is found, so that it
+can be used to check builds automatically.
+"""
+
+import argparse
+import json
+import math
+import sys
+
+
+def load(filename):
+    with open(filename) as f:
+        data = json.load(f)
+    return data.get("context", {}), {b["name"]: b for b in data["benchmarks"]}
+
+
+def format_time(seconds):
+    for unit, factor in (("s", 1.0), ("ms", 1.0e3), ("us", 1.0e6)):
+        if seconds * factor >= 1.0:
+            return "%.2f %s" % (seconds * factor, unit)
+    return "%.2f ns" % (seconds * 1.0e9)
+
+
+def same_checksum(a, b):
+    return math.isclose(a, b, rel_tol=1.0e-10, abs_tol=1.0e-12)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare two runs of quantlib-benchmark-suite."
+    )
+    parser.add_argument("baseline", help="JSON results of the reference build")
+    parser.add_argument("contender", help="JSON results of the build to check")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.05,
+        help="relative change of the median below which differences are ignored",
+    )
+    args = parser.parse_args()
+
+    baseContext, baseline = load(args.baseline)
+    newContext, contender = load(args.contender)
+
+    for key in ("quantlib_version", "compiler", "build_type"):
+        if baseContext.get(key) != newContext.get(key):
+            print(
+                "warning: different %s (%s vs %s)"
+                % (key, baseContext.get(key), newContext.get(key))
+            )
+
+    regressions = 0
+    print(
+        "%-48s %12s %12s %9s  %s"
+        % ("benchmark", "baseline", "contender", "change", "")
+    )
+    for name in sorted(set(baseline) | set(contender)):
+        if name not in contender:
+            print("%-48s %12s" % (name, "removed"))
+            continue
+        if name not in baseline:
+            print("%-48s %12s" % (name, "added"))
+            continue
+        old, new = baseline[name], contender[name]
+        if old["size"] != new["size"]:
+            print(
+                "%-48s different sizes (%d vs %d), not compared"
+                % (name, old["size"], new["size"])
+            )
+            continue
+
+        change = new["median"] / old["median"] - 1.0
+        overlap = min(new["times"]) <= max(old["times"]) and min(
+            old["times"]
+        ) <= max(new["times"])
+        status = ""
+        if abs(change) > args.threshold and not overlap:
+            if change > 0.0:
+                status = "REGRESSION"
+                regressions += 1
+            else:
+                status = "improvement"
+        if not same_checksum(old["checksum"], new["checksum"]):
+            status += (" " if status else "") + "checksum changed"
+        print(
+            "%-48s %12s %12s %+8.1f%%  %s"
+            % (
+                name,
+                format_time(old["median"]),
+                format_time(new["median"]),
+                100.0 * change,
+                status,
+            )
+        )
+
+    if regressions:
+        print("\n%d regression(s) found" % regressions)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())